@@ -48,6 +48,35 @@ struct AttackValidator
 	}
 };
 
+#pragma endregion
+#pragma region Board snapshot
+
+/** Optional extension of BoardData, for board views that keep the player's squares in a contiguous buffer.
+ *  Algorithms can scan the buffer directly instead of calling charAt for every square.
+ */
+class BoardSnapshot
+{
+public:
+	virtual ~BoardSnapshot() = default;
+
+	/** Returns the player's squares (same values charAt returns), rows()*cols()*depth() chars long.
+	 *  Square (row, col, depth) - in the range [1, BOARD_SIZE] - is at snapshotIndex(...).
+	 */
+	virtual const char* squares() const = 0;
+};
+
+/** Returns the snapshot of the board view, or NULL if the view doesn't provide one */
+inline const BoardSnapshot* boardSnapshotOf(const BoardData& board)
+{
+	return dynamic_cast<const BoardSnapshot*>(&board);
+}
+
+/** Index of square c (in the range [1, BOARD_SIZE]) within the snapshot of the board view */
+inline int snapshotIndex(const BoardData& board, const Coordinate& c)
+{
+	return ((c.depth - 1) * board.rows() + (c.row - 1)) * board.cols() + (c.col - 1);
+}
+
 #pragma endregion
 #pragma region Coordinate extensions
 
@@ -6,6 +6,8 @@
 #include "Logger.h"
 
 using std::function;
+using std::lock_guard;
+using std::unique_lock;
 
 namespace battleship
 {
@@ -13,7 +15,7 @@ namespace battleship
 	{
 		Logger::getInstance().log(Severity::DEBUG_LEVEL, "AlgoLoader Fetching list of available DLLs..");
 
-		_availableGameAlgos = IOUtil::listFilesInPath(path, "dll");
+		_availableGameAlgos = IOUtil::listFilesInPath(path, DLL_EXTENSION);
 
 		// Scan for dlls in the path
 		for (auto& nextDllFilename : _availableGameAlgos)
@@ -34,7 +36,7 @@ namespace battleship
 		}
 	}
 
-	void AlgoLoader::loadAlgorithm(const string& algoName)
+	bool AlgoLoader::loadAlgorithm(const string& algoName)
 	{
 		string algoFullpath = _algosPath + "\\" + algoName;
 
@@ -44,7 +46,7 @@ namespace battleship
 		if (!hDll)
 		{
 			Logger::getInstance().log(Severity::WARNING_LEVEL, "Cannot load dll: " + algoFullpath);
-			return;
+			return false;
 		}
 
 		// Get function pointer
@@ -54,19 +56,68 @@ namespace battleship
 		{
 			Logger::getInstance().log(Severity::WARNING_LEVEL, "Cannot load dll: " + algoFullpath);
 			FreeLibrary(hDll); // Make sure to release loaded library, as AlgoLoader doesn't manage it yet
-			return;
+			return false;
 		}
 
+		// Extended interface is optional
+		GetAlgorithmExFuncType getAlgorithmExFunc = loadExtendedAlgorithmFunc(hDll, algoName);
+
 		// Keep algorithm in list of loaded algos
 		string algoFormattedName = algoName;
 		stripNameSuffix(algoFormattedName);
-		_loadedGameAlgos.emplace_back(algoFormattedName, hDll, getAlgorithmFunc); // Build algoDescriptor
-		_loadedGameAlgoNames.push_back(algoFormattedName);
+		uint64_t fingerprint = binaryFingerprint(algoFullpath);
+		{
+			lock_guard<mutex> lock(_loadedAlgosLock);
+
+			// Instances are requested by name, so another algorithm by that name would never play
+			if (findAlgorithm(algoFormattedName) != nullptr)
+			{
+				Logger::getInstance().log(Severity::WARNING_LEVEL,
+										  "Cannot load dll: " + algoFullpath + ", algorithm " + algoFormattedName +
+										  " is already loaded");
+				FreeLibrary(hDll);
+				return false;
+			}
+
+			_loadedGameAlgos.emplace_back(algoFormattedName, hDll, getAlgorithmFunc, fingerprint,
+										  getAlgorithmExFunc); // Build algoDescriptor
+			_loadedGameAlgoNames.push_back(algoFormattedName);
+		}
 
 		Logger::getInstance().log(Severity::INFO_LEVEL, algoName + " loaded successfully");
+		return true;
 	}
 
-	AlgoLoader::AlgoLoader(const string& path): _algosPath(path)
+	const AlgoLoader::AlgoDescriptor* AlgoLoader::findAlgorithm(const string& algoName) const
+	{
+		auto it = std::find_if(_loadedGameAlgos.begin(), _loadedGameAlgos.end(),
+			[&algoName](AlgoDescriptor const& ad) { return ad.path == algoName; });
+
+		return (it != _loadedGameAlgos.end()) ? &(*it) : nullptr;
+	}
+
+	AlgoLoader::GetAlgorithmExFuncType AlgoLoader::loadExtendedAlgorithmFunc(HINSTANCE hDll, const string& algoName)
+	{
+		GetAlgorithmExFuncType getAlgorithmExFunc =
+			reinterpret_cast<GetAlgorithmExFuncType>(GetProcAddress(hDll, "GetAlgorithmEx"));
+		if (!getAlgorithmExFunc)
+			return nullptr; // Legacy algorithm
+
+		// Make sure the algorithm supports our version of the interface before relying on it
+		unique_ptr<IBattleshipGameAlgo> probe(getAlgorithmExFunc(ALGO_EX_VERSION));
+		if (nullptr == probe)
+		{
+			Logger::getInstance().log(Severity::INFO_LEVEL,
+									  algoName + " doesn't support extended interface version " +
+									  std::to_string(ALGO_EX_VERSION) + ", using the standard interface");
+			return nullptr;
+		}
+
+		Logger::getInstance().log(Severity::DEBUG_LEVEL, algoName + " supports the extended interface");
+		return getAlgorithmExFunc;
+	}
+
+	AlgoLoader::AlgoLoader(const string& path): _algosPath(path), _executableFingerprint(NO_FINGERPRINT)
 	{	
 		Logger::getInstance().log(Severity::INFO_LEVEL, "AlgoLoader started.. Loading from path: " + _algosPath);
 
@@ -81,8 +132,11 @@ namespace battleship
 		{
 			// Free HINSTANCE loaded, which resides in the 2nd cell of the algo tuple
 			auto descriptor = *(algIter);
-			Logger::getInstance().log(Severity::DEBUG_LEVEL, "Freeing algorithm: " + descriptor.path);
-			FreeLibrary(descriptor.dll);
+			if (descriptor.dll != NULL)
+			{
+				Logger::getInstance().log(Severity::DEBUG_LEVEL, "Freeing algorithm: " + descriptor.path);
+				FreeLibrary(descriptor.dll);
+			}
 		}
 	}
 
@@ -97,14 +151,116 @@ namespace battleship
 		return _loadedGameAlgoNames;
 	}
 
+	vector<string> AlgoLoader::loadNewAlgorithms(const vector<string>& dllNames)
+	{
+		vector<string> newAlgos;
+
+		for (const string& dllName : dllNames)
+		{
+			// Dlls that were found before were already loaded (or failed to load)
+			if (std::find(_availableGameAlgos.begin(), _availableGameAlgos.end(), dllName) != _availableGameAlgos.end())
+				continue;
+
+			Logger::getInstance().log(Severity::INFO_LEVEL, "New algorithm found: " + dllName);
+			_availableGameAlgos.push_back(dllName);
+
+			if (loadAlgorithm(dllName))
+			{
+				string algoName = dllName;
+				stripNameSuffix(algoName);
+				newAlgos.push_back(algoName);
+			}
+		}
+
+		return newAlgos;
+	}
+
+	bool AlgoLoader::registerStaticAlgorithm(const string& algoName, GetAlgorithmFuncType algoFunc)
+	{
+		lock_guard<mutex> lock(_loadedAlgosLock);
+
+		if ((algoFunc == nullptr) || (findAlgorithm(algoName) != nullptr))
+		{
+			Logger::getInstance().log(Severity::WARNING_LEVEL, "Cannot register algorithm: " + algoName);
+			return false;
+		}
+
+		// Compiled-in algorithms change only when the executable does. The executable holds all of them, so their
+		// name tells them apart.
+		if (_executableFingerprint == NO_FINGERPRINT)
+		{
+			char executable[MAX_PATH];
+			if (GetModuleFileNameA(NULL, executable, MAX_PATH) != 0)
+				_executableFingerprint = binaryFingerprint(executable);
+		}
+
+		uint64_t fingerprint = NO_FINGERPRINT;
+		if (_executableFingerprint != NO_FINGERPRINT)
+		{
+			fingerprint = IOUtil::contentHash(algoName.data(), algoName.size(), _executableFingerprint);
+			fingerprint = (fingerprint != NO_FINGERPRINT) ? fingerprint : (fingerprint + 1);
+		}
+
+		_loadedGameAlgos.emplace_back(algoName, static_cast<HINSTANCE>(NULL), algoFunc, fingerprint);
+		_loadedGameAlgoNames.push_back(algoName);
+
+		Logger::getInstance().log(Severity::INFO_LEVEL, algoName + " registered successfully");
+		return true;
+	}
+
+	AlgoLoader::GetAlgorithmFuncType AlgoLoader::staticAlgorithmFunc(const string& algoName) const
+	{
+		lock_guard<mutex> lock(_loadedAlgosLock);
+		const AlgoDescriptor* algoDescriptor = findAlgorithm(algoName);
+
+		if ((algoDescriptor == nullptr) || (algoDescriptor->dll != NULL))
+			return nullptr;
+
+		return algoDescriptor->algoFunc;
+	}
+
+	bool AlgoLoader::isExtendedAlgorithm(const string& algoName) const
+	{
+		lock_guard<mutex> lock(_loadedAlgosLock);
+		const AlgoDescriptor* algoDescriptor = findAlgorithm(algoName);
+
+		return (algoDescriptor != nullptr) && (algoDescriptor->algoExFunc != nullptr);
+	}
+
+	uint64_t AlgoLoader::fingerprint(const string& algoName) const
+	{
+		lock_guard<mutex> lock(_loadedAlgosLock);
+		const AlgoDescriptor* algoDescriptor = findAlgorithm(algoName);
+
+		if (algoDescriptor == nullptr)
+			return NO_FINGERPRINT;
+
+		return algoDescriptor->fingerprint;
+	}
+
+	uint64_t AlgoLoader::binaryFingerprint(const string& filename)
+	{
+		uint64_t hash;
+		if (!IOUtil::fileContentHash(filename, hash))
+		{
+			Logger::getInstance().log(Severity::WARNING_LEVEL, "Cannot read binary of algorithm: " + filename);
+			return NO_FINGERPRINT;
+		}
+
+		// NO_FINGERPRINT is reserved for unknown binaries
+		return (hash != NO_FINGERPRINT) ? hash : (hash + 1);
+	}
+
 	unique_ptr<IBattleshipGameAlgo> AlgoLoader::requestAlgo(const string& algoName) const
 	{
 		// Verify algo was already loaded before
-		auto it = std::find_if(_loadedGameAlgos.begin(), _loadedGameAlgos.end(),
-			[&algoName](AlgoDescriptor const& ad) { return ad.path == algoName; });
+		unique_lock<mutex> lock(_loadedAlgosLock);
+		const AlgoDescriptor* loadedDescriptor = findAlgorithm(algoName);
 
-		if (it == _loadedGameAlgos.end())
+		if (loadedDescriptor == nullptr)
 		{
+			lock.unlock();
+
 			// Not loaded before, meaning a wrong algoPath given
 			Logger::getInstance().log(Severity::ERROR_LEVEL,
 									  "Error: Trying to load algorithm from " + algoName +
@@ -113,14 +269,17 @@ namespace battleship
 		}
 		
 		// Algo's DLL loaded before
-		// Retrieve algorithm descriptor & create an instance out of it
-		auto algoDescriptor = *it;
+		// Retrieve algorithm descriptor & create an instance out of it (the instance is created without the lock)
+		auto algoDescriptor = *loadedDescriptor;
+		lock.unlock();
 
 		auto getAlgorithmFunc = algoDescriptor.algoFunc;
+		auto getAlgorithmExFunc = algoDescriptor.algoExFunc;
 
-		// Call GetAlgorithm for the specified algorithm,
+		// Call GetAlgorithm (or GetAlgorithmEx if supported) for the specified algorithm,
 		// this should create a new instance for that algo type 
-		IBattleshipGameAlgo* algo = getAlgorithmFunc();
+		IBattleshipGameAlgo* algo = (getAlgorithmExFunc != nullptr) ? getAlgorithmExFunc(ALGO_EX_VERSION) :
+																	   getAlgorithmFunc();
 		if (nullptr == algo)
 		{
 			Logger::getInstance().log(Severity::ERROR_LEVEL,
@@ -4,13 +4,17 @@
 #include <windows.h>
 #include <vector>
 #include <unordered_map>
+#include <cstdint>
+#include <mutex>
 #include "IBattleshipGameAlgo.h"
+#include "IBattleshipGameAlgoEx.h"
 
 using std::unique_ptr;
 using std::shared_ptr;
 using std::vector;
 using std::unordered_map;
 using std::string;
+using std::mutex;
 
 namespace battleship
 {
@@ -32,10 +36,14 @@ namespace battleship
 		AlgoLoader(AlgoLoader&& other) noexcept = delete;			  // Disable moving
 		AlgoLoader& operator= (AlgoLoader&& other) noexcept = delete; // Disable moving (assignment)
 
-		/** Get list of algorithms available for loading (their dll is present in the game dir) */
+		/** Get list of algorithms available for loading (their dll is present in the game dir).
+		 *  The list may change while loadNewAlgorithms runs.
+		 */
 		const vector<string>& availableGameAlgos() const;
 
-		/** Get list of algorithm whose dll was successfully loaded */
+		/** Get list of algorithm whose dll was successfully loaded.
+		 *  The list may change while loadNewAlgorithms runs.
+		 */
 		const vector<string>& loadedGameAlgos() const;
 
 		/** Creates a new instance of the algorithm in the given path.
@@ -45,33 +53,77 @@ namespace battleship
 		 */
 		unique_ptr<IBattleshipGameAlgo> requestAlgo(const string& algoName) const;
 
+		/** Typedef for object creating new IBattleshipGameAlgo objects from Dlls */
+		using GetAlgorithmFuncType = IBattleshipGameAlgo *(*)();
+
+		/** Typedef for object creating new IBattleshipGameAlgoEx objects from Dlls (optional export) */
+		using GetAlgorithmExFuncType = IBattleshipGameAlgoEx *(*)(int version);
+
 		/** Loads & validates all available game algorithms. 
 		 *	Returns a list of available algorithm names.
 		 */
 		const vector<string>& loadAllAvailableAlgorithms();
 
+		/** Loads & validates the given dlls of the path, which appeared in it after it was listed (e.g. while a
+		 *  competition runs). Dlls that were found before aren't loaded again, even if they failed to load.
+		 *  Returns the names of the algorithms that were loaded.
+		 *  Instances of the new algorithms may be requested right away, from any thread.
+		 */
+		vector<string> loadNewAlgorithms(const vector<string>& dllNames);
+
+		/** Registers an algorithm that is compiled into the executable (no dll) under the given name.
+		 *  The algorithm is loaded right away and algoFunc is used to create its instances.
+		 *  Returns false if an algorithm with that name is already loaded.
+		 */
+		bool registerStaticAlgorithm(const string& algoName, GetAlgorithmFuncType algoFunc);
+
+		/** Returns the function that creates instances of the given algorithm, if it was registered with
+		 *  registerStaticAlgorithm. For algorithms loaded from dlls (or not loaded at all), NULL is returned.
+		 */
+		GetAlgorithmFuncType staticAlgorithmFunc(const string& algoName) const;
+
+		/** Returns true if instances of the given algorithm implement IBattleshipGameAlgoEx
+		 *  (its dll exports a GetAlgorithmEx that supports ALGO_EX_VERSION).
+		 */
+		bool isExtendedAlgorithm(const string& algoName) const;
+
+		/** Returns a hash of the contents of the algorithm's binary (see IOUtil::contentHash): its dll, or the
+		 *  executable and the algorithm's name for algorithms compiled into it.
+		 *  Algorithms with the same fingerprint play the same way.
+		 *  Returns NO_FINGERPRINT if the algorithm isn't loaded or its binary couldn't be read.
+		 */
+		uint64_t fingerprint(const string& algoName) const;
+
+		/** Fingerprint of algorithms whose binary is unknown */
+		static constexpr uint64_t NO_FINGERPRINT = 0;
+
+		/** Extension of algorithm dlls */
+		static constexpr auto DLL_EXTENSION = "dll";
+
 	private:
 
 		static constexpr auto DLL_SUFFIX_LONG = ".smart.dll";
 		static constexpr auto DLL_SUFFIX_SHORT = ".dll";
 
-		/** Typedef for object creating new IBattleshipGameAlgo objects from Dlls */
-		using GetAlgorithmFuncType = IBattleshipGameAlgo *(*)();
-
 		/** Descriptor for IBattleshipGameAlgo available for loading.
 		 *	This is essentially all the information available on an algorithm we can load.
 		 */
 		struct AlgoDescriptor
 		{
 			string path;
-			HINSTANCE dll;
+			HINSTANCE dll;		// NULL for algorithms compiled into the executable
 			GetAlgorithmFuncType algoFunc;
+			GetAlgorithmExFuncType algoExFunc;	// NULL unless the algorithm supports the extended interface
+			uint64_t fingerprint;	// Hash of the algorithm's binary (NO_FINGERPRINT if unknown)
 
-			AlgoDescriptor(const string& aPath, HINSTANCE aDll, GetAlgorithmFuncType aAlgoFunc)
+			AlgoDescriptor(const string& aPath, HINSTANCE aDll, GetAlgorithmFuncType aAlgoFunc, uint64_t aFingerprint,
+						   GetAlgorithmExFuncType aAlgoExFunc = nullptr)
 			{
 				path = aPath;
 				dll = aDll;
 				algoFunc = aAlgoFunc;
+				algoExFunc = aAlgoExFunc;
+				fingerprint = aFingerprint;
 			}
 		};
 
@@ -87,8 +139,25 @@ namespace battleship
 		/** Vector of loaded algorithms: <Algorithm name, dll handle, GetAlgorithm function ptr> */
 		vector<AlgoDescriptor> _loadedGameAlgos;
 
-		/** Loads the algorithm's DLL in the given path */
-		void loadAlgorithm(const string& algoName);
+		/** Locks the loaded algorithms, so algorithms can be loaded while worker threads request instances */
+		mutable mutex _loadedAlgosLock;
+
+		/** Fingerprint of the executable, shared by all compiled-in algorithms (computed when the first one registers) */
+		uint64_t _executableFingerprint;
+
+		/** Returns the contents hash of the given binary file, or NO_FINGERPRINT if it can't be read */
+		static uint64_t binaryFingerprint(const string& filename);
+
+		/** Loads the algorithm's DLL in the given path. Returns false if it couldn't be loaded. */
+		bool loadAlgorithm(const string& algoName);
+
+		/** Returns the descriptor of the loaded algorithm, or NULL if it isn't loaded.
+		 *  Expected to be called while holding _loadedAlgosLock.
+		 */
+		const AlgoDescriptor* findAlgorithm(const string& algoName) const;
+
+		/** Returns the dll's GetAlgorithmEx if it's exported and supports ALGO_EX_VERSION, or NULL otherwise */
+		static GetAlgorithmExFuncType loadExtendedAlgorithmFunc(HINSTANCE hDll, const string& algoName);
 
 		/** Fetches names for all algorithms available in the given path.
 	 	 *	(populates the AlgoLoad with available dlls for loading)
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include "IBattleshipGameAlgo.h"
+
+using std::thread;
+using std::mutex;
+using std::condition_variable;
+using std::unique_lock;
+using std::lock_guard;
+using std::atomic;
+using std::vector;
+using std::function;
+
+#pragma region Algorithm Parallelism
+
+/** Helper threads the game lends to algorithms, to split their per-move scans of huge boards across the board's
+ *  depth layers. Implemented by the game (see LayerTaskPool).
+ */
+class LayerTaskRunner
+{
+public:
+	virtual ~LayerTaskRunner() = default;
+
+	/** Number of helper threads the runner may use (0 runs everything on the calling thread) */
+	virtual int helperThreadsCount() const = 0;
+
+	/** Smallest board (in squares) whose scans are worth splitting across the helper threads: on smaller boards,
+	 *  handing the layers to the helpers costs more than it saves. Set by the game's configuration.
+	 */
+	virtual int minParallelSquares() const = 0;
+
+	/** Calls layerFunc(layer) for every layer in the range [0, layersCount-1], and returns once all calls are done.
+	 *  Layers are processed in parallel by the helper threads and the calling thread, in no particular order.
+	 *  layerFunc must only read state that is shared between layers.
+	 */
+	virtual void forEachLayer(int layersCount, const function<void(int)>& layerFunc) = 0;
+};
+
+/** Optional extension of IBattleshipGameAlgo, for algorithms that can use the helper threads the game lends them.
+ *  The game passes its runner to every instance it creates, before the instance plays its first game. The runner
+ *  outlives the instance, and is shared by all the instances of a worker thread - so it must only be used from
+ *  within the calls the game makes to the algorithm.
+ */
+class ParallelAlgo
+{
+public:
+	virtual ~ParallelAlgo() = default;
+
+	/** Sets the helper threads the algorithm may use */
+	virtual void setLayerTaskRunner(LayerTaskRunner* runner) = 0;
+};
+
+/** Returns the algorithm's parallel extension, or NULL if the algorithm doesn't provide one */
+inline ParallelAlgo* parallelAlgoOf(IBattleshipGameAlgo& algo)
+{
+	return dynamic_cast<ParallelAlgo*>(&algo);
+}
+
+/** A small pool of helper threads, owned by a single worker thread of the game and lent to the algorithm instances
+ *  it plays (only one of which makes a call at a time).
+ *  The helper threads are only started by the first forEachLayer that has layers to split, so workers that never
+ *  play a huge board don't keep idle threads.
+ *  forEachLayer must only be called by the worker thread.
+ */
+class LayerTaskPool final : public LayerTaskRunner
+{
+public:
+	/** Smallest board split by default, 32x32x32 squares: its scan takes tens of microseconds, far above the cost of
+	 *  handing the layers to the helpers and waiting for them
+	 */
+	static constexpr int DEFAULT_MIN_PARALLEL_SQUARES = 1 << 15;
+
+	/** Creates a pool with the given number of helper threads (0 runs everything on the calling thread), lent to
+	 *  scans of boards of at least minParallelSquares squares
+	 */
+	explicit LayerTaskPool(int helperThreadsCount, int minParallelSquares = DEFAULT_MIN_PARALLEL_SQUARES) :
+		_helperThreadsCount(std::max(0, helperThreadsCount)),
+		_minParallelSquares(minParallelSquares),
+		_layerFunc(nullptr),
+		_layersCount(0),
+		_nextLayer(0),
+		_layersLeft(0),
+		_activeHelpers(0),
+		_jobId(0),
+		_isStopping(false)
+	{
+	}
+
+	~LayerTaskPool()
+	{
+		{
+			lock_guard<mutex> lock(_jobLock);
+			_isStopping = true;
+		}
+		_jobReady.notify_all();
+
+		for (auto& helper : _helpers)
+		{
+			if (helper.joinable())
+				helper.join();
+		}
+	}
+
+	LayerTaskPool(LayerTaskPool const&) = delete;	// Disable copying
+	LayerTaskPool& operator=(LayerTaskPool const&) = delete;	// Disable copying (assignment)
+
+	void forEachLayer(int layersCount, const function<void(int)>& layerFunc) override
+	{
+		if ((_helperThreadsCount == 0) || (layersCount < 2))
+		{	// Nothing to split
+			for (int layer = 0; layer < layersCount; layer++)
+				layerFunc(layer);
+			return;
+		}
+
+		if (_helpers.empty())
+		{
+			for (int helperIndex = 0; helperIndex < _helperThreadsCount; helperIndex++)
+				_helpers.emplace_back(&LayerTaskPool::runHelper, this);
+		}
+
+		{
+			lock_guard<mutex> lock(_jobLock);
+			_layerFunc = &layerFunc;
+			_layersCount = layersCount;
+			_nextLayer = 0;
+			_layersLeft = layersCount;
+			_jobId++;
+		}
+		_jobReady.notify_all();
+
+		// The calling thread takes layers as well instead of waiting idle
+		processLayers(layerFunc);
+
+		// Wait until the helpers are done with this job, layerFunc must stay valid until then
+		unique_lock<mutex> lock(_jobLock);
+		_jobDone.wait(lock, [this]() { return (_layersLeft == 0) && (_activeHelpers == 0); });
+		_layerFunc = nullptr;
+	}
+
+	int helperThreadsCount() const override
+	{
+		return _helperThreadsCount;
+	}
+
+	int minParallelSquares() const override
+	{
+		return _minParallelSquares;
+	}
+
+private:
+	int _helperThreadsCount;
+	int _minParallelSquares;
+
+	/** Started by the first job that has layers to split */
+	vector<thread> _helpers;
+
+	/** Current job: the function called for every layer, and the layers left to take / left to finish */
+	const function<void(int)>* _layerFunc;
+	int _layersCount;
+	atomic<int> _nextLayer;
+	atomic<int> _layersLeft;
+
+	/** Number of helpers that are currently working on a job */
+	int _activeHelpers;
+
+	/** Incremented for every job, so helpers can tell a new job from the one they already did */
+	unsigned int _jobId;
+
+	bool _isStopping;
+
+	mutex _jobLock;
+	condition_variable _jobReady;
+	condition_variable _jobDone;
+
+	/** Takes layers of the current job and processes them until no layers are left to take */
+	void processLayers(const function<void(int)>& layerFunc)
+	{
+		int layer;
+		while ((layer = _nextLayer.fetch_add(1)) < _layersCount)
+		{
+			layerFunc(layer);
+
+			if (_layersLeft.fetch_sub(1) == 1)
+			{	// Last layer of the job, wake the calling thread
+				lock_guard<mutex> lock(_jobLock);
+				_jobDone.notify_all();
+			}
+		}
+	}
+
+	void runHelper()
+	{
+		unsigned int lastJobId = 0;
+
+		while (true)
+		{
+			const function<void(int)>* layerFunc;
+
+			{
+				unique_lock<mutex> lock(_jobLock);
+				_jobReady.wait(lock, [this, lastJobId]() { return _isStopping || ((_jobId != lastJobId) && (_layerFunc != nullptr)); });
+
+				if (_isStopping)
+					return;
+
+				lastJobId = _jobId;
+				layerFunc = _layerFunc;
+				_activeHelpers++;
+			}
+
+			processLayers(*layerFunc);
+
+			{
+				lock_guard<mutex> lock(_jobLock);
+				_activeHelpers--;
+			}
+			_jobDone.notify_all();
+		}
+	}
+};
+
+#pragma endregion
@@ -0,0 +1,87 @@
+#include "AllocationCounter.h"
+#include <cstdlib>
+#include <new>
+
+namespace battleship
+{
+	// Per thread counters, so counting doesn't need any synchronization
+	static thread_local long long threadAllocationsCount = 0;
+	static thread_local long long threadAllocatedBytes = 0;
+
+	long long AllocationCounter::allocationsCount()
+	{
+		return threadAllocationsCount;
+	}
+
+	long long AllocationCounter::allocatedBytes()
+	{
+		return threadAllocatedBytes;
+	}
+
+	void AllocationCounter::recordAllocation(size_t bytes)
+	{
+		threadAllocationsCount++;
+		threadAllocatedBytes += static_cast<long long>(bytes);
+	}
+}
+
+#pragma region Global allocation operators
+
+void* operator new(size_t size)
+{
+	battleship::AllocationCounter::recordAllocation(size);
+
+	void* ptr = std::malloc((size > 0) ? size : 1);
+	if (ptr == nullptr)
+		throw std::bad_alloc();
+
+	return ptr;
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	battleship::AllocationCounter::recordAllocation(size);
+	return std::malloc((size > 0) ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept
+{
+	return operator new(size, tag);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+	std::free(ptr);
+}
+
+#pragma endregion
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+
+namespace battleship
+{
+	/** Counts the heap allocations made by the current thread.
+	 *  Counting is enabled by replacing the global operator new / delete, which is done in AllocationCounter.cpp:
+	 *  only executables that link it (the game and the benchmarks) pay for the counting - a thread local increment
+	 *  per allocation.
+	 */
+	class AllocationCounter
+	{
+	public:
+		virtual ~AllocationCounter() = delete; // This class shouldn't be instantiated (or destroyed)
+
+		/** Number of allocations made by the current thread so far */
+		static long long allocationsCount();
+
+		/** Number of bytes allocated by the current thread so far */
+		static long long allocatedBytes();
+
+		/** Records a single allocation of the given size, called by the replaced operator new */
+		static void recordAllocation(size_t bytes);
+
+	private:
+		/** Hide the ctor - this class shouldn't be instantiated */
+		AllocationCounter() = default;
+	};
+}
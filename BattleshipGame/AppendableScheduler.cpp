@@ -0,0 +1,73 @@
+#include "AppendableScheduler.h"
+
+using std::lock_guard;
+
+namespace battleship
+{
+	AppendableScheduler::AppendableScheduler(unique_ptr<TournamentScheduler> baseScheduler) :
+		_baseScheduler(std::move(baseScheduler)),
+		_appendedGamesCount(0),
+		_isClosed(false)
+	{
+	}
+
+	size_t AppendableScheduler::pendingGamesCount() const
+	{
+		lock_guard<mutex> lock(_appendLock);
+		return _baseScheduler->pendingGamesCount() + _appendedGamesCount;
+	}
+
+	bool AppendableScheduler::isExhausted() const
+	{
+		lock_guard<mutex> lock(_appendLock);
+		return _isClosed || (_baseScheduler->isExhausted() && _appendedGames.empty());
+	}
+
+	unique_ptr<SingleGameTask> AppendableScheduler::next()
+	{
+		unique_ptr<SingleGameTask> task = _baseScheduler->next();
+		if (task != nullptr)
+			return task;
+
+		lock_guard<mutex> lock(_appendLock);
+
+		// The worker that gets no game finishes, games appended from now on might never be played
+		if (_appendedGames.empty())
+		{
+			_isClosed = true;
+			return nullptr;
+		}
+
+		task = std::move(_appendedGames.front());
+		_appendedGames.pop_front();
+		return task;
+	}
+
+	void AppendableScheduler::onGameFinished(const SingleGameTask& task, const GameResults& results)
+	{
+		_baseScheduler->onGameFinished(task, results);
+	}
+
+	bool AppendableScheduler::append(vector<unique_ptr<SingleGameTask>> games, const function<void()>& onAccepted)
+	{
+		lock_guard<mutex> lock(_appendLock);
+
+		if (_isClosed)
+			return false;
+
+		// Appended games are dealt under the lock, so none of them is dealt before onAccepted returns
+		onAccepted();
+
+		_appendedGamesCount += games.size();
+		for (auto& game : games)
+			_appendedGames.push_back(std::move(game));
+
+		return true;
+	}
+
+	void AppendableScheduler::close()
+	{
+		lock_guard<mutex> lock(_appendLock);
+		_isClosed = true;
+	}
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <functional>
+#include "TournamentScheduler.h"
+
+using std::unique_ptr;
+using std::vector;
+using std::deque;
+using std::mutex;
+using std::function;
+
+namespace battleship
+{
+	/** Deals the games of a base scheduler, followed by games that are appended while the competition runs
+	 *  (e.g. the games of algorithms and boards that were added to a running competition).
+	 *  Games of the base scheduler are dealt without locking. Appended games are dealt in the order they were
+	 *  appended, once the base scheduler has no more games.
+	 *  The scheduler is closed once it dealt its last game: games that are appended later are rejected, since the
+	 *  worker threads may have finished already.
+	 *  The base scheduler is told about the results of all games, so its games shouldn't depend on earlier results
+	 *  (e.g. a GameTaskCursor).
+	 */
+	class AppendableScheduler : public TournamentScheduler
+	{
+	public:
+		AppendableScheduler(unique_ptr<TournamentScheduler> baseScheduler);
+		virtual ~AppendableScheduler() = default;
+
+		AppendableScheduler(AppendableScheduler const&) = delete;	// Disable copying
+		AppendableScheduler& operator=(AppendableScheduler const&) = delete;	// Disable copying (assignment)
+
+		size_t pendingGamesCount() const override;
+		bool isExhausted() const override;
+		unique_ptr<SingleGameTask> next() override;
+		void onGameFinished(const SingleGameTask& task, const GameResults& results) override;
+
+		/** Appends games to deal after all the games that were scheduled so far.
+		 *  If the games are accepted, onAccepted is invoked before any of them can be dealt (e.g. to add their
+		 *  players to the scoreboard). Returns false if the scheduler is closed, in which case onAccepted isn't
+		 *  invoked. This method is thread safe.
+		 */
+		bool append(vector<unique_ptr<SingleGameTask>> games, const function<void()>& onAccepted);
+
+		/** Closes the scheduler, so no more games can be appended (e.g. when the competition is over) */
+		void close();
+
+	private:
+		unique_ptr<TournamentScheduler> _baseScheduler;
+
+		/** Appended games that weren't dealt yet */
+		deque<unique_ptr<SingleGameTask>> _appendedGames;
+
+		/** Number of games appended since the competition started */
+		size_t _appendedGamesCount;
+
+		/** True once no more games can be appended */
+		bool _isClosed;
+
+		/** Protects all of the above, except for the base scheduler */
+		mutable mutex _appendLock;
+	};
+}
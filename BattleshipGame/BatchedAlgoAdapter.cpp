@@ -0,0 +1,105 @@
+#include "BatchedAlgoAdapter.h"
+#include "AlgoCommon.h"
+
+namespace battleship
+{
+	BatchedAlgoAdapter::BatchedAlgoAdapter(IBattleshipGameAlgoEx& algo) :
+		_algo(algo),
+		_player(0),
+		_attacks(MAX_BATCHED_ATTACKS, NO_MORE_MOVES),
+		_attacksCount(0),
+		_nextAttack(0)
+	{
+		_pendingResults.reserve(MAX_BATCHED_ATTACKS * 2);
+	}
+
+	void BatchedAlgoAdapter::setPlayer(int player)
+	{
+		_player = player;
+		_algo.setPlayer(player);
+	}
+
+	void BatchedAlgoAdapter::setBoard(const BoardData& board)
+	{
+		// New game, nothing from the previous game is relevant anymore
+		_pendingResults.clear();
+		_attacksCount = 0;
+		_nextAttack = 0;
+
+		_algo.setBoard(board);
+	}
+
+	Coordinate BatchedAlgoAdapter::attack()
+	{
+		if (!_pendingResults.empty())
+		{
+			_algo.notifyOnAttackResults(_pendingResults.data(), static_cast<int>(_pendingResults.size()));
+			_pendingResults.clear();
+		}
+
+		if (_nextAttack >= _attacksCount)
+		{	// Batch is over, request the next one
+			int attacksCount = _algo.attackBatch(_attacks.data(), MAX_BATCHED_ATTACKS);
+			_attacksCount = (attacksCount < 0) ? 0 :
+							(attacksCount > MAX_BATCHED_ATTACKS) ? MAX_BATCHED_ATTACKS : attacksCount;
+			_nextAttack = 0;
+
+			if (_attacksCount == 0)
+				return NO_MORE_MOVES; // Player forfeits
+		}
+
+		return _attacks[_nextAttack++];
+	}
+
+	void BatchedAlgoAdapter::notifyOnAttackResult(int player, Coordinate move, AttackResult result)
+	{
+		_pendingResults.push_back(AttackNotification{ player, move, result });
+
+		// The opponent attacked, so the moves left were speculated on an outdated game state
+		if (player != _player)
+			_nextAttack = _attacksCount;
+	}
+
+	GameResults BatchedAlgoAdapter::runGameExtendedA(shared_ptr<BattleBoard> board,
+													 IBattleshipGameAlgo* playerA,
+													 IBattleshipGameAlgo* playerB,
+													 const BoardData& playerAView,
+													 const BoardData& playerBView)
+	{
+		BatchedAlgoAdapter batchedPlayerA(*static_cast<IBattleshipGameAlgoEx*>(playerA));
+		return GameManager::runTypedGame(board, batchedPlayerA, *playerB, playerAView, playerBView);
+	}
+
+	GameResults BatchedAlgoAdapter::runGameExtendedB(shared_ptr<BattleBoard> board,
+													 IBattleshipGameAlgo* playerA,
+													 IBattleshipGameAlgo* playerB,
+													 const BoardData& playerAView,
+													 const BoardData& playerBView)
+	{
+		BatchedAlgoAdapter batchedPlayerB(*static_cast<IBattleshipGameAlgoEx*>(playerB));
+		return GameManager::runTypedGame(board, *playerA, batchedPlayerB, playerAView, playerBView);
+	}
+
+	GameResults BatchedAlgoAdapter::runGameExtendedAB(shared_ptr<BattleBoard> board,
+													  IBattleshipGameAlgo* playerA,
+													  IBattleshipGameAlgo* playerB,
+													  const BoardData& playerAView,
+													  const BoardData& playerBView)
+	{
+		BatchedAlgoAdapter batchedPlayerA(*static_cast<IBattleshipGameAlgoEx*>(playerA));
+		BatchedAlgoAdapter batchedPlayerB(*static_cast<IBattleshipGameAlgoEx*>(playerB));
+		return GameManager::runTypedGame(board, batchedPlayerA, batchedPlayerB, playerAView, playerBView);
+	}
+
+	GameManager::GameRunnerFuncType BatchedAlgoAdapter::gameRunnerFor(bool isPlayerAExtended, bool isPlayerBExtended)
+	{
+		if (isPlayerAExtended && isPlayerBExtended)
+			return &runGameExtendedAB;
+		else if (isPlayerAExtended)
+			return &runGameExtendedA;
+		else if (isPlayerBExtended)
+			return &runGameExtendedB;
+		else
+			return &GameManager::runGame;
+	}
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "IBattleshipGameAlgoEx.h"
+#include "GameManager.h"
+
+using std::vector;
+
+namespace battleship
+{
+	/** Plays an IBattleshipGameAlgoEx algorithm through the per-move calls of the GameManager game loop.
+	 *  Attack results are buffered and delivered in a single notifyOnAttackResults call right before the player's
+	 *  next move, and moves are requested in batches with attackBatch and played one by one from the buffer.
+	 */
+	class BatchedAlgoAdapter final
+	{
+	public:
+		BatchedAlgoAdapter(IBattleshipGameAlgoEx& algo);
+		~BatchedAlgoAdapter() = default;
+
+		BatchedAlgoAdapter(BatchedAlgoAdapter const&) = delete;	// Disable copying
+		BatchedAlgoAdapter& operator=(BatchedAlgoAdapter const&) = delete;	// Disable copying (assignment)
+
+		void setPlayer(int player);
+
+		void setBoard(const BoardData& board);
+
+		/** Delivers the buffered results, and returns the next move (requesting a new batch if needed) */
+		Coordinate attack();
+
+		/** Buffers the result. Once the opponent attacks, the moves left in the batch are dropped. */
+		void notifyOnAttackResult(int player, Coordinate move, AttackResult result);
+
+		/** Returns the game loop for a game between the given players, according to which of them
+		 *  implement IBattleshipGameAlgoEx. If none of them does, GameManager::runGame is returned.
+		 */
+		static GameManager::GameRunnerFuncType gameRunnerFor(bool isPlayerAExtended, bool isPlayerBExtended);
+
+	private:
+		/** Maximal number of moves requested from the algorithm in a single batch */
+		static constexpr int MAX_BATCHED_ATTACKS = 8;
+
+		IBattleshipGameAlgoEx& _algo;
+		int _player;
+
+		/** Results not delivered to the algorithm yet */
+		vector<AttackNotification> _pendingResults;
+
+		/** Moves of the current batch, the ones from _nextAttack to _attacksCount weren't played yet */
+		vector<Coordinate> _attacks;
+		int _attacksCount;
+		int _nextAttack;
+
+		/** Game loops for games where player A, player B or both players implement IBattleshipGameAlgoEx */
+		static GameResults runGameExtendedA(shared_ptr<BattleBoard> board,
+											IBattleshipGameAlgo* playerA, IBattleshipGameAlgo* playerB,
+											const BoardData& playerAView, const BoardData& playerBView);
+		static GameResults runGameExtendedB(shared_ptr<BattleBoard> board,
+											IBattleshipGameAlgo* playerA, IBattleshipGameAlgo* playerB,
+											const BoardData& playerAView, const BoardData& playerBView);
+		static GameResults runGameExtendedAB(shared_ptr<BattleBoard> board,
+											 IBattleshipGameAlgo* playerA, IBattleshipGameAlgo* playerB,
+											 const BoardData& playerAView, const BoardData& playerBView);
+	};
+}
@@ -1,4 +1,5 @@
 #include <map>
+#include <cctype>
 #include "BattleBoard.h"
 
 using std::map;
@@ -27,6 +28,16 @@ namespace battleship
 	{
 	}
 
+	GamePiece::GamePiece(GamePiece const& other, MonotonicArena* arena) :
+		_firstPos(other._firstPos),
+		_shipType(other._shipType),
+		_orient(other._orient),
+		_player(other._player),
+		_lifeLeft(other._lifeLeft),
+		_damagedCoords(other._damagedCoords, ArenaAllocator<Coordinate>(arena))
+	{
+	}
+
 	#pragma endregion
 	#pragma region BattleBoard
 
@@ -51,7 +62,9 @@ namespace battleship
 		_boardDepth(other._boardDepth),
 		_gamePieces(std::move(other._gamePieces)),
 		_playerAShipCount(other._playerAShipCount),
-		_playerBShipCount(other._playerBShipCount)
+		_playerBShipCount(other._playerBShipCount),
+		_playerASquares(std::move(other._playerASquares)),
+		_playerBSquares(std::move(other._playerBSquares))
 	{
 	}
 
@@ -59,6 +72,8 @@ namespace battleship
 	BattleBoard& BattleBoard::operator= (BattleBoard&& other) noexcept
 	{
 		_gamePieces = std::move(other._gamePieces);
+		_playerASquares = std::move(other._playerASquares);
+		_playerBSquares = std::move(other._playerBSquares);
 		_playerAShipCount = other._playerAShipCount;
 		_playerBShipCount = other._playerBShipCount;
 		_boardWidth = other._boardWidth;
@@ -75,22 +90,37 @@ namespace battleship
 	}
 
 	// Copy ctor
-	BattleBoard::BattleBoard(BattleBoard const& other):
+	BattleBoard::BattleBoard(BattleBoard const& other) : BattleBoard(other, nullptr)
+	{
+	}
+
+	BattleBoard::BattleBoard(BattleBoard const& other, MonotonicArena* arena) :
 		_boardWidth(other._boardWidth),
 		_boardHeight(other._boardHeight),
 		_boardDepth(other._boardDepth),
+		_gamePieces(other._gamePieces.size(), CoordinateHash(), std::equal_to<Coordinate>(),
+					GamePiecesDict::allocator_type(arena)),
 		_playerAShipCount(other._playerAShipCount),
-		_playerBShipCount(other._playerBShipCount)
+		_playerBShipCount(other._playerBShipCount),
+		_playerASquares(other._playerASquares),	// Snapshots are immutable and shared between clones
+		_playerBSquares(other._playerBSquares)
 	{
 		// Perform deep copy for game pieces as they contain data that may change along the game and shouldn't
-		// be shared among common boards
-		map<Coordinate, shared_ptr<GamePiece>> copiedGamePieces;	// We should copy only once for each ship
+		// be shared among common boards. Everything is allocated from the arena (if any), including the map below.
+		using CopiedPiecesMap = map<Coordinate, shared_ptr<GamePiece>, std::less<Coordinate>,
+									ArenaAllocator<pair<const Coordinate, shared_ptr<GamePiece>>>>;
+		CopiedPiecesMap::allocator_type copiedPiecesAllocator(arena);
+		CopiedPiecesMap copiedGamePieces(copiedPiecesAllocator);	// We should copy only once for each ship
 		for (auto it = other._gamePieces.begin(); it != other._gamePieces.end(); ++it)
 		{
-			if (copiedGamePieces.find(it->second->_firstPos) == copiedGamePieces.end())
-				copiedGamePieces.emplace(it->second->_firstPos, std::make_shared<GamePiece>(*it->second));
+			auto copiedIt = copiedGamePieces.find(it->second->_firstPos);
+			if (copiedIt == copiedGamePieces.end())
+			{
+				auto copiedPiece = std::allocate_shared<GamePiece>(ArenaAllocator<GamePiece>(arena), *it->second, arena);
+				copiedIt = copiedGamePieces.emplace(it->second->_firstPos, copiedPiece).first;
+			}
 
-			_gamePieces.emplace(it->first, copiedGamePieces[it->second->_firstPos]);
+			_gamePieces.emplace(it->first, copiedIt->second);
 		}
 	}
 	
@@ -105,6 +135,8 @@ namespace battleship
 			_boardWidth = other._boardWidth;
 			_boardHeight = other._boardHeight;
 			_boardDepth = other._boardDepth;
+			_playerASquares = other._playerASquares;
+			_playerBSquares = other._playerBSquares;
 
 			_gamePieces.clear(); 
 
@@ -156,6 +188,29 @@ namespace battleship
 		}
 	}
 
+	void BattleBoard::buildPlayerSquares()
+	{
+		size_t squaresCount = static_cast<size_t>(_boardWidth) * _boardHeight * _boardDepth;
+		auto playerASquares = std::make_shared<vector<char>>(squaresCount, static_cast<char>(BoardSquare::Empty));
+		auto playerBSquares = std::make_shared<vector<char>>(squaresCount, static_cast<char>(BoardSquare::Empty));
+
+		for (const auto& gamePieceEntry : _gamePieces)
+		{
+			const Coordinate& coord = gamePieceEntry.first;
+			const GamePiece& gamePiece = *gamePieceEntry.second;
+			size_t index = (static_cast<size_t>(coord.depth) * _boardHeight + coord.row) * _boardWidth + coord.col;
+			char square = static_cast<char>(gamePiece._shipType->_representation);
+
+			if (gamePiece._player == PlayerEnum::A)
+				(*playerASquares)[index] = square;
+			else
+				(*playerBSquares)[index] = static_cast<char>(std::tolower(square));
+		}
+
+		_playerASquares = playerASquares;
+		_playerBSquares = playerBSquares;
+	}
+
 	void BattleBoard::sinkShip(const GamePiece* pieceToRemove)
 	{
 		int deltaCol = (pieceToRemove->_orient == Orientation::X_AXIS) ? 1 : 0;
@@ -227,6 +282,11 @@ namespace battleship
 		return _playerBShipCount;
 	}
 
+	shared_ptr<const vector<char>> BattleBoard::playerSquares(PlayerEnum player) const
+	{
+		return (player == PlayerEnum::A) ? _playerASquares : _playerBSquares;
+	}
+
 	PlayerEnum BattleBoard::whichPlayerOwnsSquare(const Coordinate& pos) const
 	{
 		auto dictIter = _gamePieces.find(pos);
@@ -275,5 +335,17 @@ namespace battleship
 		return _boardDepth;
 	}
 
+	const ShipType* BattleBoard::shipTypeOf(BoardSquare square)
+	{
+		switch (static_cast<BoardSquare>(toupper(static_cast<char>(square))))
+		{
+			case BoardSquare::RubberBoat: return &RUBBER_BOAT;
+			case BoardSquare::RocketShip: return &ROCKET_SHIP;
+			case BoardSquare::Submarine: return &SUBMARINE;
+			case BoardSquare::Battleship: return &BATTLESHIP;
+			default: return nullptr;
+		}
+	}
+
 	#pragma endregion
 }
\ No newline at end of file
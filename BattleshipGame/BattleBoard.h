@@ -5,8 +5,10 @@
 #include <unordered_map>
 #include <utility>
 #include <functional>
+#include <vector>
 #include "IBattleshipGameAlgo.h"
 #include "AlgoCommon.h"
+#include "MonotonicArena.h"
 
 using std::shared_ptr;
 using std::unique_ptr;
@@ -15,6 +17,7 @@ using std::pair;
 using std::set;
 using std::unordered_map;
 using std::function;
+using std::vector;
 
 namespace battleship
 {
@@ -25,7 +28,12 @@ namespace battleship
 	/* -- Type defs -- */
 
 	// A mapping type for game pieces by 3d coordinates.
-	using GamePiecesDict = unordered_map<Coordinate, shared_ptr<GamePiece>, CoordinateHash>;
+	// Allocated from the game's arena for boards cloned into one (see BoardBuilder::clone), from the heap otherwise.
+	using GamePiecesDict = unordered_map<Coordinate, shared_ptr<GamePiece>, CoordinateHash, std::equal_to<Coordinate>,
+										 ArenaAllocator<pair<const Coordinate, shared_ptr<GamePiece>>>>;
+
+	// The damaged squares of a game piece, allocated along with the piece's board
+	using DamagedCoordsSet = set<Coordinate, std::less<Coordinate>, ArenaAllocator<Coordinate>>;
 
 	/* -- Enums & consts -- */
 
@@ -73,9 +81,10 @@ namespace battleship
 
 		int _lifeLeft = 0;	// How many more hits can the game piece sustain
 
-		set<Coordinate> _damagedCoords;
+		DamagedCoordsSet _damagedCoords;
 		GamePiece(Coordinate firstPos, const ShipType *const type, PlayerEnum player, Orientation orientation);
 		GamePiece(GamePiece const&) = default; // Enable copying
+		GamePiece(GamePiece const& other, MonotonicArena* arena); // Copy, allocating the damaged squares from the arena
 		GamePiece& operator=(GamePiece const&) = default; // Enable copying (assignment)
 
 		virtual ~GamePiece() = default;
@@ -126,6 +135,20 @@ namespace battleship
 		/** Returns the board depth */
 		int depth() const;
 
+		/** Returns a flat snapshot of the squares the player sees when the game starts: the player's own ships
+		 *  and empty squares everywhere else (enemy ships are hidden).
+		 *  The snapshot is built once by the BoardBuilder and shared by all the clones of the board, so it
+		 *  doesn't reflect attacks made on this board.
+		 *  Square (row, col, depth) - in the range [0, BOARD_SIZE-1] - is at index
+		 *  (depth * height + row) * width + col.
+		 */
+		shared_ptr<const vector<char>> playerSquares(PlayerEnum player) const;
+
+		/** Returns the predefined ship type represented by the given square (case-insensitive),
+		 *  or NULL if the square doesn't represent a ship.
+		 */
+		static const ShipType* shipTypeOf(BoardSquare square);
+
 		/** Allows BoardBuilder access to the private constructor, so BoardBuilder is able to produce new
 		 *  BattleBoard instances (according to Builder pattern).
 		 */
@@ -150,6 +173,10 @@ namespace battleship
 		int _playerAShipCount = 0;
 		int _playerBShipCount = 0;
 
+		// Squares each player sees at the beginning of the game (see playerSquares())
+		shared_ptr<const vector<char>> _playerASquares;
+		shared_ptr<const vector<char>> _playerBSquares;
+
 		// BattleBoard default constructor is private, as only the BoardBuilder is expected to instantiate
 		// this object type.
 		BattleBoard(int width, int height, int depth);
@@ -158,6 +185,7 @@ namespace battleship
 		// so the copy constructor is private.
 		// An explicit call here can create additional boards from the board prototype when the builder requires it
 		BattleBoard(BattleBoard const& other); // Enable private copying (cloning from prototype)
+		BattleBoard(BattleBoard const& other, MonotonicArena* arena); // Copy, allocating the game pieces from the arena
 		BattleBoard& operator=(BattleBoard const& other); // Enable private copying (assignment)
 
 		/* Called when the board is initialized, to assemble game pieces list.
@@ -167,6 +195,11 @@ namespace battleship
 		void addGamePiece(Coordinate firstPos, const ShipType& shipType,
 						  PlayerEnum player, Orientation orientation);
 
+		/** Builds the players' squares snapshots out of the game pieces.
+		 *  Called by the BoardBuilder once the board is valid, before the board is used as a prototype.
+		 */
+		void buildPlayerSquares();
+
 		/** Applies a move of "sinking" a game-piece, assuming it has been hit enough times.
 		 *  The game piece will be removed from the board altogether, and the players ship count will be updated
 		 *  accordingly.
@@ -8,10 +8,12 @@
 using std::cout;
 using std::endl;
 using std::transform;
+using std::lock_guard;
 
 namespace battleship
 {
 	const string BattleshipGameBoardFactory::BOARD_SUFFIX = "sboard";
+	const string BattleshipGameBoardFactory::RANDOM_BOARD_PREFIX = "random";
 
 	BattleshipGameBoardFactory::BattleshipGameBoardFactory(const string& path): _path(path)
 	{
@@ -19,7 +21,7 @@ namespace battleship
 		_availableBoards = IOUtil::listFilesInPath(path, BOARD_SUFFIX);
 	}
 
-	bool BattleshipGameBoardFactory::parseHeader(string& nextLine, int& rows, int& cols, int& depth) const
+	bool BattleshipGameBoardFactory::parseHeader(string& nextLine, int& rows, int& cols, int& depth)
 	{
 		bool isValidFile = true;
 
@@ -71,6 +73,11 @@ namespace battleship
 		return isValidFile;
 	}
 
+	bool BattleshipGameBoardFactory::parseDimensions(string dimensions, int& rows, int& cols, int& depth)
+	{
+		return parseHeader(dimensions, rows, cols, depth);
+	}
+
 	void BattleshipGameBoardFactory::parseBoardRow(BoardBuilder& builder, string& nextLine,
 												   int depthIndex, int rowIndex, int cols)
 	{
@@ -168,48 +175,152 @@ namespace battleship
 		return board;
 	}
 
+	void BattleshipGameBoardFactory::addLoadedBoard(const string& boardName, unique_ptr<BattleBoard> board)
+	{
+		LoadedBoard loadedBoard;
+		loadedBoard.playerAView = std::make_shared<const BoardDataImpl>(PlayerEnum::A, *board);
+		loadedBoard.playerBView = std::make_shared<const BoardDataImpl>(PlayerEnum::B, *board);
+		loadedBoard.prototype = std::move(board);
+
+		// Together, the players' views hold every square of the board
+		const BoardDataImpl& playerAView = *loadedBoard.playerAView;
+		const int dimensions[] = { playerAView.rows(), playerAView.cols(), playerAView.depth() };
+		size_t squaresCount = static_cast<size_t>(dimensions[0]) * dimensions[1] * dimensions[2];
+		uint64_t fingerprint = IOUtil::contentHash(dimensions, sizeof(dimensions));
+		fingerprint = IOUtil::contentHash(playerAView.squares(), squaresCount, fingerprint);
+		loadedBoard.fingerprint = IOUtil::contentHash(loadedBoard.playerBView->squares(), squaresCount, fingerprint);
+
+		lock_guard<mutex> lock(_loadedBoardsLock);
+		_loadedBoards.emplace(make_pair(boardName, std::move(loadedBoard)));
+		_loadedBoardNames.push_back(boardName);
+	}
+
+	const BattleshipGameBoardFactory::LoadedBoard* BattleshipGameBoardFactory::findLoadedBoard(
+		const string& boardName) const
+	{
+		lock_guard<mutex> lock(_loadedBoardsLock);
+		auto boardIt = _loadedBoards.find(boardName);
+
+		// Nodes of the index don't move when boards are added, so the board can be used once the lock is released
+		return (boardIt != _loadedBoards.end()) ? &boardIt->second : nullptr;
+	}
+
+	bool BattleshipGameBoardFactory::loadBattleBoard(const string& boardFilename)
+	{
+		Logger::getInstance().log(Severity::INFO_LEVEL, "Loading battle board: " + boardFilename + "..");
+		string boardFile = _path + "\\" + boardFilename;
+		unique_ptr<BattleBoard> nextBoard = buildBoardFromFile(boardFile);
+
+		// Accumulate only valid boards
+		if (nullptr == nextBoard)
+		{
+			Logger::getInstance().log(Severity::WARNING_LEVEL,
+									  "Battle board " + boardFilename + " is invalid");
+			return false;
+		}
+
+		addLoadedBoard(boardFilename, std::move(nextBoard));
+		Logger::getInstance().log(Severity::INFO_LEVEL,
+								  "Battle board " + boardFilename + " loaded successfully");
+		return true;
+	}
+
 	const vector<string>& BattleshipGameBoardFactory::loadAllBattleBoards()
 	{
 		// Load each of the battle boards
 		for (const auto& boardFilename : _availableBoards)
 		{
-			Logger::getInstance().log(Severity::INFO_LEVEL, "Loading battle board: " + boardFilename + "..");
-			string boardFile = _path + "\\" + boardFilename;
-			unique_ptr<BattleBoard> nextBoard = buildBoardFromFile(boardFile);
+			loadBattleBoard(boardFilename);
+		}
 
-			// Accumulate only valid boards
-			if (nullptr != nextBoard)
-			{
-				_loadedBoards.emplace(make_pair(boardFilename, std::move(nextBoard)));
-				_loadedBoardNames.push_back(boardFilename);
-				Logger::getInstance().log(Severity::INFO_LEVEL,
-										  "Battle board " + boardFilename + " loaded successfully");
-			}
-			else
-			{
+		return _loadedBoardNames;
+	}
+
+	vector<string> BattleshipGameBoardFactory::loadNewBattleBoards(const vector<string>& boardFilenames)
+	{
+		vector<string> newBoards;
+
+		for (const auto& boardFilename : boardFilenames)
+		{
+			// Boards that were found before were already loaded (or found invalid)
+			if (std::find(_availableBoards.begin(), _availableBoards.end(), boardFilename) != _availableBoards.end())
+				continue;
+
+			_availableBoards.push_back(boardFilename);
+			if (loadBattleBoard(boardFilename))
+				newBoards.push_back(boardFilename);
+		}
+
+		return newBoards;
+	}
+
+	const vector<string>& BattleshipGameBoardFactory::generateRandomBattleBoards(const RandomBoardSpec& spec,
+																				  int count, unsigned int seed)
+	{
+		Logger::getInstance().log(Severity::INFO_LEVEL,
+								  "Generating " + std::to_string(count) + " random battle boards of size " +
+								  std::to_string(spec.width) + "x" + std::to_string(spec.height) + "x" +
+								  std::to_string(spec.depth) + " (seed " + std::to_string(seed) + ")..");
+
+		RandomBoardGenerator generator(spec, seed);
+		string namePrefix = RANDOM_BOARD_PREFIX + "_" + std::to_string(spec.width) + "x" + std::to_string(spec.height) +
+							"x" + std::to_string(spec.depth) + "_" + std::to_string(seed) + "_";
+
+		for (int boardIndex = 0; boardIndex < count; boardIndex++)
+		{
+			unique_ptr<BattleBoard> nextBoard = generator.generate();
+
+			if (nullptr == nextBoard)
+			{	// The spec doesn't fit the board, no point in trying again
 				Logger::getInstance().log(Severity::WARNING_LEVEL,
-										  "Battle board " + boardFilename + " is invalid");
+										  "Random battle board generation stopped after " +
+										  std::to_string(boardIndex) + " boards");
+				break;
 			}
+
+			string boardName = namePrefix + std::to_string(boardIndex);
+			addLoadedBoard(boardName, std::move(nextBoard));
 		}
 
 		return _loadedBoardNames;
 	}
 
-	shared_ptr<BattleBoard> BattleshipGameBoardFactory::requestBattleboard(const string& path)
+	shared_ptr<BattleBoard> BattleshipGameBoardFactory::requestBattleboard(const string& path, MonotonicArena* arena)
 	{
-		auto boardIt = _loadedBoards.find(path);
+		const LoadedBoard* loadedBoard = findLoadedBoard(path);
 
-		if (boardIt == _loadedBoards.end())
+		if (loadedBoard == nullptr)
 		{
 			return nullptr;
 		}
 		else
 		{
 			Logger::getInstance().log(Severity::DEBUG_LEVEL, path + " BattleBoard new instance created..");
-			return BoardBuilder::clone(*boardIt->second); // Prototype pattern
+			return BoardBuilder::clone(*loadedBoard->prototype, arena); // Prototype pattern
 		}
 	}
 
+	shared_ptr<const BoardData> BattleshipGameBoardFactory::requestPlayerView(const string& path,
+																			   PlayerEnum player) const
+	{
+		const LoadedBoard* loadedBoard = findLoadedBoard(path);
+
+		if (loadedBoard == nullptr)
+			return nullptr;
+
+		return (player == PlayerEnum::A) ? loadedBoard->playerAView : loadedBoard->playerBView;
+	}
+
+	uint64_t BattleshipGameBoardFactory::boardFingerprint(const string& path) const
+	{
+		const LoadedBoard* loadedBoard = findLoadedBoard(path);
+
+		if (loadedBoard == nullptr)
+			return 0;
+
+		return loadedBoard->fingerprint;
+	}
+
 	const vector<string>& BattleshipGameBoardFactory::availableBoardsList() const
 	{
 		return _availableBoards;
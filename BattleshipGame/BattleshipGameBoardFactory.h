@@ -3,18 +3,23 @@
 #include <memory>
 #include <unordered_map>
 #include <vector>
+#include <cstdint>
+#include <mutex>
 #include "BattleBoard.h"
+#include "BoardDataImpl.h"
+#include "RandomBoardGenerator.h"
 
 using std::shared_ptr;
 using std::unordered_map;
 using std::string;
 using std::vector;
+using std::mutex;
 
 namespace battleship
 {
 	/** 
 	 * A factory class for instantiating BattleBoard classes using various methods
-	 * (currently load from file, possibly in the future "set manually" or "random").
+	 * (load from file, or generate random boards out of a seed).
 	 */
 	class BattleshipGameBoardFactory
 	{
@@ -28,28 +33,86 @@ namespace battleship
 		/** Loads and validates all available battleboard files */
 		const vector<string>& loadAllBattleBoards();
 
+		/** Loads and validates the given board files of the path, which appeared in it after it was listed (e.g.
+		 *  while a competition runs). Files that were found before aren't loaded again, even if they were invalid.
+		 *  Returns the names of the boards that were loaded.
+		 *  Instances of the new boards may be requested right away, from any thread.
+		 */
+		vector<string> loadNewBattleBoards(const vector<string>& boardFilenames);
+
+		/** Generates "count" random boards according to the spec, and adds them as prototypes to the loaded boards.
+		 *  The same spec and seed always produce the same boards.
+		 *  Returns the updated list of boards available for creation.
+		 */
+		const vector<string>& generateRandomBattleBoards(const RandomBoardSpec& spec, int count, unsigned int seed);
+
+		/** Parses a [cols]x[rows]x[depth] dimensions string (same format as the header of a board file).
+		 *  Returns false if the string is malformed.
+		 */
+		static bool parseDimensions(string dimensions, int& rows, int& cols, int& depth);
+
 		/** Creates a BattleBoard instance using prototype pattern.
 		 *  This method assumes "path" refers a valid battleboard that was loaded before,
 		 *	as this function simply returns a new instance clone out of the template object.
 		 *  For invalid board paths, NULL is returned.
+		 *  If an arena is given, the new instance is allocated from it (see BoardBuilder::clone).
+		 */
+		shared_ptr<BattleBoard> requestBattleboard(const string& path, MonotonicArena* arena = nullptr);
+
+		/** Returns the player's view of the board in "path", as it is at the beginning of a game.
+		 *  Views are immutable and built once per board prototype, so the same view is shared by all games
+		 *  (and worker threads) played on that board. Views live as long as the factory.
+		 *  For invalid board paths, NULL is returned.
+		 */
+		shared_ptr<const BoardData> requestPlayerView(const string& path, PlayerEnum player) const;
+
+		/** Builds a BattleBoard by parsing the input board file path using a BoardBuilder helper object.
+		 *  path is an argument that specifies where board files are expected to exist on the disk.
+		 *	If the path is invalid or no board files are found, errors are printed and NULL is returned.
+		 *  The board is not added to the loaded boards.
+		 */
+		unique_ptr<BattleBoard> buildBoardFromFile(const string& path);
+
+		/** Returns a hash of the contents of the board in "path" (its dimensions and all of its squares), so boards
+		 *  with the same fingerprint are the same board regardless of their names.
+		 *  For invalid board paths, 0 is returned.
 		 */
-		shared_ptr<BattleBoard> requestBattleboard(const string& path);
+		uint64_t boardFingerprint(const string& path) const;
 
-		/** Returns list of boards available for loading (not necessarily valid) */
+		/** Returns list of boards available for loading (not necessarily valid).
+		 *  The list may change while loadNewBattleBoards runs.
+		 */
 		const vector<string>& availableBoardsList() const;
 
-		/** Returns list of boards available for creation */
+		/** Returns list of boards available for creation.
+		 *  The list may change while loadNewBattleBoards runs.
+		 */
 		const vector<string>& loadedBoardsList() const;
 
-	private:
 		/** Suffix for game board files **/
 		static const string BOARD_SUFFIX;
 
-		using LoadedBoardsIndex = unordered_map<string, unique_ptr<BattleBoard>>;
+	private:
+
+		/** A loaded board template and the players' views of it */
+		struct LoadedBoard
+		{
+			unique_ptr<BattleBoard> prototype;
+			shared_ptr<const BoardDataImpl> playerAView;
+			shared_ptr<const BoardDataImpl> playerBView;
+			uint64_t fingerprint;
+		};
+
+		using LoadedBoardsIndex = unordered_map<string, LoadedBoard>;
 
 		/** Index of loaded board templates, for creating additional instances from prototypes */
 		LoadedBoardsIndex _loadedBoards;
 
+		/** Locks the index, so boards can be loaded while worker threads request instances.
+		 *  Loaded boards are never removed or modified, so they are used without the lock once found.
+		 */
+		mutable mutex _loadedBoardsLock;
+
 		/** List of available board files for loading (not necessarily valid) */
 		vector<string> _availableBoards;
 
@@ -59,10 +122,22 @@ namespace battleship
 		/** Path to load board files from */
 		string _path;
 
+		/** Prefix for names of randomly generated boards **/
+		static const string RANDOM_BOARD_PREFIX;
+
+		/** Adds a valid board as a prototype available for creation, and builds the players' views of it */
+		void addLoadedBoard(const string& boardName, unique_ptr<BattleBoard> board);
+
+		/** Loads and validates the given board file in the path. Returns false if the board is invalid. */
+		bool loadBattleBoard(const string& boardFilename);
+
+		/** Returns the loaded board, or NULL if there's no such board */
+		const LoadedBoard* findLoadedBoard(const string& boardName) const;
+
 		/** Parse header of battleboard file.
 		 *  nextLine contains the header line, rows, cols, depth will contain the resulting dimensions parsed.
 		 */
-		bool parseHeader(string& nextLine, int& rows, int& cols, int& depth) const;
+		static bool parseHeader(string& nextLine, int& rows, int& cols, int& depth);
 
 		/** Parses a line of data from the board file.
 		 *	The line is expected to contain actual data with game pieces.
@@ -73,10 +148,5 @@ namespace battleship
 		static void parseBoardRow(BoardBuilder& builder, string& nextLine,
 						   int depthIndex, int rowIndex, int cols);
 
-		/** Builds a BattleBoard by parsing the input board file path using a BoardBuilder helper object.
-		 *  path is an argument that specifies where board files are expected to exist on the disk.
-		 *	If the path is invalid or no board files are found, errors are printed and NULL is returned.
-		 */
-		unique_ptr<BattleBoard> buildBoardFromFile(const string& path);
 	};
 }
\ No newline at end of file
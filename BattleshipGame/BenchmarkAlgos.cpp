@@ -0,0 +1,70 @@
+#include "BenchmarkAlgos.h"
+#include <algorithm>
+
+namespace battleship
+{
+	SyntheticAlgo::SyntheticAlgo() : _playerId(0), _nextTarget(0)
+	{
+	}
+
+	void SyntheticAlgo::setPlayer(int player)
+	{
+		_playerId = player;
+	}
+
+	void SyntheticAlgo::setBoard(const BoardData& board)
+	{
+		_targets.clear();
+		_targets.reserve(board.rows() * board.cols() * board.depth());
+		_nextTarget = 0;
+
+		for (int depth = 1; depth <= board.depth(); depth++)
+		{
+			for (int row = 1; row <= board.rows(); row++)
+			{
+				for (int col = 1; col <= board.cols(); col++)
+				{
+					Coordinate coord(row, col, depth);
+					if (board.charAt(coord) == static_cast<char>(BoardSquare::Empty))
+						_targets.push_back(coord);
+				}
+			}
+		}
+
+		orderTargets();
+	}
+
+	Coordinate SyntheticAlgo::attack()
+	{
+		if (_nextTarget >= _targets.size())
+			return NO_MORE_MOVES;
+
+		return _targets[_nextTarget++];
+	}
+
+	void SyntheticAlgo::notifyOnAttackResult(int player, Coordinate move, AttackResult result)
+	{
+		// Synthetic algorithms don't learn from the game
+	}
+
+	IBattleshipGameAlgo* SequentialScanAlgo::create()
+	{
+		return new SequentialScanAlgo();
+	}
+
+	void SequentialScanAlgo::orderTargets()
+	{
+		// Targets are already collected in scan order
+	}
+
+	IBattleshipGameAlgo* RandomShotAlgo::create()
+	{
+		return new RandomShotAlgo();
+	}
+
+	void RandomShotAlgo::orderTargets()
+	{
+		mt19937 randomEngine(BASE_SEED + _playerId);
+		std::shuffle(_targets.begin(), _targets.end(), randomEngine);
+	}
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <vector>
+#include <random>
+#include "IBattleshipGameAlgo.h"
+#include "AlgoCommon.h"
+
+using std::vector;
+using std::mt19937;
+
+namespace battleship
+{
+	/** Base for the synthetic algorithms used by the benchmarks.
+	 *  Synthetic algorithms are deterministic and cheap, so a benchmark measures the game engine and
+	 *  the scheduler rather than the players. They never attack their own ships.
+	 */
+	class SyntheticAlgo : public IBattleshipGameAlgo
+	{
+	public:
+		SyntheticAlgo();
+		virtual ~SyntheticAlgo() = default;
+
+		SyntheticAlgo(SyntheticAlgo const&) = delete;	// Disable copying
+		SyntheticAlgo& operator=(SyntheticAlgo const&) = delete;	// Disable copying (assignment)
+
+		void setPlayer(int player) override;
+
+		void setBoard(const BoardData& board) override;
+
+		Coordinate attack() override;
+
+		void notifyOnAttackResult(int player, Coordinate move, AttackResult result) override;
+
+	protected:
+		int _playerId;
+
+		/** Squares to attack, in attack order (1-based coordinates) */
+		vector<Coordinate> _targets;
+
+		/** Decides the attack order of the targets, called on each new board */
+		virtual void orderTargets() = 0;
+
+	private:
+		/** Index of the next target to attack */
+		size_t _nextTarget;
+	};
+
+	/** Attacks all the squares that aren't its own, level by level and row by row */
+	class SequentialScanAlgo : public SyntheticAlgo
+	{
+	public:
+		/** Creates a new instance, in the form expected by AlgoLoader */
+		static IBattleshipGameAlgo* create();
+
+	protected:
+		void orderTargets() override;
+	};
+
+	/** Attacks all the squares that aren't its own in a random order, seeded by the player id so each game
+	 *  is reproducible.
+	 */
+	class RandomShotAlgo : public SyntheticAlgo
+	{
+	public:
+		/** Creates a new instance, in the form expected by AlgoLoader */
+		static IBattleshipGameAlgo* create();
+
+	protected:
+		void orderTargets() override;
+
+	private:
+		/** Base seed of the attack order */
+		static constexpr unsigned int BASE_SEED = 2017;
+	};
+}
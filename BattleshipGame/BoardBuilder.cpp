@@ -507,13 +507,31 @@ namespace battleship
 
 		printErrors(errorQueue);
 
-		return validBoard ? std::move(board) : NULL;
+		if (!validBoard)
+			return NULL;
+
+		// Build the players' views once, all boards cloned from this one share them
+		board->buildPlayerSquares();
+		return board;
 	}
 
-	shared_ptr<BattleBoard> BoardBuilder::clone(const BattleBoard& prototype)
+	shared_ptr<BattleBoard> BoardBuilder::clone(const BattleBoard& prototype, MonotonicArena* arena)
 	{
 		// Only BoardBuilder can instantiate this class - so we must create without make_shared macro
-		shared_ptr<BattleBoard> board(new BattleBoard(prototype)); // Invoke copy constructor
-		return board;
+		if (arena == nullptr)
+		{
+			shared_ptr<BattleBoard> board(new BattleBoard(prototype)); // Invoke copy constructor
+			return board;
+		}
+
+		// The board, its shared_ptr control block and its game pieces all go to the arena.
+		// The arena's memory is reclaimed at once, so the deleter only destroys the board.
+		void* boardMemory = arena->allocate(sizeof(BattleBoard), alignof(BattleBoard));
+		BattleBoard* board = new (boardMemory) BattleBoard(prototype, arena);
+		return shared_ptr<BattleBoard>(board, [arena](BattleBoard* arenaBoard)
+		{
+			arenaBoard->~BattleBoard();
+			arena->deallocate(arenaBoard, sizeof(BattleBoard));
+		}, ArenaAllocator<BattleBoard>(arena));
 	}
 }
\ No newline at end of file
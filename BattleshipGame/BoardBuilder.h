@@ -101,8 +101,10 @@ namespace battleship
 
 		/** Creates a new instance of the battle board out of the given prototype.
 		 *  Boards will be identical in data, but will not share the same game pieces.
+		 *  If an arena is given, the board and all of its game pieces are allocated from it: the board must be
+		 *  destroyed before the arena is released.
 		 */
-		static shared_ptr<BattleBoard> clone(const BattleBoard& prototype);
+		static shared_ptr<BattleBoard> clone(const BattleBoard& prototype, MonotonicArena* arena = nullptr);
 
 	private:
 		/** A helper class for validating the legal formation of game-pieces on the board. */
@@ -7,39 +7,28 @@ using std::invalid_argument;
 
 namespace battleship
 {
-	BoardDataImpl::BoardDataImpl(PlayerEnum player, shared_ptr<BattleBoard> board):
+	BoardDataImpl::BoardDataImpl(PlayerEnum player, const BattleBoard& board):
 		BoardData(),
-		_player(player),
-		_board(board)
+		_squares(board.playerSquares(player))
 	{
-		_rows = board->height();
-		_cols = board->width();
-		_depth = board->depth();
+		_rows = board.height();
+		_cols = board.width();
+		_depth = board.depth();
 	}
 
 	char BoardDataImpl::charAt(Coordinate c) const
 	{
-		c.row -= 1;
-		c.col -= 1;
-		c.depth -= 1;
-		auto gamePiece = _board->pieceAt(c);
-		
-		if (gamePiece == nullptr)
+		if ((c.row < 1) || (c.col < 1) || (c.depth < 1) ||
+			(c.row > _rows) || (c.col > _cols) || (c.depth > _depth))
 		{
-			return static_cast<char>(BoardSquare::Empty); // Empty square
+			return static_cast<char>(BoardSquare::Empty); // Out of the board
 		}
-		else if (gamePiece->_player != _player)
-		{
-			return static_cast<char>(BoardSquare::Empty); // Enemy piece
-		}
-		else
-		{
-			char piece = static_cast<char>(gamePiece->_shipType->_representation);
 
-			if (_player == PlayerEnum::B)
-				piece = std::tolower(piece);
+		return (*_squares)[snapshotIndex(*this, c)];
+	}
 
-			return piece; // Friendly ship
-		}
+	const char* BoardDataImpl::squares() const
+	{
+		return _squares->data();
 	}
 }
\ No newline at end of file
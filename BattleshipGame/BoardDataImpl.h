@@ -11,22 +11,31 @@ namespace battleship
 {
 	class BattleBoard;
 
-	/** A player's view of the given wrapped battleboard.
-	 *	The inner battleboard is immutable to this class.
+	/** A player's view of the given wrapped battleboard, as it is at the beginning of the game.
+	 *	The view is served from the board's flat player snapshot, which is also exposed to algorithms
+	 *  as a contiguous buffer (BoardSnapshot).
 	 */
-	class BoardDataImpl : public BoardData
+	class BoardDataImpl : public BoardData, public BoardSnapshot
 	{
 	public:
-		/** Construct view of the board from given player point of view */
-		BoardDataImpl(PlayerEnum player, shared_ptr<BattleBoard> board);
+		/** Construct view of the board from given player point of view.
+		 *  The view doesn't keep the board alive, only the board's (immutable) player snapshot.
+		 */
+		BoardDataImpl(PlayerEnum player, const BattleBoard& board);
 		virtual ~BoardDataImpl() = default;
 
+		BoardDataImpl(BoardDataImpl const&) = delete;	// Disable copying
+		BoardDataImpl& operator=(BoardDataImpl const&) = delete;	// Disable copying (assignment)
+
 		// Returns only selected players' chars.
 		// Coordinates are defined in the range [1, BOARD_SIZE].
 		virtual char charAt(Coordinate c) const override;
 
+		// Returns the player's squares as a contiguous buffer (see BoardSnapshot)
+		virtual const char* squares() const override;
+
 	private:
-		PlayerEnum _player;
-		shared_ptr<BattleBoard> _board;
+		// The player's squares snapshot, shared with the board prototype
+		shared_ptr<const vector<char>> _squares;
 	};
 }
\ No newline at end of file
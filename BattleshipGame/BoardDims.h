@@ -0,0 +1,77 @@
+#pragma once
+
+#include "AlgoCommon.h"
+
+#pragma region Board dimensions
+
+/** Dimensions of a board shape known at compile time.
+ *  Kernels templated on the dimensions type get the board's index math, bounds checks and loop trip counts as
+ *  constants when instantiated with StaticBoardDims, and the generic code when instantiated with DynamicBoardDims.
+ *  Both types have the same interface.
+ */
+template <int Rows, int Cols, int Depth>
+struct StaticBoardDims
+{
+	int rows() const { return Rows; }
+	int cols() const { return Cols; }
+	int depth() const { return Depth; }
+
+	/** Index of square c (in the range [1, BOARD_SIZE]) within a flat board buffer, same as snapshotIndex */
+	int squareIndex(const Coordinate& c) const
+	{
+		return ((c.depth - 1) * Rows + (c.row - 1)) * Cols + (c.col - 1);
+	}
+
+	/** Returns true if move (in the range [1, BOARD_SIZE]) is within the board, same as AttackValidator */
+	bool isOnBoard(const Coordinate& move) const
+	{
+		return (move.row >= 1) && (move.col >= 1) && (move.depth >= 1) &&
+			   (move.row <= Rows) && (move.col <= Cols) && (move.depth <= Depth);
+	}
+};
+
+/** Dimensions of a board shape known at runtime only (the generic path of the dimension templated kernels) */
+struct DynamicBoardDims
+{
+	DynamicBoardDims(int rows, int cols, int depth) : _rows(rows), _cols(cols), _depth(depth) {}
+
+	int rows() const { return _rows; }
+	int cols() const { return _cols; }
+	int depth() const { return _depth; }
+
+	int squareIndex(const Coordinate& c) const
+	{
+		return ((c.depth - 1) * _rows + (c.row - 1)) * _cols + (c.col - 1);
+	}
+
+	bool isOnBoard(const Coordinate& move) const
+	{
+		return (move.row >= 1) && (move.col >= 1) && (move.depth >= 1) &&
+			   (move.row <= _rows) && (move.col <= _cols) && (move.depth <= _depth);
+	}
+
+private:
+	int _rows;
+	int _cols;
+	int _depth;
+};
+
+/** Calls func with the dimensions of a rows x cols x depth board: a StaticBoardDims for the common board shapes
+ *  (the ones of the test boards - 10x10x1, 10x10x6 and 15x15x15), and DynamicBoardDims for any other shape.
+ *  func is called with every dimensions type, so all of its instantiations must return the same type.
+ *  Dispatch costs a few comparisons, so it's meant to be done once per kernel call (e.g. per move) or per game.
+ */
+template <typename Func>
+auto dispatchBoardDims(int rows, int cols, int depth, Func&& func) -> decltype(func(DynamicBoardDims(rows, cols, depth)))
+{
+	if ((rows == 10) && (cols == 10) && (depth == 1))
+		return func(StaticBoardDims<10, 10, 1>());
+	if ((rows == 10) && (cols == 10) && (depth == 6))
+		return func(StaticBoardDims<10, 10, 6>());
+	if ((rows == 15) && (cols == 15) && (depth == 15))
+		return func(StaticBoardDims<15, 15, 15>());
+
+	return func(DynamicBoardDims(rows, cols, depth));
+}
+
+#pragma endregion
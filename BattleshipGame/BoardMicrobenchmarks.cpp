@@ -0,0 +1,232 @@
+#include "BoardMicrobenchmarks.h"
+#include "BoardBuilder.h"
+#include "BoardDataImpl.h"
+#include <algorithm>
+#include <cctype>
+
+using std::max;
+
+namespace battleship
+{
+	vector<pair<Coordinate, char>> BoardMicrobenchmarks::shipSquares(const BattleBoard& board)
+	{
+		vector<pair<Coordinate, char>> squares;
+
+		for (int depth = 0; depth < board.depth(); depth++)
+		{
+			for (int row = 0; row < board.height(); row++)
+			{
+				for (int col = 0; col < board.width(); col++)
+				{
+					Coordinate coord(row, col, depth);
+					auto piece = board.pieceAt(coord);
+					if (piece == nullptr)
+						continue;
+
+					char square = static_cast<char>(piece->_shipType->_representation);
+					if (piece->_player == PlayerEnum::B)
+						square = static_cast<char>(tolower(square));
+
+					squares.push_back(std::make_pair(coord, square));
+				}
+			}
+		}
+
+		return squares;
+	}
+
+	void BoardMicrobenchmarks::findShips(const BattleBoard& board, vector<Coordinate>& smallestShip,
+										 vector<Coordinate>& biggestShip)
+	{
+		smallestShip.clear();
+		biggestShip.clear();
+		const GamePiece* smallestPiece = nullptr;
+		const GamePiece* biggestPiece = nullptr;
+
+		for (const auto& square : shipSquares(board))
+		{
+			auto piece = board.pieceAt(square.first);
+			if (piece->_player != PlayerEnum::A)
+				continue;
+
+			if ((smallestPiece == nullptr) || (piece->_shipType->_size < smallestPiece->_shipType->_size))
+				smallestPiece = piece.get();
+			if ((biggestPiece == nullptr) || (piece->_shipType->_size > biggestPiece->_shipType->_size))
+				biggestPiece = piece.get();
+		}
+
+		// Collect the squares of each chosen ship (all of its squares map to the same game piece)
+		for (const auto& square : shipSquares(board))
+		{
+			auto piece = board.pieceAt(square.first).get();
+			if (piece == smallestPiece)
+				smallestShip.push_back(square.first);
+			if (piece == biggestPiece)
+				biggestShip.push_back(square.first);
+		}
+	}
+
+	Coordinate BoardMicrobenchmarks::findEmptySquare(const BattleBoard& board)
+	{
+		for (int depth = 0; depth < board.depth(); depth++)
+			for (int row = 0; row < board.height(); row++)
+				for (int col = 0; col < board.width(); col++)
+					if (board.pieceAt(Coordinate(row, col, depth)) == nullptr)
+						return Coordinate(row, col, depth);
+
+		return NO_MORE_MOVES;
+	}
+
+	void BoardMicrobenchmarks::addBenchmarks(MicroBenchmarkRunner& runner, const string& boardName,
+											 shared_ptr<const BattleBoard> prototype,
+											 shared_ptr<BattleshipGameBoardFactory> factory, const string& boardFile)
+	{
+		const long long volume = static_cast<long long>(prototype->width()) * prototype->height() * prototype->depth();
+		const long long wholeBoardIterations = max(10LL, WHOLE_BOARD_SQUARES_BUDGET / volume);
+
+		vector<Coordinate> smallestShip;
+		vector<Coordinate> biggestShip;
+		findShips(*prototype, smallestShip, biggestShip);
+		Coordinate emptySquare = findEmptySquare(*prototype);
+
+		// executeAttack - miss: doesn't change the board, so the same board is attacked over and over
+		if (!(emptySquare == NO_MORE_MOVES))
+		{
+			runner.add("BattleBoard::executeAttack/miss/" + boardName, MISS_ITERATIONS,
+					   [prototype, emptySquare](MicroBenchmarkState& state)
+			{
+				state.pauseTiming();
+				auto board = BoardBuilder::clone(*prototype);
+				state.resumeTiming();
+
+				for (long long i = 0; i < state.iterations(); i++)
+					state.consume(board->executeAttack(emptySquare) == nullptr);
+			});
+		}
+
+		// executeAttack - first hit on a ship, each hit is made on a fresh board
+		if (biggestShip.size() > 1)
+		{
+			Coordinate hitSquare = biggestShip.front();
+			runner.add("BattleBoard::executeAttack/hit/" + boardName, HIT_ITERATIONS,
+					   [prototype, hitSquare](MicroBenchmarkState& state)
+			{
+				vector<shared_ptr<BattleBoard>> boards;
+				for (long long done = 0; done < state.iterations(); done += boards.size())
+				{
+					state.pauseTiming();
+					boards.clear();
+					for (long long i = done; (i < state.iterations()) && (boards.size() < BOARDS_BATCH_SIZE); i++)
+						boards.push_back(BoardBuilder::clone(*prototype));
+					state.resumeTiming();
+
+					for (auto& board : boards)
+						state.consume(board->executeAttack(hitSquare)->_lifeLeft);
+				}
+
+				state.pauseTiming();
+				boards.clear(); // Don't measure the boards destruction
+			});
+		}
+
+		// executeAttack - the attack that sinks a ship, on boards where the rest of the ship was already hit
+		if (!smallestShip.empty())
+		{
+			runner.add("BattleBoard::executeAttack/sink/" + boardName, SINK_ITERATIONS,
+					   [prototype, smallestShip](MicroBenchmarkState& state)
+			{
+				vector<shared_ptr<BattleBoard>> boards;
+				for (long long done = 0; done < state.iterations(); done += boards.size())
+				{
+					state.pauseTiming();
+					boards.clear();
+					for (long long i = done; (i < state.iterations()) && (boards.size() < BOARDS_BATCH_SIZE); i++)
+					{
+						auto board = BoardBuilder::clone(*prototype);
+						for (size_t square = 0; square + 1 < smallestShip.size(); square++)
+							board->executeAttack(smallestShip[square]);
+						boards.push_back(board);
+					}
+					state.resumeTiming();
+
+					for (auto& board : boards)
+						state.consume(board->executeAttack(smallestShip.back())->_lifeLeft);
+				}
+
+				state.pauseTiming();
+				boards.clear(); // Don't measure the boards destruction
+			});
+		}
+
+		// BoardBuilder::clone - creating a game board out of the prototype (including its destruction)
+		runner.add("BoardBuilder::clone/" + boardName, wholeBoardIterations,
+				   [prototype](MicroBenchmarkState& state)
+		{
+			for (long long i = 0; i < state.iterations(); i++)
+				state.consume(BoardBuilder::clone(*prototype)->getPlayerAShipCount());
+		});
+
+		// BoardDataImpl::charAt - scanning the player's view square by square, as algorithms do in setBoard
+		runner.add("BoardDataImpl::charAt/" + boardName, CHAR_AT_ITERATIONS,
+				   [prototype](MicroBenchmarkState& state)
+		{
+			BoardDataImpl view(PlayerEnum::A, *prototype);
+
+			int row = 1;
+			int col = 1;
+			int depth = 1;
+			for (long long i = 0; i < state.iterations(); i++)
+			{
+				state.consume(view.charAt(Coordinate(row, col, depth)));
+
+				// Advance to the next square, wrapping around at the end of the board
+				if (++col > view.cols())
+				{
+					col = 1;
+					if (++row > view.rows())
+					{
+						row = 1;
+						if (++depth > view.depth())
+							depth = 1;
+					}
+				}
+			}
+		});
+
+		// BoardBuilder::build - validation and game pieces creation, the squares are added untimed
+		vector<pair<Coordinate, char>> squares = shipSquares(*prototype);
+		int width = prototype->width();
+		int height = prototype->height();
+		int depth = prototype->depth();
+		runner.add("BoardBuilder::build/" + boardName, wholeBoardIterations,
+				   [squares, width, height, depth](MicroBenchmarkState& state)
+		{
+			for (long long i = 0; i < state.iterations(); i++)
+			{
+				state.pauseTiming();
+				BoardBuilder builder(width, height, depth);
+				for (const auto& square : squares)
+					builder.addPiece(square.first, square.second);
+				state.resumeTiming();
+
+				auto board = builder.build();
+				state.consume(board != nullptr);
+
+				state.pauseTiming();
+				board.reset();
+				state.resumeTiming();
+			}
+		});
+
+		// BattleshipGameBoardFactory::buildBoardFromFile - reading, parsing and building a board file
+		if (!boardFile.empty())
+		{
+			runner.add("BattleshipGameBoardFactory::buildBoardFromFile/" + boardName, wholeBoardIterations,
+					   [factory, boardFile](MicroBenchmarkState& state)
+			{
+				for (long long i = 0; i < state.iterations(); i++)
+					state.consume(factory->buildBoardFromFile(boardFile) != nullptr);
+			});
+		}
+	}
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+#include "MicroBenchmark.h"
+#include "BattleBoard.h"
+#include "BattleshipGameBoardFactory.h"
+
+using std::shared_ptr;
+using std::string;
+using std::vector;
+using std::pair;
+
+namespace battleship
+{
+	/** Microbenchmarks of the board hot paths: attacks, cloning, player views, validation and parsing.
+	 *  Iteration counts are derived from the board volume only, so they are stable between runs.
+	 */
+	class BoardMicrobenchmarks
+	{
+	public:
+		virtual ~BoardMicrobenchmarks() = delete; // This class shouldn't be instantiated (or destroyed)
+
+		/** Adds the benchmarks of the given board prototype to the runner.
+		 *  If boardFile isn't empty, the board file parsing benchmark is added as well (using the factory).
+		 */
+		static void addBenchmarks(MicroBenchmarkRunner& runner, const string& boardName,
+								  shared_ptr<const BattleBoard> prototype,
+								  shared_ptr<BattleshipGameBoardFactory> factory, const string& boardFile);
+
+	private:
+		/** Hide the ctor - this class shouldn't be instantiated */
+		BoardMicrobenchmarks() = default;
+
+		/** Number of board clones prepared at a time for benchmarks that consume a fresh board per operation */
+		static constexpr int BOARDS_BATCH_SIZE = 256;
+
+		/** Fixed iteration counts of the cheap operations */
+		static constexpr long long MISS_ITERATIONS = 1000000;
+		static constexpr long long HIT_ITERATIONS = 100000;
+		static constexpr long long SINK_ITERATIONS = 100000;
+		static constexpr long long CHAR_AT_ITERATIONS = 2000000;
+
+		/** Board squares processed by each of the whole-board benchmarks (clone, build, parse).
+		 *  Their iteration count is the budget divided by the board volume.
+		 */
+		static constexpr long long WHOLE_BOARD_SQUARES_BUDGET = 20000000;
+
+		/** Returns the ship squares of the board, as they would appear in a board file */
+		static vector<pair<Coordinate, char>> shipSquares(const BattleBoard& board);
+
+		/** Returns the squares of the smallest and the biggest ship of player A on the board */
+		static void findShips(const BattleBoard& board, vector<Coordinate>& smallestShip, vector<Coordinate>& biggestShip);
+
+		/** Returns the first empty square on the board, or NO_MORE_MOVES for a full board */
+		static Coordinate findEmptySquare(const BattleBoard& board);
+	};
+}
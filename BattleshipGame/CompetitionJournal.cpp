@@ -0,0 +1,93 @@
+#include "CompetitionJournal.h"
+#include "IOUtil.h"
+#include "Logger.h"
+#include <fstream>
+#include <functional>
+#include <cstdio>
+
+using std::ifstream;
+using std::ofstream;
+using std::to_string;
+
+namespace battleship
+{
+	CompetitionJournal::CompetitionJournal(const string& path, const vector<string>& players,
+										   const vector<string>& boards) :
+		_filename(path + "\\" + JOURNAL_FILE)
+	{
+		// The header identifies the competition by its players and boards (in their competition order, since task ids
+		// depend on it). A hash keeps the header short for big competitions.
+		string competitionDesc;
+		for (const auto& player : players)
+			competitionDesc += player + "\n";
+		competitionDesc += "\n";
+		for (const auto& board : boards)
+			competitionDesc += board + "\n";
+
+		_header = JOURNAL_HEADER_PREFIX + to_string(players.size()) + "x" + to_string(boards.size()) + "_" +
+				  to_string(std::hash<string>()(competitionDesc));
+	}
+
+	string CompetitionJournal::readHeader() const
+	{
+		string existingHeader;
+		{
+			ifstream journalFile(_filename);
+			if (journalFile.good())
+				std::getline(journalFile, existingHeader);
+		}
+
+		IOUtil::removeLeadingTrailingSpaces(existingHeader);
+		return existingHeader;
+	}
+
+	vector<GameRecord> CompetitionJournal::readCompletedGames() const
+	{
+		if (readHeader() != _header)
+			return vector<GameRecord>();
+
+		return GameRecord::readAll(_filename);
+	}
+
+	vector<GameRecord> CompetitionJournal::loadCompletedGames()
+	{
+		string existingHeader = readHeader();
+
+		if (existingHeader == _header)
+		{
+			auto records = GameRecord::readAll(_filename);
+			Logger::getInstance().log(Severity::INFO_LEVEL,
+									  "Found competition journal with " + to_string(records.size()) + " completed games");
+			return records;
+		}
+
+		if (!existingHeader.empty())
+		{
+			Logger::getInstance().log(Severity::WARNING_LEVEL,
+									  "Competition journal " + _filename + " belongs to a different competition, discarding it");
+		}
+
+		// Start a new journal for this competition
+		ofstream journalFile(_filename, std::ofstream::out | std::ofstream::trunc);
+		if (journalFile.is_open())
+		{
+			journalFile << _header << std::endl;
+		}
+		else
+		{
+			Logger::getInstance().log(Severity::ERROR_LEVEL, "Failed to create competition journal " + _filename);
+		}
+
+		return vector<GameRecord>();
+	}
+
+	void CompetitionJournal::discard()
+	{
+		std::remove(_filename.c_str());
+	}
+
+	const string& CompetitionJournal::filename() const
+	{
+		return _filename;
+	}
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include "GameRecord.h"
+
+using std::string;
+using std::vector;
+
+namespace battleship
+{
+	/** Append-only journal of the games completed in a competition, used to resume a competition after a crash.
+	 *  The journal starts with a header line that identifies the competition (players and boards), followed by a
+	 *  game record per completed game. Every record is flushed when written, so checkpointing costs a single line
+	 *  per game, and the player statistics are rebuilt on resume by feeding the records back to the scoreboard.
+	 */
+	class CompetitionJournal
+	{
+	public:
+		/** Creates the journal of the competition between the given players on the given boards,
+		 *  located in path.
+		 */
+		CompetitionJournal(const string& path, const vector<string>& players, const vector<string>& boards);
+		virtual ~CompetitionJournal() = default;
+
+		CompetitionJournal(CompetitionJournal const&) = delete;	// Disable copying
+		CompetitionJournal& operator=(CompetitionJournal const&) = delete;	// Disable copying (assignment)
+
+		/** Returns the records of the games completed by previous runs of this same competition.
+		 *  A journal left by a different competition (or a corrupted one) is discarded and a new journal is started.
+		 */
+		vector<GameRecord> loadCompletedGames();
+
+		/** Same as loadCompletedGames, but never writes to the journal: a journal of a different competition is
+		 *  ignored (e.g. in shard processes, which only read the journal of their coordinator).
+		 */
+		vector<GameRecord> readCompletedGames() const;
+
+		/** Deletes the journal, to be called once the competition is over */
+		void discard();
+
+		/** Full name of the journal file, game records should be appended to it */
+		const string& filename() const;
+
+	private:
+		/** Journal file name */
+		static constexpr auto JOURNAL_FILE = "competition.journal";
+
+		/** Beginning of the journal header line (a comment line for GameRecord readers) */
+		static constexpr auto JOURNAL_HEADER_PREFIX = "#competition ";
+
+		string _filename;
+
+		// Header line that identifies the competition
+		string _header;
+
+		/** Returns the header line of the existing journal, or an empty string if there's none */
+		string readHeader() const;
+	};
+}
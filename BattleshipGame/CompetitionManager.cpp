@@ -1,5 +1,6 @@
 #include "CompetitionManager.h"
 #include "Logger.h"
+#include "AllocationCounter.h"
 #include <string>
 #include <algorithm>
 
@@ -7,65 +8,329 @@ using std::lock_guard;
 using std::to_string;
 using std::min;
 using std::max;
+using std::chrono::steady_clock;
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
 
 namespace battleship
 {
 	void CompetitionManager::prepareCompetition(shared_ptr<BattleshipGameBoardFactory> boardLoader,
 												shared_ptr<AlgoLoader> algoLoader)
 	{
-		auto boards = boardLoader->loadedBoardsList(); // Valid boards
-		auto algos = algoLoader->loadedGameAlgos(); // Valid loaded algorithms
+		const auto& boards = boardLoader->loadedBoardsList(); // Valid boards
+		const auto& algos = algoLoader->loadedGameAlgos(); // Valid loaded algorithms
 
-		// Total games for each player: play twice against each player other player on each board
-		auto totalRounds = (algos.size() - 1) * 2 * boards.size();
+		// Deal the biggest boards first: their games are the longest, and if they were played last they would leave
+		// most threads idle while they finish (Longest Processing Time first)
+		vector<size_t> boardsOrder(boards.size());
+		vector<int> boardsVolume(boards.size(), 0);
+		GameCostModel costModel;
+		for (size_t board = 0; board < boards.size(); board++)
+		{
+			boardsOrder[board] = board;
+
+			auto boardView = boardLoader->requestPlayerView(boards[board], PlayerEnum::A);
+			if (boardView != nullptr)
+				boardsVolume[board] = boardView->rows() * boardView->cols() * boardView->depth();
+			costModel.setBoardVolume(boards[board], boardsVolume[board]);
+		}
+		std::stable_sort(boardsOrder.begin(), boardsOrder.end(), [&boardsVolume](size_t board1, size_t board2)
+		{
+			return boardsVolume[board1] > boardsVolume[board2];
+		});
+
+		// Games are derived from the scheduler when the worker threads ask for them, none are created in advance
+		switch (_format)
+		{
+		case TournamentFormat::SWISS:
+			_scoreboard = std::make_unique<Scoreboard>(algos, SwissScheduler::roundsCount(algos.size()), false);
+			_scheduler = std::make_unique<SwissScheduler>(algos, boards, std::move(boardsOrder), *_scoreboard);
+			break;
+		case TournamentFormat::SINGLE_ELIMINATION:
+		case TournamentFormat::DOUBLE_ELIMINATION:
+		{
+			int maxLosses = (_format == TournamentFormat::SINGLE_ELIMINATION) ? 1 : 2;
+			_scoreboard = std::make_unique<Scoreboard>(algos, EliminationScheduler::roundsCount(algos.size(), maxLosses),
+													   false);
+			_scheduler = std::make_unique<EliminationScheduler>(algos, boards, std::move(boardsOrder), *_scoreboard,
+																maxLosses);
+			break;
+		}
+		default:
+		{
+			// The round robin cursor refines the order of the boards as their games are played
+			auto gamesCursor = std::make_unique<GameTaskCursor>(algos, boards, std::move(costModel), _shard);
+			_roundRobinCursor = gamesCursor.get();
+			_players = algos;
+			_boards = boards;
+			_nextEntrantTaskId = _roundRobinCursor->gamesCount();
+
+			// Dealing the cursor's games doesn't take the scheduler's lock, only the games of added entrants do
+			auto scheduler = std::make_unique<AppendableScheduler>(std::move(gamesCursor));
+			_roundRobinScheduler = scheduler.get();
+			_scheduler = std::move(scheduler);
+
+			// Reset scoreboard (casting totalRounds to int is safe since we don't expect that many games)
+			_scoreboard = std::make_unique<Scoreboard>(algos, static_cast<int>(_roundRobinCursor->roundsCount()));
+			break;
+		}
+		}
+	}
+
+	CompetitionManager::CompetitionManager(shared_ptr<BattleshipGameBoardFactory> boardLoader,
+										   shared_ptr<AlgoLoader> algoLoader,
+										   int threadCount,
+										   CompetitionShard shard,
+										   TournamentFormat format):
+										   _format(format),
+										   _roundRobinCursor(nullptr),
+										   _roundRobinScheduler(nullptr),
+										   _nextEntrantTaskId(0),
+										   _boardLoader(boardLoader),
+										   _algoLoader(algoLoader),
+										   _threadCount(threadCount > 0 ? threadCount : 0),
+										   _workerThreadsCount(0),
+										   _helperThreadsPerWorker(0),
+										   _parallelScanMinSquares(LayerTaskPool::DEFAULT_MIN_PARALLEL_SQUARES),
+										   _shard(shard),
+										   _algoPoolCapacity(WorkerThreadResourcePool::UNLIMITED_ALGO_POOL),
+										   _statsIntervalMillis(0)
+	{
+		// Prepare the dealing of all possible games in competition
+		prepareCompetition(boardLoader, algoLoader);
+	}
+
+	Scoreboard& CompetitionManager::scoreboard()
+	{
+		return *_scoreboard;
+	}
+
+	void CompetitionManager::setResultsOutput(const string& filename, bool isAppend)
+	{
+		_resultsWriter = std::make_unique<GameRecordWriter>(filename, isAppend);
+	}
+
+	void CompetitionManager::setResultsCache(const string& path, unsigned int seed, int verifyInterval, bool isReadOnly)
+	{
+		_resultsCache = std::make_unique<ResultsCache>(path, *_algoLoader, *_boardLoader, seed, verifyInterval,
+													   isReadOnly);
+	}
+
+	void CompetitionManager::setAlgoPoolCapacity(size_t algoPoolCapacity)
+	{
+		_algoPoolCapacity = algoPoolCapacity;
+	}
 
-		// Reset scoreboard (casting totalRounds to int is safe since we don't expect that many games)
-		_scoreboard = std::make_unique<Scoreboard>(algos, static_cast<int>(totalRounds));
-		
-		// Iterate all boards and players and create SingleGameTask for each valid combination
-		queue<unique_ptr<SingleGameTask>> inversedGamesSet;
-		size_t numOfAlgos = algos.size() - 1;
-		for (const auto& board : boards)
+	void CompetitionManager::setParallelScanMinSquares(int minSquares)
+	{
+		_parallelScanMinSquares = minSquares;
+	}
+
+	void CompetitionManager::setStatsOutput(const string& filename, int intervalMillis)
+	{
+		_statsFilename = filename;
+		_statsIntervalMillis = intervalMillis;
+	}
+
+	const unordered_map<string, AlgoPoolStats>& CompetitionManager::algoPoolStats() const
+	{
+		return _algoPoolStats;
+	}
+
+	const unordered_map<string, AlgoCallLatencies>& CompetitionManager::algoLatencies() const
+	{
+		return _algoLatencies;
+	}
+
+	void CompetitionManager::logAlgoPoolStats() const
+	{
+		for (const auto& algoStatsEntry : _algoPoolStats)
 		{
-			// Each round is a diagonal in the game matrix (without the main diagonal),
-			// and we run over it from both sides in order to get a balanced tournament 
-			for (size_t round = 1; round <= numOfAlgos; ++round)
+			const AlgoPoolStats& stats = algoStatsEntry.second;
+			long long averageCreationMicros = (stats.instancesCreated > 0) ?
+											  (stats.creationMicros / static_cast<long long>(stats.instancesCreated)) : 0;
+
+			Logger::getInstance().log(Severity::INFO_LEVEL,
+									  "Algorithm " + algoStatsEntry.first + " instances: " +
+									  to_string(stats.instancesCreated) + " created (" +
+									  to_string(averageCreationMicros) + " us on average), " +
+									  to_string(stats.instancesReused) + " reused, " +
+									  to_string(stats.instancesEvicted) + " evicted");
+		}
+	}
+
+	void CompetitionManager::mergeCompletedGames(const vector<GameRecord>& records, bool isRecordMerged)
+	{
+		if (_roundRobinCursor == nullptr)
+		{
+			Logger::getInstance().log(Severity::WARNING_LEVEL,
+									  "Games played elsewhere can only be merged into a round robin competition, " +
+									  to_string(records.size()) + " game records ignored.");
+			return;
+		}
+
+		// Apply the records in competition order, so the scoreboard sees the games in the same order it would have
+		// if they were played here. Games without a record stay pending.
+		vector<const GameRecord*> sortedRecords;
+		sortedRecords.reserve(records.size());
+		for (const auto& record : records)
+			sortedRecords.push_back(&record);
+
+		std::stable_sort(sortedRecords.begin(), sortedRecords.end(),
+						 [](const GameRecord* record1, const GameRecord* record2)
+		{
+			return record1->taskId < record2->taskId;
+		});
+
+		size_t mergedGamesCount = 0;
+		for (const GameRecord* record : sortedRecords)
+		{
+			if (!_roundRobinCursor->isPending(record->taskId))
+				continue;
+
+			auto task = _roundRobinCursor->task(record->taskId);
+			if ((record->playerAName == task->playerAName()) &&
+				(record->playerBName == task->playerBName()) &&
+				(record->boardName == task->boardName()))
 			{
-				for (size_t algo1 = 0, algo2 = round; ((algo1 <= (numOfAlgos - algo2)) && (algo2 <= numOfAlgos)); ++algo1, ++algo2)
+				_scoreboard->updateWithGameResults(record->results, task->playerAName(),
+												   task->playerBName(), task->boardName());
+				_roundRobinCursor->markCompleted(record->taskId);
+				mergedGamesCount++;
+
+				// Shards only read the cache, the games they played are cached once merged
+				if (_resultsCache != nullptr)
 				{
-					_gamesSet.push(std::make_unique<SingleGameTask>(algos[algo1], algos[algo2], board));
-					inversedGamesSet.push(std::make_unique<SingleGameTask>(algos[algo2], algos[algo1], board));
-					if (algo1 != (numOfAlgos - algo2))	// On the secondary diagonal 'algo1' and 'numOfAlgos-algo2' indices meet
-														// and we don't want to add them twice
-					{
-						_gamesSet.push(std::make_unique<SingleGameTask>(algos[numOfAlgos-algo2], algos[numOfAlgos-algo1], board));
-						inversedGamesSet.push(std::make_unique<SingleGameTask>(algos[numOfAlgos-algo1], algos[numOfAlgos-algo2], board));
-					}
+					_resultsCache->store(task->playerAName(), task->playerBName(), task->boardName(),
+										 record->results);
 				}
+
+				if (isRecordMerged && (_resultsWriter != nullptr))
+					_resultsWriter->write(*record);
 			}
 		}
 
-		// Move inversed games to the main queue
-		while (!inversedGamesSet.empty())
+		Logger::getInstance().log(Severity::INFO_LEVEL,
+								  "Merged results of " + to_string(mergedGamesCount) + " games played elsewhere, " +
+								  to_string(_roundRobinCursor->pendingGamesCount()) + " games left to play.");
+	}
+
+	void CompetitionManager::mergePreviousGames(const vector<GameRecord>& records, bool isRecordMerged)
+	{
+		if (_roundRobinCursor == nullptr)
+		{
+			mergeCompletedGames(records, isRecordMerged);	// Ignores the records, with a warning
+			return;
+		}
+
+		// Task ids depend on the competition's players and boards, so find each game by its names instead.
+		// Names can't contain the separator of the game record fields, so the key is unique.
+		auto gameKey = [](const string& playerAName, const string& playerBName, const string& boardName)
 		{
-			_gamesSet.push(std::move(inversedGamesSet.front()));
-			inversedGamesSet.pop();
+			return playerAName + '\t' + playerBName + '\t' + boardName;
+		};
+
+		unordered_map<string, const GameRecord*> recordsByGame;
+		for (const auto& record : records)
+			recordsByGame[gameKey(record.playerAName, record.playerBName, record.boardName)] = &record;
+
+		vector<GameRecord> currentRecords;
+		for (size_t taskId = 0; taskId < _roundRobinCursor->gamesCount(); taskId++)
+		{
+			if (!_roundRobinCursor->isPending(taskId))
+				continue;
+
+			auto task = _roundRobinCursor->task(taskId);
+			auto recordIt = recordsByGame.find(gameKey(task->playerAName(), task->playerBName(), task->boardName()));
+			if (recordIt != recordsByGame.end())
+			{
+				currentRecords.emplace_back(taskId, task->playerAName(), task->playerBName(), task->boardName(),
+											recordIt->second->results);
+			}
 		}
+
+		mergeCompletedGames(currentRecords, isRecordMerged);
 	}
 
-	CompetitionManager::CompetitionManager(shared_ptr<BattleshipGameBoardFactory> boardLoader,
-										   shared_ptr<AlgoLoader> algoLoader,
-										   int threadCount):
-										   _boardLoader(boardLoader),
-										   _algoLoader(algoLoader)
+	bool CompetitionManager::addEntrants(const vector<string>& newAlgos, const vector<string>& newBoards)
 	{
-		// Fill priority queue with tasks for all possible games in competition
-		prepareCompetition(boardLoader, algoLoader);
+		if ((_roundRobinScheduler == nullptr) || (_shard.count > 1))
+		{
+			Logger::getInstance().log(Severity::WARNING_LEVEL,
+									  "Algorithms and boards can only be added to a round robin competition that "
+									  "isn't split between shards, " + to_string(newAlgos.size()) + " algorithms and " +
+									  to_string(newBoards.size()) + " boards ignored.");
+			return false;
+		}
 
-		// Don't use more threads than needed, even if count says so
-		_workerThreadsCount = threadCount < _gamesSet.size() ? 
-							  threadCount : _gamesSet.size();
-		_workerThreads.reserve(_workerThreadsCount);
+		lock_guard<mutex> lock(_entrantsLock);
+
+		vector<string> players = _players;
+		vector<string> boards = _boards;
+		vector<unique_ptr<SingleGameTask>> games;
+		size_t taskId = _nextEntrantTaskId;
+		auto addGame = [&games, &taskId](const string& playerAName, const string& playerBName, const string& boardName)
+		{
+			games.push_back(std::make_unique<SingleGameTask>(taskId++, playerAName, playerBName, boardName));
+		};
+
+		// A new algorithm plays the players that joined before it, on the boards the competition already has
+		for (const auto& newAlgo : newAlgos)
+		{
+			for (const auto& board : boards)
+			{
+				for (const auto& player : players)
+				{
+					addGame(newAlgo, player, board);
+					addGame(player, newAlgo, board);
+				}
+			}
+
+			players.push_back(newAlgo);
+		}
+
+		// All players play on a new board, the inversed games follow the same way they do on the other boards
+		for (const auto& newBoard : newBoards)
+		{
+			for (size_t player1 = 0; player1 < players.size(); player1++)
+			{
+				for (size_t player2 = player1 + 1; player2 < players.size(); player2++)
+					addGame(players[player1], players[player2], newBoard);
+			}
+
+			for (size_t player1 = 0; player1 < players.size(); player1++)
+			{
+				for (size_t player2 = player1 + 1; player2 < players.size(); player2++)
+					addGame(players[player2], players[player1], newBoard);
+			}
+
+			boards.push_back(newBoard);
+		}
+
+		// Every player still plays twice against each other player on each board
+		size_t gamesCount = games.size();
+		size_t totalRounds = players.empty() ? 0 : ((players.size() - 1) * 2 * boards.size());
+		bool isAdded = _roundRobinScheduler->append(std::move(games), [this, &newAlgos, totalRounds]()
+		{
+			_scoreboard->addPlayers(newAlgos, totalRounds);
+		});
+
+		if (!isAdded)
+		{
+			Logger::getInstance().log(Severity::WARNING_LEVEL,
+									  "The competition's last game was already dealt, " + to_string(newAlgos.size()) +
+									  " algorithms and " + to_string(newBoards.size()) + " boards are too late to join.");
+			return false;
+		}
+
+		_players = std::move(players);
+		_boards = std::move(boards);
+		_nextEntrantTaskId = taskId;
+
+		Logger::getInstance().log(Severity::INFO_LEVEL,
+								  to_string(newAlgos.size()) + " algorithms and " + to_string(newBoards.size()) +
+								  " boards joined the competition, " + to_string(gamesCount) + " games added.");
+		return true;
 	}
 
 	void CompetitionManager::runWorkerThread(shared_ptr<BattleshipGameBoardFactory> boardLoader,
@@ -74,60 +339,94 @@ namespace battleship
 	{
 		// Each thread keeps it's own pool of resources that are created on demand,
 		// to avoid wasting time on locking shared resources between multiple threads
-		WorkerThreadResourcePool resourcePool(boardLoader, algoLoader);
+		WorkerThreadResourcePool resourcePool(boardLoader, algoLoader, _algoPoolCapacity, _helperThreadsPerWorker,
+											  _parallelScanMinSquares);
+		WorkerStats& stats = *_workersStats[threadId - 1];
 
 		Logger::getInstance().log(Severity::INFO_LEVEL, "Worker thread #" + to_string(threadId) + " started..");
 
-		while (!_gamesSet.empty()) // While there are still games to be played
+		while (true) // While there are still games to be played
 		{
-			unique_ptr<SingleGameTask> task;
+			// Derive the next game from the scheduler shared by all worker threads.
+			// Waiting for the next round of a tournament counts as queue wait as well.
+			auto queueWaitStartTime = steady_clock::now();
+			unique_ptr<SingleGameTask> task = _scheduler->next();
+			stats.addQueueWait(duration_cast<microseconds>(steady_clock::now() - queueWaitStartTime).count());
 
-			// Protect the game-set queue from concurrent access, each worker fetches a task and releases the lock
-			{
-				lock_guard<mutex> lock(_gameSetLock);
-				if (_gamesSet.empty()) // Check that nobody stole the last game before the snatched the lock
-					break;
-
-				// Pop next game task from game-queue.
-				// Games are expected to be pre-sorted in a fair manner for all players.
-				task = std::move(_gamesSet.front());
-				_gamesSet.pop();
-			}
+			if (task == nullptr) // All games were dealt
+				break;
+
+			// Run the game the task represents
+			stats.startGame(task->playerAName(), task->playerBName(), task->boardName());
+			long long startAllocations = AllocationCounter::allocationsCount();
 
-			// Lock is released and the thread now runs the game the task represents
-			if (task != nullptr)
+			GameResults results = task->run(resourcePool, _scoreboard.get(), _resultsCache.get());
+			stats.finishGame(results, AllocationCounter::allocationsCount() - startAllocations);
+			_scheduler->onGameFinished(*task, results);
+
+			if (_resultsWriter != nullptr)
 			{
-				task->run(resourcePool, _scoreboard.get());
+				_resultsWriter->write(GameRecord(task->taskId(), task->playerAName(), task->playerBName(),
+												 task->boardName(), results));
 			}
 		}
 
+		{	// Merge this thread's instantiation metrics and call latencies into the competition's
+			lock_guard<mutex> lock(_algoPoolStatsLock);
+			for (const auto& algoStatsEntry : resourcePool.algoStats())
+				_algoPoolStats[algoStatsEntry.first].merge(algoStatsEntry.second);
+			for (const auto& algoLatenciesEntry : resourcePool.allAlgoLatencies())
+				_algoLatencies[algoLatenciesEntry.first].merge(algoLatenciesEntry.second);
+		}
+
 		Logger::getInstance().log(Severity::INFO_LEVEL, "Worker thread #" + to_string(threadId) + " finished..");
 	}
 
 	void CompetitionManager::run()
 	{
-		if (_workerThreadsCount < 1)
+		if (_threadCount < 1)
 		{
 			Logger::getInstance().log(Severity::ERROR_LEVEL,
 								 	  "Attempted to start competition with illegal number of worker threads: " +
-									  to_string(_workerThreadsCount));
+									  to_string(_threadCount));
 			return;
 		}
 
+		// Don't use more threads than needed, even if count says so
+		size_t pendingGamesCount = _scheduler->pendingGamesCount();
+		_workerThreadsCount = min(_threadCount, pendingGamesCount);
+		_workerThreads.reserve(_workerThreadsCount);
+
+		// Threads left without games are lent to the algorithms, to split their scans of huge boards
+		_helperThreadsPerWorker = (_workerThreadsCount > 0) ?
+								  static_cast<int>((_threadCount - _workerThreadsCount) / _workerThreadsCount) : 0;
+
 		Logger::getInstance().log(Severity::INFO_LEVEL,
 								  "Competition started with " + 
-								  to_string(_gamesSet.size()) +
+								  to_string(pendingGamesCount) +
 			                      " games run by " +
 								  to_string(_workerThreadsCount) +
 								  " threads.");
 
+		// Counters of all worker threads, reported periodically if a stats output was requested
+		_workersStats.clear();
+		for (int threadId = 1; threadId <= _workerThreadsCount; threadId++)
+			_workersStats.push_back(std::make_unique<WorkerStats>(threadId));
+
+		unique_ptr<WorkerStatsReporter> statsReporter;
+		if (!_statsFilename.empty() && (_statsIntervalMillis > 0))
+		{
+			statsReporter = std::make_unique<WorkerStatsReporter>(_statsFilename, _statsIntervalMillis, _workersStats);
+			statsReporter->start();
+		}
+
 		// Start all worker threads
 		for (int threadId = 1; threadId <= _workerThreadsCount; threadId++)
 		{
 			// This statement takes care of the edge case where we have too many worker threads running.
 			// If all existing worker threads have already drained the game tasks queue there is no point
 			// in creating any additional threads that will do nothing
-			if (!_gamesSet.empty())
+			if (!_scheduler->isExhausted())
 			{
 				_workerThreads.push_back(std::move(thread(&CompetitionManager::runWorkerThread,
 										 this, _boardLoader, _algoLoader, threadId)));
@@ -141,7 +440,7 @@ namespace battleship
 		}
 
 		// While competition is not over, wake up when round results are ready and print them
-		while (!_gamesSet.empty())
+		while (!_scheduler->isExhausted())
 		{
 			// Wait on conditional_variable predicate and wake up when some round results are ready
 			// Then print all ready round results from the scoreboard and drain the RoundResults queue
@@ -149,10 +448,10 @@ namespace battleship
 		}
 
 		// Drain any existing round results in queue and report to screen / log.
-		// Make sure to lock the results queue since the _gameSet may have been drained but it's
+		// Make sure to lock the results queue since all games may have been dealt but it's
 		// possible some worker threads are still executing their games.
 		// This print command exists to take care of the edge case where too many threads exist and the
-		// gameSet is drained before the main thread have had a chance to print results even once.
+		// games are all dealt before the main thread have had a chance to print results even once.
 		// We give it some time to print the ready round results here, before waiting for all worker threads
 		// to finish
 		_scoreboard->processRoundResultsQueue(true);
@@ -166,8 +465,22 @@ namespace battleship
 			}
 		}
 
+		// No worker is left to play the games of entrants that come from now on
+		if (_roundRobinScheduler != nullptr)
+			_roundRobinScheduler->close();
+
+		// Write the final counters
+		if (statsReporter != nullptr)
+			statsReporter->stop();
+
 		// Drain any remaining round results in queue and report to screen / log,
 		// without locking the results queue since the game is finished
 		_scoreboard->processRoundResultsQueue(false);
+		_scoreboard->printAlgoLatencies(_algoLatencies);
+
+		logAlgoPoolStats();
+
+		if (_resultsCache != nullptr)
+			_resultsCache->logStats();
 	}
 }
\ No newline at end of file
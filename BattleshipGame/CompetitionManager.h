@@ -2,49 +2,140 @@
 
 #include <memory>
 #include <vector>
-#include <queue>
 #include <thread>
 #include <mutex>
 #include "SingleGameTask.h"
 #include "Scoreboard.h"
 #include "AlgoLoader.h"
 #include "BattleshipGameBoardFactory.h"
+#include "GameRecord.h"
+#include "GameTaskCursor.h"
+#include "AppendableScheduler.h"
+#include "SwissScheduler.h"
+#include "EliminationScheduler.h"
+#include "WorkerStats.h"
+#include "ResultsCache.h"
 
 using std::vector;
-using std::queue;
 using std::shared_ptr;
 using std::unique_ptr;
 using std::thread;
 using std::mutex;
+using std::unordered_map;
 
 namespace battleship
 {
-	/** Manages competition between all available player dlls on all available battleboards
+	/** Manages competition between all available player dlls on all available battleboards,
+	 *  in one of the tournament formats (a round robin by default)
 	 */
 	class CompetitionManager
 	{
 	public:
 		/** Creates a new CompetitionManager which loads resources using the boardLoader and algoLoader.
 		 *  threadCount is the amount of threads used to run games in parallel.
+		 *  Only games that belong to the given shard are played (by default - all games).
+		 *  Competitions can only be split into shards in the round robin format.
 		 */
 		CompetitionManager(shared_ptr<BattleshipGameBoardFactory> boardLoader,
 						   shared_ptr<AlgoLoader> algoLoader,
-						   int threadCount);
+						   int threadCount,
+						   CompetitionShard shard = CompetitionShard(),
+						   TournamentFormat format = TournamentFormat::ROUND_ROBIN);
 		virtual ~CompetitionManager() = default;
 
-		/** Start digesting priority queue of games by worker threads and print round results when ready */
+		/** Start dealing the games to worker threads and print round results when ready */
 		void run();
 
-		/** Logic for a single worker thread: constantly drain and process SingleGameTasks from gameSet until empty */
+		/** The competition's scoreboard, e.g. for registering listeners before the competition runs */
+		Scoreboard& scoreboard();
+
+		/** Writes a record of each game played from now on to the given file.
+		 *  If isAppend is false the file is truncated first.
+		 */
+		void setResultsOutput(const string& filename, bool isAppend = false);
+
+		/** Serves the games the results cache in path holds from the cache instead of playing them, and adds the
+		 *  results of the games played to it (unless isReadOnly). See ResultsCache.
+		 */
+		void setResultsCache(const string& path, unsigned int seed, int verifyInterval, bool isReadOnly = false);
+
+		/** Sets the number of idle algorithm instances each worker thread keeps for reuse
+		 *  (WorkerThreadResourcePool::UNLIMITED_ALGO_POOL by default).
+		 */
+		void setAlgoPoolCapacity(size_t algoPoolCapacity);
+
+		/** Sets the smallest board (in squares) on which the algorithms may split their scans across the worker
+		 *  threads' helper threads (LayerTaskPool::DEFAULT_MIN_PARALLEL_SQUARES by default, see ParallelAlgo).
+		 */
+		void setParallelScanMinSquares(int minSquares);
+
+		/** Writes the live counters of the worker threads to the given file every intervalMillis
+		 *  while the competition runs (see WorkerStatsReporter).
+		 */
+		void setStatsOutput(const string& filename, int intervalMillis);
+
+		/** Algorithm instantiation metrics of all worker threads, available once the competition is over */
+		const unordered_map<string, AlgoPoolStats>& algoPoolStats() const;
+
+		/** Call latencies of each algorithm, merged from all worker threads, available once the competition is over */
+		const unordered_map<string, AlgoCallLatencies>& algoLatencies() const;
+
+		/** Feeds results of games that were already played elsewhere (e.g. by shard processes or by a previous run)
+		 *  to the scoreboard, and marks these games so they aren't played again. Records are applied in competition
+		 *  order regardless of their order in the list, so the standings don't depend on how the games were split.
+		 *  If isRecordMerged is true the merged games are written to the results output as well. Merged games are
+		 *  stored in the results cache, if one is set (see ResultsCache::store).
+		 *  Records that don't match a pending game of this shard are ignored.
+		 *  Only round robin competitions can merge games, since in other formats the games depend on earlier results.
+		 */
+		void mergeCompletedGames(const vector<GameRecord>& records, bool isRecordMerged = false);
+
+		/** Same as mergeCompletedGames, for records of an earlier competition that may have had other players or
+		 *  boards (e.g. from a CompetitionManifest): the records' task ids are ignored, and each record is merged
+		 *  into the game between the same players on the same board.
+		 */
+		void mergePreviousGames(const vector<GameRecord>& records, bool isRecordMerged = false);
+
+		/** Adds algorithms and boards that were loaded while the competition runs (e.g. by a ResourceWatcher).
+		 *  Each new algorithm plays every other player on every board, and every pair of players plays on each new
+		 *  board, in both orders. The games are played after the games that were scheduled so far.
+		 *  Returns false if the entrants can't join: entrants can only be added to a round robin competition that
+		 *  isn't split between shards, before its last game was dealt.
+		 *  This method is thread safe.
+		 */
+		bool addEntrants(const vector<string>& newAlgos, const vector<string>& newBoards);
+
+		/** Logic for a single worker thread: constantly take and process SingleGameTasks from the tournament
+		 *  scheduler until all games are dealt
+		 */
 		void runWorkerThread(shared_ptr<BattleshipGameBoardFactory> boardLoader,
 							 shared_ptr<AlgoLoader> algoLoader, int threadId);
 
 	private:
 
-		/** Priority queue of games in the competition, sorted by "game number" for each player so
-		 *  matches are evenly distributed.
+		/** Format of the competition */
+		TournamentFormat _format;
+
+		/** Deals the games of the competition to the worker threads, according to the competition's format */
+		unique_ptr<TournamentScheduler> _scheduler;
+
+		/** The scheduler of a round robin competition, in a balanced order for all players (NULL in other formats) */
+		GameTaskCursor* _roundRobinCursor;
+
+		/** Deals the games of the round robin cursor, followed by the games of entrants added while the competition
+		 *  runs (NULL in other formats)
 		 */
-		queue<unique_ptr<SingleGameTask>> _gamesSet;
+		AppendableScheduler* _roundRobinScheduler;
+
+		/** Players and boards of a round robin competition, including the entrants added while it runs */
+		vector<string> _players;
+		vector<string> _boards;
+
+		/** Task id of the next game of an added entrant (games of entrants follow the cursor's games) */
+		size_t _nextEntrantTaskId;
+
+		/** Serializes the addition of entrants */
+		mutex _entrantsLock;
 
 		/** Scoreboard of in game results for each round.
 		 *  Functions relevant for competition time are protected by locks to enable concurrency.
@@ -57,16 +148,55 @@ namespace battleship
 		/** Resources loader for available algorithms (creates new instances of IBattleShipGameAlgos) */
 		shared_ptr<AlgoLoader> _algoLoader;
 
-		/** List of worker threads that process the gameSet priority queue in parallel */
+		/** List of worker threads that play the competition's games in parallel */
 		vector<thread> _workerThreads;
 
-		/** Locks the gameSet when multiple threads aim to pull from it */
-		mutex _gameSetLock;
+		/** Number of worker threads requested for the competition */
+		size_t _threadCount;
 
 		/** Number of actual worker threads the competition manager employs */
 		size_t _workerThreadsCount;
 
-		/** Creates priority queue of games to run */
+		/** Number of helper threads each worker thread lends to its algorithms (see ParallelAlgo) */
+		int _helperThreadsPerWorker;
+
+		/** Smallest board on which the helper threads are lent to the algorithms' scans */
+		int _parallelScanMinSquares;
+
+		/** The part of the competition this process plays */
+		CompetitionShard _shard;
+
+		/** Records the games played, if an output was requested (may be NULL) */
+		unique_ptr<GameRecordWriter> _resultsWriter;
+
+		/** Results of games played by earlier competitions (may be NULL) */
+		unique_ptr<ResultsCache> _resultsCache;
+
+		/** Number of idle algorithm instances each worker thread keeps */
+		size_t _algoPoolCapacity;
+
+		/** Algorithm instantiation metrics, merged from all worker threads when they finish */
+		unordered_map<string, AlgoPoolStats> _algoPoolStats;
+
+		/** Call latencies of each algorithm, merged from all worker threads when they finish */
+		unordered_map<string, AlgoCallLatencies> _algoLatencies;
+
+		/** Locks _algoPoolStats and _algoLatencies when worker threads merge their metrics */
+		mutex _algoPoolStatsLock;
+
+		/** Live counters of each worker thread, indexed by thread id - 1 */
+		vector<unique_ptr<WorkerStats>> _workersStats;
+
+		/** File the worker counters are written to while the competition runs (empty if not requested) */
+		string _statsFilename;
+
+		/** Time between two writes of the worker counters */
+		int _statsIntervalMillis;
+
+		/** Logs the algorithm instantiation metrics of the competition */
+		void logAlgoPoolStats() const;
+
+		/** Creates the scheduler of the games to run, and the scoreboard */
 		void prepareCompetition(shared_ptr<BattleshipGameBoardFactory> boardLoader,
 							    shared_ptr<AlgoLoader> algoLoader);
 	};
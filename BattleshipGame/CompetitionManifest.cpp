@@ -0,0 +1,146 @@
+#include "CompetitionManifest.h"
+#include "IOUtil.h"
+#include "Logger.h"
+#include <fstream>
+
+using std::ifstream;
+using std::ofstream;
+using std::to_string;
+
+namespace battleship
+{
+	CompetitionManifest::CompetitionManifest(const string& path, const AlgoLoader& algoLoader,
+											 const BattleshipGameBoardFactory& boardFactory) :
+		_filename(path + "\\" + MANIFEST_FILE)
+	{
+		for (const auto& algoName : algoLoader.loadedGameAlgos())
+			_algoFingerprints[algoName] = algoLoader.fingerprint(algoName);
+		for (const auto& boardName : boardFactory.loadedBoardsList())
+			_boardFingerprints[boardName] = boardFactory.boardFingerprint(boardName);
+	}
+
+	vector<GameRecord> CompetitionManifest::loadUnchangedGames() const
+	{
+		vector<GameRecord> unchangedGames;
+
+		// No manifest simply means no competition was completed here yet
+		if (!ifstream(_filename).good())
+		{
+			Logger::getInstance().log(Severity::INFO_LEVEL,
+									  "No previous competition manifest in " + _filename + ", playing all games");
+			return unchangedGames;
+		}
+
+		unordered_map<string, uint64_t> previousAlgoFingerprints;
+		unordered_map<string, uint64_t> previousBoardFingerprints;
+		auto lineParser = [&previousAlgoFingerprints, &previousBoardFingerprints](string& nextLine)
+		{
+			if (!parseFingerprintLine(nextLine, ALGO_LINE_PREFIX, previousAlgoFingerprints))
+				parseFingerprintLine(nextLine, BOARD_LINE_PREFIX, previousBoardFingerprints);
+		};
+
+		IOUtil::parseFile(_filename, lineParser);
+
+		size_t changedAlgosCount = 0;
+		for (const auto& algo : _algoFingerprints)
+		{
+			if (!isUnchanged(algo.first, previousAlgoFingerprints, _algoFingerprints))
+			{
+				Logger::getInstance().log(Severity::INFO_LEVEL, "Algorithm " + algo.first + " is new or was rebuilt");
+				changedAlgosCount++;
+			}
+		}
+
+		size_t changedBoardsCount = 0;
+		for (const auto& board : _boardFingerprints)
+		{
+			if (!isUnchanged(board.first, previousBoardFingerprints, _boardFingerprints))
+				changedBoardsCount++;
+		}
+
+		for (auto& record : GameRecord::readAll(_filename))
+		{
+			if (isUnchanged(record.playerAName, previousAlgoFingerprints, _algoFingerprints) &&
+				isUnchanged(record.playerBName, previousAlgoFingerprints, _algoFingerprints) &&
+				isUnchanged(record.boardName, previousBoardFingerprints, _boardFingerprints))
+			{
+				unchangedGames.push_back(std::move(record));
+			}
+		}
+
+		Logger::getInstance().log(Severity::INFO_LEVEL,
+								  "Incremental competition: " + to_string(changedAlgosCount) + " of " +
+								  to_string(_algoFingerprints.size()) + " algorithms and " +
+								  to_string(changedBoardsCount) + " of " + to_string(_boardFingerprints.size()) +
+								  " boards are new or changed, reusing " + to_string(unchangedGames.size()) +
+								  " games of the previous competition");
+
+		return unchangedGames;
+	}
+
+	void CompetitionManifest::attach(Scoreboard& scoreboard)
+	{
+		scoreboard.addGameResultsListener([this](const GameResults& results,
+												 const string& playerAName, const string& playerBName,
+												 const string& boardName)
+		{
+			_games.emplace_back(0, playerAName, playerBName, boardName, results);
+		});
+	}
+
+	bool CompetitionManifest::save() const
+	{
+		ofstream manifestFile(_filename, std::ofstream::out | std::ofstream::trunc);
+		if (!manifestFile.is_open())
+		{
+			Logger::getInstance().log(Severity::ERROR_LEVEL, "Failed to create competition manifest " + _filename);
+			return false;
+		}
+
+		for (const auto& algo : _algoFingerprints)
+			manifestFile << ALGO_LINE_PREFIX << FIELD_SEPARATOR << algo.first << FIELD_SEPARATOR << algo.second << "\n";
+		for (const auto& board : _boardFingerprints)
+			manifestFile << BOARD_LINE_PREFIX << FIELD_SEPARATOR << board.first << FIELD_SEPARATOR << board.second << "\n";
+		for (const auto& game : _games)
+			manifestFile << game.toLine() << "\n";
+
+		manifestFile.flush();
+		if (!manifestFile)
+		{
+			Logger::getInstance().log(Severity::ERROR_LEVEL, "IO error when writing competition manifest " + _filename);
+			return false;
+		}
+
+		Logger::getInstance().log(Severity::INFO_LEVEL, "Competition manifest saved with " +
+								  to_string(_games.size()) + " games");
+		return true;
+	}
+
+	bool CompetitionManifest::parseFingerprintLine(const string& line, const string& prefix,
+												   unordered_map<string, uint64_t>& fingerprints)
+	{
+		string linePrefix = prefix + FIELD_SEPARATOR;
+		if (!IOUtil::startsWith(line, linePrefix))
+			return false;
+
+		size_t separatorPos = line.rfind(FIELD_SEPARATOR);
+		string fingerprint = line.substr(separatorPos + 1);
+		if ((separatorPos < linePrefix.size()) || !IOUtil::isInteger(fingerprint))
+			return false;
+
+		fingerprints[line.substr(linePrefix.size(), separatorPos - linePrefix.size())] = std::stoull(fingerprint);
+		return true;
+	}
+
+	bool CompetitionManifest::isUnchanged(const string& name,
+										  const unordered_map<string, uint64_t>& previousFingerprints,
+										  const unordered_map<string, uint64_t>& currentFingerprints)
+	{
+		auto previousIt = previousFingerprints.find(name);
+		auto currentIt = currentFingerprints.find(name);
+
+		// A fingerprint of 0 means the contents are unknown
+		return (previousIt != previousFingerprints.end()) && (currentIt != currentFingerprints.end()) &&
+			   (currentIt->second != 0) && (previousIt->second == currentIt->second);
+	}
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+#include "GameRecord.h"
+#include "AlgoLoader.h"
+#include "BattleshipGameBoardFactory.h"
+#include "Scoreboard.h"
+
+using std::string;
+using std::vector;
+using std::unordered_map;
+
+namespace battleship
+{
+	/** Manifest of the last competition that was completed in a path, for incremental competitions.
+	 *  The manifest holds the fingerprints of the competition's algorithms and boards (see AlgoLoader::fingerprint
+	 *  and BattleshipGameBoardFactory::boardFingerprint) and the results of all of its games. The next competition
+	 *  reuses the results of the games whose players and board didn't change, so only the games of new or rebuilt
+	 *  algorithms and of new or modified boards are played.
+	 *  File format: a comment line per algorithm and per board (prefix, name and fingerprint, tab separated),
+	 *  followed by a game record per game (see GameRecord). Task ids aren't kept, since they change whenever
+	 *  players or boards are added - games are identified by their players and board names instead.
+	 */
+	class CompetitionManifest
+	{
+	public:
+		/** Creates the manifest of the competition between the algorithms and boards the loaders loaded,
+		 *  located in path
+		 */
+		CompetitionManifest(const string& path, const AlgoLoader& algoLoader,
+							const BattleshipGameBoardFactory& boardFactory);
+		virtual ~CompetitionManifest() = default;
+
+		CompetitionManifest(CompetitionManifest const&) = delete;	// Disable copying
+		CompetitionManifest& operator=(CompetitionManifest const&) = delete;	// Disable copying (assignment)
+
+		/** Returns the records of the previous competition's games between algorithms that weren't rebuilt,
+		 *  on boards that weren't modified. If there's no manifest an empty list is returned.
+		 */
+		vector<GameRecord> loadUnchangedGames() const;
+
+		/** Records every game the scoreboard sees from now on (games that are played and games that are merged),
+		 *  for save()
+		 */
+		void attach(Scoreboard& scoreboard);
+
+		/** Replaces the manifest with the one of this competition, to be called once the competition is complete.
+		 *  Returns false on IO errors.
+		 */
+		bool save() const;
+
+	private:
+		/** Manifest file name */
+		static constexpr auto MANIFEST_FILE = "competition.manifest";
+
+		/** Beginning of the fingerprint lines of algorithms and boards (comment lines for GameRecord readers) */
+		static constexpr auto ALGO_LINE_PREFIX = "#algo";
+		static constexpr auto BOARD_LINE_PREFIX = "#board";
+
+		/** Separates the fields of a fingerprint line */
+		static constexpr char FIELD_SEPARATOR = '\t';
+
+		string _filename;
+
+		/** Fingerprints of this competition's algorithms and boards, by name */
+		unordered_map<string, uint64_t> _algoFingerprints;
+		unordered_map<string, uint64_t> _boardFingerprints;
+
+		/** Games of this competition, in the order the scoreboard saw them.
+		 *  Scoreboard listeners are invoked one at a time, so no lock is needed.
+		 */
+		vector<GameRecord> _games;
+
+		/** Parses a fingerprint line of the given prefix into fingerprints. Returns false if it isn't one. */
+		static bool parseFingerprintLine(const string& line, const string& prefix,
+										 unordered_map<string, uint64_t>& fingerprints);
+
+		/** Returns true if the name has the same known fingerprint in both lists */
+		static bool isUnchanged(const string& name, const unordered_map<string, uint64_t>& previousFingerprints,
+								const unordered_map<string, uint64_t>& currentFingerprints);
+	};
+}
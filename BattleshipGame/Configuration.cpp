@@ -15,13 +15,14 @@ namespace battleship
 	{
 		if (argc > MAX_ARG_COUNT)
 		{
-			string error = "Error: Too many arguments given. Try: BattleShipGame [path] [-threads <#count>]";
+			string error = "Error: Too many arguments given. "
+						   "Try: BattleShipGame [path] [-threads <#count>] [-shards <#count>]";
 			configurationIssues.push_back(std::make_pair(Severity::ERROR_LEVEL, error));
 			return false;
 		}
 
 		// If the first parameter doesn't match any of the configuration keywords this is a path
-		if ((argc >= 2) && strcmp(BP_CONFIG_THREADS, argv[1]))
+		if ((argc >= 2) && (argv[1][0] != BP_CONFIG_ARG_MARKER))
 		{
 			this->path = argv[1];
 		}
@@ -31,36 +32,59 @@ namespace battleship
 		{
 			if (!strcmp(argv[i], BP_CONFIG_THREADS))
 			{
-				if (argc > i + 1)
-				{
-					string argVal = argv[i + 1];
-					if (IOUtil::isInteger(argVal))
-					{
-						this->threads = std::stoi(argv[i + 1]);
-
-						if (this->threads <= 0)	// Invalid thread count value
-						{
-							string error = "Error: Invalid thread count value. Thread count must be > 0 ";
-							configurationIssues.push_back(std::make_pair(Severity::ERROR_LEVEL, error));
-							return false;
-						}
-					}
-					else
-					{
-						string error = "Error: Illegal threads field value. Try: -threads <#count>";
-						configurationIssues.push_back(std::make_pair(Severity::ERROR_LEVEL, error));
-						return false;
-					}
-				}
-				else
-				{
-					string error = "Error: Threads argument missing value field. Try: -threads <#count>";
-					configurationIssues.push_back(std::make_pair(Severity::ERROR_LEVEL, error));
+				if (!parseIntArg(argc, argv, i, "threads", 1, this->threads))
+					return false;
+			}
+			else if (!strcmp(argv[i], BP_CONFIG_SHARDS))
+			{
+				if (!parseIntArg(argc, argv, i, "shards", 1, this->shards))
+					return false;
+			}
+			else if (!strcmp(argv[i], BP_CONFIG_SHARD_INDEX))
+			{
+				if (!parseIntArg(argc, argv, i, "shard", 0, this->shardIndex))
 					return false;
-				}
 			}
 		}
 
+		// A shard process must know which part of the competition is its own
+		if ((this->shardIndex >= 0) && (this->shardIndex >= this->shards))
+		{
+			string error = "Error: Invalid shard index value. Shard index must be < shards count";
+			configurationIssues.push_back(std::make_pair(Severity::ERROR_LEVEL, error));
+			return false;
+		}
+
+		return true;
+	}
+
+	bool Configuration::parseIntArg(int argc, char* argv[], int argIndex, const string& argName,
+									int minVal, int& value)
+	{
+		if (argc <= argIndex + 1)
+		{
+			string error = "Error: " + argName + " argument missing value field. Try: -" + argName + " <#count>";
+			configurationIssues.push_back(std::make_pair(Severity::ERROR_LEVEL, error));
+			return false;
+		}
+
+		string argVal = argv[argIndex + 1];
+		if (!IOUtil::isInteger(argVal))
+		{
+			string error = "Error: Illegal " + argName + " field value. Try: -" + argName + " <#count>";
+			configurationIssues.push_back(std::make_pair(Severity::ERROR_LEVEL, error));
+			return false;
+		}
+
+		value = std::stoi(argVal);
+
+		if (value < minVal)	// Invalid value
+		{
+			string error = "Error: Invalid " + argName + " value. Value must be >= " + std::to_string(minVal);
+			configurationIssues.push_back(std::make_pair(Severity::ERROR_LEVEL, error));
+			return false;
+		}
+
 		return true;
 	}
 
@@ -146,6 +170,261 @@ namespace battleship
 					configurationIssues.push_back(std::make_pair(Severity::WARNING_LEVEL, warning));
 				}
 			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_RANDOM_BOARDS)) // Random boards count parameter (int)
+			{
+				IOUtil::removePrefix(nextLine, CONFIG_HEADER_RANDOM_BOARDS);
+				normalizeValue(nextLine);
+
+				if (validateInt(nextLine, 0, INT_MAX)) // Only use the value if this is a valid int
+				{
+					this->randomBoards = std::stoi(nextLine.c_str());
+				}
+				else
+				{
+					isValidFile = false;
+					string warning = "Configuration file traced invalid random boards count value";
+					configurationIssues.push_back(std::make_pair(Severity::WARNING_LEVEL, warning));
+				}
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_RANDOM_BOARD_SIZE)) // Random boards size parameter (string)
+			{
+				IOUtil::removePrefix(nextLine, CONFIG_HEADER_RANDOM_BOARD_SIZE);
+				normalizeValue(nextLine);
+				this->randomBoardSize = (!(nextLine.empty())) ? nextLine : DEFAULT_RANDOM_BOARD_SIZE;
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_RANDOM_SEED)) // Random boards seed parameter (int)
+			{
+				IOUtil::removePrefix(nextLine, CONFIG_HEADER_RANDOM_SEED);
+				normalizeValue(nextLine);
+
+				if (validateInt(nextLine, 0, INT_MAX)) // Only use the value if this is a valid int
+				{
+					this->randomSeed = static_cast<unsigned int>(std::stoi(nextLine.c_str()));
+				}
+				else
+				{
+					isValidFile = false;
+					string warning = "Configuration file traced invalid random seed value";
+					configurationIssues.push_back(std::make_pair(Severity::WARNING_LEVEL, warning));
+				}
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_SHARDS)) // Shards parameter (int)
+			{
+				IOUtil::removePrefix(nextLine, CONFIG_HEADER_SHARDS);
+				normalizeValue(nextLine);
+
+				if (validateInt(nextLine, 1, INT_MAX)) // Only use the value if this is a valid int
+				{
+					this->shards = std::stoi(nextLine.c_str());
+				}
+				else
+				{
+					isValidFile = false;
+					string warning = "Configuration file traced invalid shards count value";
+					configurationIssues.push_back(std::make_pair(Severity::WARNING_LEVEL, warning));
+				}
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_CHECKPOINT)) // Checkpoint parameter (0 / 1)
+			{
+				IOUtil::removePrefix(nextLine, CONFIG_HEADER_CHECKPOINT);
+				normalizeValue(nextLine);
+
+				if (validateInt(nextLine, 0, 1)) // Only use the value if this is a valid int
+				{
+					this->checkpoint = (std::stoi(nextLine.c_str()) != 0);
+				}
+				else
+				{
+					isValidFile = false;
+					string warning = "Configuration file traced invalid checkpoint value";
+					configurationIssues.push_back(std::make_pair(Severity::WARNING_LEVEL, warning));
+				}
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_STATIC_ALGOS)) // Compiled-in algorithms parameter (0 / 1)
+			{
+				IOUtil::removePrefix(nextLine, CONFIG_HEADER_STATIC_ALGOS);
+				normalizeValue(nextLine);
+
+				if (validateInt(nextLine, 0, 1)) // Only use the value if this is a valid int
+				{
+					this->staticAlgos = (std::stoi(nextLine.c_str()) != 0);
+				}
+				else
+				{
+					isValidFile = false;
+					string warning = "Configuration file traced invalid static algorithms value";
+					configurationIssues.push_back(std::make_pair(Severity::WARNING_LEVEL, warning));
+				}
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_ALGO_POOL_CAPACITY)) // Algorithm pool capacity parameter
+			{
+				IOUtil::removePrefix(nextLine, CONFIG_HEADER_ALGO_POOL_CAPACITY);
+				normalizeValue(nextLine);
+
+				if (validateInt(nextLine, 0, INT_MAX)) // Only use the value if this is a valid int
+				{
+					this->algoPoolCapacity = std::stoi(nextLine.c_str());
+				}
+				else
+				{
+					isValidFile = false;
+					string warning = "Configuration file traced invalid algorithm pool capacity value";
+					configurationIssues.push_back(std::make_pair(Severity::WARNING_LEVEL, warning));
+				}
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_PARALLEL_SCAN_MIN_SQUARES)) // Parallel scan threshold
+			{
+				IOUtil::removePrefix(nextLine, CONFIG_HEADER_PARALLEL_SCAN_MIN_SQUARES);
+				normalizeValue(nextLine);
+
+				if (validateInt(nextLine, 0, INT_MAX)) // Only use the value if this is a valid int
+				{
+					this->parallelScanMinSquares = std::stoi(nextLine.c_str());
+				}
+				else
+				{
+					isValidFile = false;
+					string warning = "Configuration file traced invalid parallel scan threshold value";
+					configurationIssues.push_back(std::make_pair(Severity::WARNING_LEVEL, warning));
+				}
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_STATS_INTERVAL)) // Worker stats interval parameter
+			{
+				IOUtil::removePrefix(nextLine, CONFIG_HEADER_STATS_INTERVAL);
+				normalizeValue(nextLine);
+
+				if (validateInt(nextLine, 0, INT_MAX)) // Only use the value if this is a valid int
+				{
+					this->statsInterval = std::stoi(nextLine.c_str());
+				}
+				else
+				{
+					isValidFile = false;
+					string warning = "Configuration file traced invalid worker stats interval value";
+					configurationIssues.push_back(std::make_pair(Severity::WARNING_LEVEL, warning));
+				}
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_RESULTS_EXPORT)) // Results export format parameter
+			{
+				IOUtil::removePrefix(nextLine, CONFIG_HEADER_RESULTS_EXPORT);
+				normalizeValue(nextLine);
+
+				int minVal = static_cast<int>(ResultsFormat::NONE);
+				int maxVal = static_cast<int>(ResultsFormat::BINARY);
+
+				if (validateInt(nextLine, minVal, maxVal)) // Only use the value if this is a valid int
+				{
+					this->resultsExport = static_cast<ResultsFormat>(std::stoi(nextLine.c_str()));
+				}
+				else
+				{
+					isValidFile = false;
+					string warning = "Configuration file traced invalid results export value";
+					configurationIssues.push_back(std::make_pair(Severity::WARNING_LEVEL, warning));
+				}
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_RATING_SYSTEM)) // Standings rating system parameter
+			{
+				IOUtil::removePrefix(nextLine, CONFIG_HEADER_RATING_SYSTEM);
+				normalizeValue(nextLine);
+
+				int minVal = static_cast<int>(RatingSystem::WIN_PERCENTAGE);
+				int maxVal = static_cast<int>(RatingSystem::GLICKO2);
+
+				if (validateInt(nextLine, minVal, maxVal)) // Only use the value if this is a valid int
+				{
+					this->ratingSystem = static_cast<RatingSystem>(std::stoi(nextLine.c_str()));
+				}
+				else
+				{
+					isValidFile = false;
+					string warning = "Configuration file traced invalid rating system value";
+					configurationIssues.push_back(std::make_pair(Severity::WARNING_LEVEL, warning));
+				}
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_TOURNAMENT_FORMAT)) // Competition format parameter
+			{
+				IOUtil::removePrefix(nextLine, CONFIG_HEADER_TOURNAMENT_FORMAT);
+				normalizeValue(nextLine);
+
+				int minVal = static_cast<int>(TournamentFormat::ROUND_ROBIN);
+				int maxVal = static_cast<int>(TournamentFormat::DOUBLE_ELIMINATION);
+
+				if (validateInt(nextLine, minVal, maxVal)) // Only use the value if this is a valid int
+				{
+					this->tournamentFormat = static_cast<TournamentFormat>(std::stoi(nextLine.c_str()));
+				}
+				else
+				{
+					isValidFile = false;
+					string warning = "Configuration file traced invalid tournament format value";
+					configurationIssues.push_back(std::make_pair(Severity::WARNING_LEVEL, warning));
+				}
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_RESULTS_CACHE_VERIFY)) // Cache verification parameter
+			{
+				IOUtil::removePrefix(nextLine, CONFIG_HEADER_RESULTS_CACHE_VERIFY);
+				normalizeValue(nextLine);
+
+				if (validateInt(nextLine, 0, INT_MAX)) // Only use the value if this is a valid int
+				{
+					this->resultsCacheVerify = std::stoi(nextLine.c_str());
+				}
+				else
+				{
+					isValidFile = false;
+					string warning = "Configuration file traced invalid results cache verification value";
+					configurationIssues.push_back(std::make_pair(Severity::WARNING_LEVEL, warning));
+				}
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_RESULTS_CACHE)) // Results cache parameter (0 / 1)
+			{
+				IOUtil::removePrefix(nextLine, CONFIG_HEADER_RESULTS_CACHE);
+				normalizeValue(nextLine);
+
+				if (validateInt(nextLine, 0, 1)) // Only use the value if this is a valid int
+				{
+					this->resultsCache = (std::stoi(nextLine.c_str()) != 0);
+				}
+				else
+				{
+					isValidFile = false;
+					string warning = "Configuration file traced invalid results cache value";
+					configurationIssues.push_back(std::make_pair(Severity::WARNING_LEVEL, warning));
+				}
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_INCREMENTAL)) // Incremental mode parameter (0 / 1)
+			{
+				IOUtil::removePrefix(nextLine, CONFIG_HEADER_INCREMENTAL);
+				normalizeValue(nextLine);
+
+				if (validateInt(nextLine, 0, 1)) // Only use the value if this is a valid int
+				{
+					this->incremental = (std::stoi(nextLine.c_str()) != 0);
+				}
+				else
+				{
+					isValidFile = false;
+					string warning = "Configuration file traced invalid incremental value";
+					configurationIssues.push_back(std::make_pair(Severity::WARNING_LEVEL, warning));
+				}
+			}
+			else if (IOUtil::startsWith(nextLine, CONFIG_HEADER_HOT_ADD)) // Hot-add mode parameter (0 / 1)
+			{
+				IOUtil::removePrefix(nextLine, CONFIG_HEADER_HOT_ADD);
+				normalizeValue(nextLine);
+
+				if (validateInt(nextLine, 0, 1)) // Only use the value if this is a valid int
+				{
+					this->hotAdd = (std::stoi(nextLine.c_str()) != 0);
+				}
+				else
+				{
+					isValidFile = false;
+					string warning = "Configuration file traced invalid hot-add value";
+					configurationIssues.push_back(std::make_pair(Severity::WARNING_LEVEL, warning));
+				}
+			}
 			else if ((IOUtil::startsWith(nextLine, CONFIG_HEADER_COMMENT)) ||  // Comment %%
 					 (IOUtil::isContainOnlyWhitespaces(nextLine))) // Empty line
 			{
@@ -173,6 +452,23 @@ namespace battleship
 		this->path = DEFAULT_PATH;			   // Nameless param, default is working directory
 		this->threads = DEFAULT_THREAD_COUNT;  // Optional param: worker threads count
 		this->logSeverity = DEFAULT_SEVERITY;  // Default is info level
+		this->randomBoards = DEFAULT_RANDOM_BOARDS;  // No random boards unless asked for
+		this->randomBoardSize = DEFAULT_RANDOM_BOARD_SIZE;
+		this->randomSeed = DEFAULT_RANDOM_SEED;
+		this->checkpoint = DEFAULT_CHECKPOINT;
+		this->staticAlgos = DEFAULT_STATIC_ALGOS;
+		this->algoPoolCapacity = DEFAULT_ALGO_POOL_CAPACITY;
+		this->parallelScanMinSquares = DEFAULT_PARALLEL_SCAN_MIN_SQUARES;
+		this->statsInterval = DEFAULT_STATS_INTERVAL;
+		this->resultsExport = DEFAULT_RESULTS_EXPORT;
+		this->ratingSystem = DEFAULT_RATING_SYSTEM;
+		this->tournamentFormat = DEFAULT_TOURNAMENT_FORMAT;
+		this->resultsCache = DEFAULT_RESULTS_CACHE;
+		this->resultsCacheVerify = DEFAULT_RESULTS_CACHE_VERIFY;
+		this->incremental = DEFAULT_INCREMENTAL;
+		this->hotAdd = DEFAULT_HOT_ADD;
+		this->shards = DEFAULT_SHARDS;		   // Single process unless asked for
+		this->shardIndex = NOT_A_SHARD;		   // Only set for shard processes spawned by the coordinator
 	}
 
 	Configuration::Configuration()
@@ -3,6 +3,9 @@
 #include <vector>
 #include <utility>
 #include "Logger.h"
+#include "ResultsExporter.h"
+#include "RatingEngine.h"
+#include "TournamentScheduler.h"
 
 using std::string;
 using std::pair;
@@ -30,6 +33,65 @@ namespace battleship
 		// Severity filter for logger messages
 		Severity logSeverity;
 
+		// Number of random boards to generate in addition to the board files (0 disables generation)
+		int randomBoards;
+
+		// Dimensions of generated random boards, in board file header format: [cols]x[rows]x[depth]
+		string randomBoardSize;
+
+		// Seed for the random boards generator, the same seed reproduces the same boards
+		unsigned int randomSeed;
+
+		// Number of processes the competition games are split between (1 runs the entire competition in-process)
+		int shards;
+
+		// True if completed games are journaled, so an interrupted competition resumes where it stopped
+		bool checkpoint;
+
+		// True if the algorithms compiled into the executable join the competition, and games between them
+		// run a devirtualized game loop (see StaticAlgoRegistry)
+		bool staticAlgos;
+
+		// Number of idle algorithm instances each worker thread keeps for reuse (0 keeps all of them)
+		int algoPoolCapacity;
+
+		// Smallest board (in squares) whose scans the algorithms may split across helper threads
+		int parallelScanMinSquares;
+
+		// Time in milliseconds between two writes of the worker threads' live counters to the stats file (0 disables)
+		int statsInterval;
+
+		// Format the competition results are exported in (NONE disables the export)
+		ResultsFormat resultsExport;
+
+		// Rating system the standings are ordered by
+		RatingSystem ratingSystem;
+
+		// Format of the competition (which games are played)
+		TournamentFormat tournamentFormat;
+
+		// True if the results of games are cached on disk, so games already played by earlier competitions
+		// (same algorithm binaries, board and seed) aren't played again (see ResultsCache)
+		bool resultsCache;
+
+		// One of every resultsCacheVerify games found in the results cache is played anyway, to verify the cached
+		// results still reproduce (0 never verifies)
+		int resultsCacheVerify;
+
+		// True if the competition only plays the games of algorithms and boards that changed since the last
+		// competition completed in the path, and reuses the results of all other games (see CompetitionManifest)
+		bool incremental;
+
+		// True if board files and algorithm dlls that appear in the path while a round robin competition runs join
+		// the competition (see ResourceWatcher)
+		bool hotAdd;
+
+		// Index of the shard this process plays, or NOT_A_SHARD if this process isn't a shard of a bigger competition
+		int shardIndex;
+
+		// Value of shardIndex for processes that aren't shards
+		static constexpr int NOT_A_SHARD = -1;
+
 		// List of textual warnings (if any) for incorrect configuration setup.
 		// The configuration object accumulates these since nothing is loaded in the app yet,
 		// including the logger.
@@ -53,12 +115,69 @@ namespace battleship
 		// Default logger severity
 		static constexpr Severity DEFAULT_SEVERITY = Severity::INFO_LEVEL;
 
+		// Default amount of random boards
+		static constexpr int DEFAULT_RANDOM_BOARDS = 0;
+
+		// Default dimensions of random boards
+		static constexpr auto DEFAULT_RANDOM_BOARD_SIZE = "10x10x1";
+
+		// Default seed of random boards generator
+		static constexpr unsigned int DEFAULT_RANDOM_SEED = 0;
+
+		// Default amount of shards
+		static constexpr int DEFAULT_SHARDS = 1;
+
+		// Default checkpoint mode
+		static constexpr bool DEFAULT_CHECKPOINT = true;
+
+		// Default mode of compiled-in algorithms
+		static constexpr bool DEFAULT_STATIC_ALGOS = false;
+
+		// Default capacity of the worker threads' algorithm pools (no limit)
+		static constexpr int DEFAULT_ALGO_POOL_CAPACITY = 0;
+
+		// Default smallest board scanned in parallel (LayerTaskPool::DEFAULT_MIN_PARALLEL_SQUARES, 32x32x32 and up)
+		static constexpr int DEFAULT_PARALLEL_SCAN_MIN_SQUARES = 1 << 15;
+
+		// Default interval of the worker stats file (disabled)
+		static constexpr int DEFAULT_STATS_INTERVAL = 0;
+
+		// Default results export format (disabled)
+		static constexpr ResultsFormat DEFAULT_RESULTS_EXPORT = ResultsFormat::NONE;
+
+		// Default rating system of the standings (win percentage)
+		static constexpr RatingSystem DEFAULT_RATING_SYSTEM = RatingSystem::WIN_PERCENTAGE;
+
+		// Default competition format (round robin)
+		static constexpr TournamentFormat DEFAULT_TOURNAMENT_FORMAT = TournamentFormat::ROUND_ROBIN;
+
+		// Default results cache mode (disabled)
+		static constexpr bool DEFAULT_RESULTS_CACHE = false;
+
+		// Default sampling interval of the results cache verification
+		static constexpr int DEFAULT_RESULTS_CACHE_VERIFY = 20;
+
+		// Default incremental mode (disabled)
+		static constexpr bool DEFAULT_INCREMENTAL = false;
+
+		// Default hot-add mode (disabled)
+		static constexpr bool DEFAULT_HOT_ADD = false;
+
 		// Maximum number of arguments in a legal command line
-		static constexpr int MAX_ARG_COUNT = 4;
+		static constexpr int MAX_ARG_COUNT = 8;
+
+		// First character of all command line keywords
+		static constexpr char BP_CONFIG_ARG_MARKER = '-';
 
 		// Header of threads arg in command line
 		static constexpr char* BP_CONFIG_THREADS = "-threads";
 
+		// Header of shards count arg in command line
+		static constexpr char* BP_CONFIG_SHARDS = "-shards";
+
+		// Header of shard index arg in command line (used internally when spawning shard processes)
+		static constexpr char* BP_CONFIG_SHARD_INDEX = "-shard";
+
 		// Header of dlls / boards path arg in configuration file
 		static constexpr auto CONFIG_HEADER_PATH = "PATH=";
 
@@ -68,6 +187,54 @@ namespace battleship
 		// Header of log level arg in configuration file
 		static constexpr auto CONFIG_HEADER_LOGLEVEL = "LOG_LEVEL=";
 
+		// Header of random boards count arg in configuration file
+		static constexpr auto CONFIG_HEADER_RANDOM_BOARDS = "RANDOM_BOARDS=";
+
+		// Header of random boards dimensions arg in configuration file
+		static constexpr auto CONFIG_HEADER_RANDOM_BOARD_SIZE = "RANDOM_BOARD_SIZE=";
+
+		// Header of random boards seed arg in configuration file
+		static constexpr auto CONFIG_HEADER_RANDOM_SEED = "RANDOM_SEED=";
+
+		// Header of shards count arg in configuration file
+		static constexpr auto CONFIG_HEADER_SHARDS = "SHARDS=";
+
+		// Header of checkpoint mode arg in configuration file
+		static constexpr auto CONFIG_HEADER_CHECKPOINT = "CHECKPOINT=";
+
+		// Header of compiled-in algorithms mode arg in configuration file
+		static constexpr auto CONFIG_HEADER_STATIC_ALGOS = "STATIC_ALGOS=";
+
+		// Header of algorithm pool capacity arg in configuration file
+		static constexpr auto CONFIG_HEADER_ALGO_POOL_CAPACITY = "ALGO_POOL_CAPACITY=";
+
+		// Header of parallel scan threshold arg in configuration file
+		static constexpr auto CONFIG_HEADER_PARALLEL_SCAN_MIN_SQUARES = "PARALLEL_SCAN_MIN_SQUARES=";
+
+		// Header of worker stats interval arg in configuration file
+		static constexpr auto CONFIG_HEADER_STATS_INTERVAL = "STATS_INTERVAL=";
+
+		// Header of results export format arg in configuration file
+		static constexpr auto CONFIG_HEADER_RESULTS_EXPORT = "RESULTS_EXPORT=";
+
+		// Header of standings rating system arg in configuration file
+		static constexpr auto CONFIG_HEADER_RATING_SYSTEM = "RATING_SYSTEM=";
+
+		// Header of competition format arg in configuration file
+		static constexpr auto CONFIG_HEADER_TOURNAMENT_FORMAT = "TOURNAMENT_FORMAT=";
+
+		// Header of results cache mode arg in configuration file
+		static constexpr auto CONFIG_HEADER_RESULTS_CACHE = "RESULTS_CACHE=";
+
+		// Header of results cache verification interval arg in configuration file
+		static constexpr auto CONFIG_HEADER_RESULTS_CACHE_VERIFY = "RESULTS_CACHE_VERIFY=";
+
+		// Header of incremental mode arg in configuration file
+		static constexpr auto CONFIG_HEADER_INCREMENTAL = "INCREMENTAL=";
+
+		// Header of hot-add mode arg in configuration file
+		static constexpr auto CONFIG_HEADER_HOT_ADD = "HOT_ADD=";
+
 		// Beginning of comments in config file - to be ignored by the parser
 		static constexpr auto CONFIG_HEADER_COMMENT = "%%";
 
@@ -79,6 +246,11 @@ namespace battleship
 		 */
 		bool loadConfigFile();
 
+		/** Parses the integer value that follows the command line keyword at argIndex into value.
+		 *  Returns false (and records the issue) if the value is missing, not an integer or smaller than minVal.
+		 */
+		bool parseIntArg(int argc, char* argv[], int argIndex, const string& argName, int minVal, int& value);
+
 		/** Loads default values for configuration (last fallback) */
 		void loadDefaults();
 
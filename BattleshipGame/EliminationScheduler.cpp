@@ -0,0 +1,101 @@
+#include "EliminationScheduler.h"
+#include "SwissScheduler.h"
+#include <algorithm>
+#include <numeric>
+
+namespace battleship
+{
+	EliminationScheduler::EliminationScheduler(const vector<string>& players, const vector<string>& boards,
+											   vector<size_t> boardsOrder, Scoreboard& scoreboard, int maxLosses) :
+		StagedTournamentScheduler(players, boards, std::move(boardsOrder), scoreboard),
+		_maxLosses(maxLosses),
+		_losses(players.size(), 0),
+		_seeds(players.size())
+	{
+		std::iota(_seeds.begin(), _seeds.end(), static_cast<size_t>(0));
+		std::sort(_seeds.begin(), _seeds.end(),
+				  [&players](size_t player1, size_t player2) { return players[player1] < players[player2]; });
+	}
+
+	size_t EliminationScheduler::roundsCount(size_t playersCount, int maxLosses)
+	{
+		// A single elimination bracket halves the players every round, same as the rounds of a Swiss tournament
+		return (maxLosses == 1) ? SwissScheduler::roundsCount(playersCount) : 0;
+	}
+
+	size_t EliminationScheduler::unpairedMatchesCount(size_t currentRoundMatchesCount) const
+	{
+		// Every match costs a player one loss, and the tournament ends when all players but one ran out of losses
+		size_t survivorsCount = 0;
+		size_t lossesLeft = 0;
+		for (int losses : _losses)
+		{
+			if (losses < _maxLosses)
+			{
+				survivorsCount++;
+				lossesLeft += _maxLosses - losses;
+			}
+		}
+
+		if (survivorsCount < 2)
+			return 0;
+
+		size_t maxMatchesLeft = lossesLeft - 1;
+		return (maxMatchesLeft > currentRoundMatchesCount) ? (maxMatchesLeft - currentRoundMatchesCount) : 0;
+	}
+
+	size_t EliminationScheduler::matchWinner(const Match& match) const
+	{
+		if (match.player1Wins != match.player2Wins)
+			return (match.player1Wins > match.player2Wins) ? match.player1 : match.player2;
+
+		if (match.player1Points != match.player2Points)
+			return (match.player1Points > match.player2Points) ? match.player1 : match.player2;
+
+		// player1 is always the better seed, or the player from the bracket with fewer losses
+		return match.player1;
+	}
+
+	void EliminationScheduler::pairBracket(const vector<size_t>& bracket, vector<pair<size_t, size_t>>& pairings,
+										   vector<size_t>& leftover)
+	{
+		// With an odd number of players the best seed advances without playing
+		size_t first = bracket.size() % 2;
+		if (first == 1)
+			leftover.push_back(bracket[0]);
+
+		for (size_t last = bracket.size() - 1; first < last; first++, last--)
+			pairings.push_back(std::make_pair(bracket[first], bracket[last]));
+	}
+
+	vector<pair<size_t, size_t>> EliminationScheduler::pairNextRound(const vector<Match>& finishedMatches)
+	{
+		for (const auto& match : finishedMatches)
+		{
+			size_t winner = matchWinner(match);
+			_losses[(winner == match.player1) ? match.player2 : match.player1]++;
+		}
+
+		// Players that are still in the tournament, by number of losses (each in seed order)
+		vector<vector<size_t>> brackets(_maxLosses);
+		for (size_t player : _seeds)
+		{
+			if (_losses[player] < _maxLosses)
+				brackets[_losses[player]].push_back(player);
+		}
+
+		vector<pair<size_t, size_t>> pairings;
+		vector<size_t> leftover;
+		for (const auto& bracket : brackets)
+		{
+			if (!bracket.empty())
+				pairBracket(bracket, pairings, leftover);
+		}
+
+		// Every bracket is down to a single player: the brackets' winners play each other (best bracket first)
+		if (pairings.empty() && (leftover.size() >= 2))
+			pairings.push_back(std::make_pair(leftover[0], leftover[1]));
+
+		return pairings;
+	}
+}
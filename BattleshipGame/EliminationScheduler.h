@@ -0,0 +1,57 @@
+#pragma once
+
+#include <vector>
+#include "StagedTournamentScheduler.h"
+
+using std::vector;
+
+namespace battleship
+{
+	/** Knockout tournament: a player is out of the tournament once it lost maxLosses matches (1 for single
+	 *  elimination, 2 for double elimination). The last player left is the winner.
+	 *  Players are seeded by name, in alphabetical order: the bracket is drawn before any game is played, so the
+	 *  scoreboard has no standing to seed by. In every round the players with
+	 *  the same number of losses are paired within their bracket, best seed against worst seed; with an odd number
+	 *  of players in a bracket, its best seed advances without playing. When each bracket is left with a single
+	 *  player, the two play each other (the grand final of a double elimination, replayed if the undefeated player
+	 *  loses it).
+	 *  A match is won by the player who won more of its games, then by points, then by the better seed (or the
+	 *  player from the bracket with fewer losses).
+	 *  Every match costs one player a loss, so the tournament is at most maxLosses * players matches.
+	 */
+	class EliminationScheduler : public StagedTournamentScheduler
+	{
+	public:
+		EliminationScheduler(const vector<string>& players, const vector<string>& boards, vector<size_t> boardsOrder,
+							 Scoreboard& scoreboard, int maxLosses);
+		virtual ~EliminationScheduler() = default;
+
+		/** Number of rounds in a knockout tournament between the given number of players,
+		 *  or 0 if it depends on the results (double elimination)
+		 */
+		static size_t roundsCount(size_t playersCount, int maxLosses);
+
+	protected:
+		vector<pair<size_t, size_t>> pairNextRound(const vector<Match>& finishedMatches) override;
+		size_t unpairedMatchesCount(size_t currentRoundMatchesCount) const override;
+
+	private:
+		/** Number of lost matches that eliminates a player */
+		int _maxLosses;
+
+		/** Number of matches each player lost */
+		vector<int> _losses;
+
+		/** Players ordered by their seed (best first) */
+		vector<size_t> _seeds;
+
+		/** Returns the player who won the match */
+		size_t matchWinner(const Match& match) const;
+
+		/** Pairs the players of a bracket (in seed order) best against worst, and returns the player left unpaired
+		 *  (if any) in leftover
+		 */
+		static void pairBracket(const vector<size_t>& bracket, vector<pair<size_t, size_t>>& pairings,
+								vector<size_t>& leftover);
+	};
+}
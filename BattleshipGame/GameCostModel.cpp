@@ -0,0 +1,82 @@
+#include "GameCostModel.h"
+#include <algorithm>
+
+namespace battleship
+{
+	GameCostModel::GameCostModel() :
+		_averageMovesPerSquare(1.0),
+		_averageEngineMoveLatency(DEFAULT_MOVE_LATENCY_MICROS),
+		_observedGamesCount(0)
+	{
+	}
+
+	void GameCostModel::setBoardVolume(const string& boardName, int volume)
+	{
+		_boardVolumes[boardName] = volume;
+	}
+
+	double GameCostModel::predictBoardGameCost(const string& boardName) const
+	{
+		auto volumeIt = _boardVolumes.find(boardName);
+		double volume = (volumeIt != _boardVolumes.end()) ? volumeIt->second : 1;
+
+		auto movesIt = _boardMovesPerSquare.find(boardName);
+		double movesPerSquare = (movesIt != _boardMovesPerSquare.end()) ? movesIt->second : _averageMovesPerSquare;
+
+		// Every move costs the engine's latency, and the latency of both players (each is called on every move)
+		return volume * movesPerSquare * (2 * averagePlayerMoveLatency() + _averageEngineMoveLatency);
+	}
+
+	void GameCostModel::observeGame(const string& playerAName, const string& playerBName, const string& boardName,
+									const GameResults& results)
+	{
+		// Cached results weren't played, so they have no algorithm time
+		if ((results.moves <= 0) || (results.algoMicros <= 0))
+			return;
+
+		double moves = results.moves;
+		updateEstimate(_playerMoveLatencies, playerAName, results.playerAAlgoMicros / moves);
+		updateEstimate(_playerMoveLatencies, playerBName, (results.algoMicros - results.playerAAlgoMicros) / moves);
+
+		auto volumeIt = _boardVolumes.find(boardName);
+		double movesPerSquare = moves / ((volumeIt != _boardVolumes.end()) ? std::max(volumeIt->second, 1) : 1);
+		updateEstimate(_boardMovesPerSquare, boardName, movesPerSquare);
+
+		_observedGamesCount++;
+		updateAverage(_averageMovesPerSquare, movesPerSquare);
+		updateAverage(_averageEngineMoveLatency,
+					  std::max(results.durationMicros - results.algoMicros, 0LL) / moves);
+	}
+
+	size_t GameCostModel::observedGamesCount() const
+	{
+		return _observedGamesCount;
+	}
+
+	double GameCostModel::averagePlayerMoveLatency() const
+	{
+		if (_playerMoveLatencies.empty())
+			return DEFAULT_MOVE_LATENCY_MICROS;
+
+		double latenciesSum = 0;
+		for (const auto& latency : _playerMoveLatencies)
+			latenciesSum += latency.second;
+
+		return latenciesSum / _playerMoveLatencies.size();
+	}
+
+	void GameCostModel::updateEstimate(unordered_map<string, double>& estimates, const string& key, double value)
+	{
+		auto estimateIt = estimates.find(key);
+		if (estimateIt == estimates.end())
+			estimates.emplace(key, value);
+		else
+			estimateIt->second += SMOOTHING * (value - estimateIt->second);
+	}
+
+	void GameCostModel::updateAverage(double& average, double value) const
+	{
+		// The first game observed replaces the defaults
+		average = (_observedGamesCount == 1) ? value : (average + (value - average) / _observedGamesCount);
+	}
+}
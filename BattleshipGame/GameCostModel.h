@@ -0,0 +1,75 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include "GameManager.h"
+
+using std::string;
+using std::unordered_map;
+
+namespace battleship
+{
+	/** Predicts how long the games on a board would take, so the boards with the longest games can be dealt first.
+	 *  A game costs the number of moves made on its board times the time each move takes: the latency of the
+	 *  players' algorithms and of the engine.
+	 *  Moves per board square and move latencies are learned from the games played. Before any game is played, the
+	 *  number of moves is assumed to be the board's volume and all latencies to be equal - so the first predictions
+	 *  are ordered by board volume alone.
+	 *  This class isn't thread safe.
+	 */
+	class GameCostModel
+	{
+	public:
+		GameCostModel();
+		virtual ~GameCostModel() = default;
+
+		/** Sets the number of squares of the given board */
+		void setBoardVolume(const string& boardName, int volume);
+
+		/** Predicted cost (in micros, or arbitrary units before any game is observed) of an average game on the
+		 *  given board, between players whose latency is the average of all players observed.
+		 *  Unknown boards are assumed to be of volume 1.
+		 */
+		double predictBoardGameCost(const string& boardName) const;
+
+		/** Learns from a game that was played: each player is credited with the time spent in its own algorithm,
+		 *  and the board with the number of moves made on it.
+		 *  Games without moves (e.g. failed games and cached results) are ignored.
+		 */
+		void observeGame(const string& playerAName, const string& playerBName, const string& boardName,
+						 const GameResults& results);
+
+		/** Number of games observed so far */
+		size_t observedGamesCount() const;
+
+	private:
+		/** Weight of a newly observed game in an estimate (exponential moving average) */
+		static constexpr double SMOOTHING = 0.25;
+
+		/** Latency assumed for each move before any game is observed */
+		static constexpr double DEFAULT_MOVE_LATENCY_MICROS = 1.0;
+
+		unordered_map<string, int> _boardVolumes;
+
+		/** Estimated number of moves per square of each observed board */
+		unordered_map<string, double> _boardMovesPerSquare;
+
+		/** Estimated micros each observed player spends per move of its games */
+		unordered_map<string, double> _playerMoveLatencies;
+
+		/** Averages of all games observed, used for the boards that weren't observed yet */
+		double _averageMovesPerSquare;
+		double _averageEngineMoveLatency;
+
+		size_t _observedGamesCount;
+
+		/** Average latency estimate of all observed players */
+		double averagePlayerMoveLatency() const;
+
+		/** Folds an observed value into an estimate */
+		static void updateEstimate(unordered_map<string, double>& estimates, const string& key, double value);
+
+		/** Folds an observed value into the running average of all games observed */
+		void updateAverage(double& average, double value) const;
+	};
+}
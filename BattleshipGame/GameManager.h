@@ -1,11 +1,21 @@
 #pragma once
 
 #include <memory>
+#include <exception>
+#include <string>
+#include <chrono>
 #include "BattleBoard.h"
 #include "IBattleshipGameAlgo.h"
+#include "AlgoCommon.h"
+#include "BoardDims.h"
+#include "Logger.h"
+#include "LatencyHistogram.h"
 
 using std::shared_ptr;
 using std::unique_ptr;
+using std::string;
+using std::exception;
+using std::chrono::steady_clock;
 
 namespace battleship
 {
@@ -18,6 +28,10 @@ namespace battleship
 		PlayerEnum winner;
 		int playerAPoints;
 		int playerBPoints;
+		int moves;				// Number of attack moves both players made (including illegal ones)
+		long long durationMicros;	// Wall time of the game, including the time to fetch the game's resources
+		long long algoMicros;		// Part of the game's wall time spent inside the players' algorithms
+		long long playerAAlgoMicros;	// Part of algoMicros spent inside player A's algorithm (the rest is player B's)
 	};
 
 	/** Manages a session of a single game, in stateless manner to enable thread-saftey */
@@ -26,13 +40,33 @@ namespace battleship
 	public:
 		virtual ~GameManager() = delete; // Shouldn't be instantiated / destroyed anymore (stateless class)
 
+		/** Typedef for a game loop (runGame, or a variant of it for specific kinds of players) */
+		using GameRunnerFuncType = GameResults(*)(shared_ptr<BattleBoard> board,
+												  IBattleshipGameAlgo* playerA,
+												  IBattleshipGameAlgo* playerB,
+												  const BoardData& playerAView,
+												  const BoardData& playerBView);
+
 		/** Starts a new game session using the given board, between the 2 players algorithms.
+		 *  The results are returned by value, so a game doesn't allocate them on the heap.
+		 */
+		static GameResults runGame(shared_ptr<BattleBoard> board,
+								   IBattleshipGameAlgo* playerA,
+								   IBattleshipGameAlgo* playerB,
+								   const BoardData& playerAView,
+								   const BoardData& playerBView);
+
+		/** Same as runGame, for players whose algorithm types are known at compile time.
+		 *  When PlayerAAlgo / PlayerBAlgo are final classes, the calls to the algorithms are resolved statically
+		 *  (and may be inlined) instead of going through the IBattleshipGameAlgo vtable.
+		 *  runGame is this method instantiated with IBattleshipGameAlgo for both players.
 		 */
-		static unique_ptr<GameResults> runGame(shared_ptr<BattleBoard> board,
-											   IBattleshipGameAlgo* playerA,
-											   IBattleshipGameAlgo* playerB,
-											   const BoardData& playerAView,
-											   const BoardData& playerBView);
+		template <typename PlayerAAlgo, typename PlayerBAlgo>
+		static GameResults runTypedGame(shared_ptr<BattleBoard> board,
+										PlayerAAlgo& playerA,
+										PlayerBAlgo& playerB,
+										const BoardData& playerAView,
+										const BoardData& playerBView);
 
 	private:
 		/** Hide the ctor - this class is multithreaded because it's stateless and thus lockless */
@@ -44,13 +78,36 @@ namespace battleship
 		/** Returns if both player forfeit or anybody have won */
 		static bool isGameOver(const BattleBoard* board, bool isPlayerAForfeit, bool isPlayerBForfeit);
 
-		/** Takes into consideration the current game state and points currPlayer to the next player who
-		 *  should be playing
+		/** Takes into consideration the current game state and returns true if the next player who
+		 *  should be playing is player A (false for player B)
+		 */
+		static bool switchPlayerTurns(bool isCurrPlayerA, const GamePiece* lastAttackedPiece,
+									  bool isPlayerAForfeit, bool isPlayerBForfeit);
+
+		/** The move loop of runTypedGame, with the board's dimensions (see dispatchBoardDims), so the common board
+		 *  shapes get their attack bounds checks with constant dimensions.
+		 *  Returns the game's winner, points and moves, and adds the time spent in each player's code to its
+		 *  algorithm time.
+		 */
+		template <typename Dims, typename PlayerAAlgo, typename PlayerBAlgo>
+		static GameResults playMoves(const Dims& dims,
+									 BattleBoard* board,
+									 PlayerAAlgo& playerA,
+									 PlayerBAlgo& playerB,
+									 AlgoCallLatencies* playerALatencies,
+									 AlgoCallLatencies* playerBLatencies,
+									 steady_clock::duration& playerAAlgoTime,
+									 steady_clock::duration& playerBAlgoTime);
+
+		/** Returns the results of a game that finished unexpectedly: a tie where nobody gets points */
+		static GameResults faultedGameResults(const exception& e);
+
+		/** Adds the time since callStartTime to the algorithm time of a player, and records it in the histogram
+		 *  (unless it's NULL). Returns the time the call ended, so consecutive calls need a single clock read.
 		 */
-		static IBattleshipGameAlgo* switchPlayerTurns(IBattleshipGameAlgo* playerA, IBattleshipGameAlgo* playerB,
-													  IBattleshipGameAlgo* currPlayer,
-													  shared_ptr<const GamePiece> lastAttackedPiece,
-													  bool isPlayerAForfeit, bool isPlayerBForfeit);
+		static steady_clock::time_point recordAlgoCall(steady_clock::time_point callStartTime,
+													   steady_clock::duration& algoTime,
+													   LatencyHistogram* histogram);
 
 		/** Updates the game points when a game piece have been sank */
 		static void updateCurrentGamePoints(const GamePiece *const sankPiece, int& playerAScore, int& playerBScore);
@@ -58,4 +115,166 @@ namespace battleship
 		/** Fetch the winning player from the board according to the final game state */
 		static PlayerEnum GameManager::getWinner(const BattleBoard *const board);
 	};
+
+	template <typename PlayerAAlgo, typename PlayerBAlgo>
+	GameResults GameManager::runTypedGame(shared_ptr<BattleBoard> board,
+										  PlayerAAlgo& playerA,
+										  PlayerBAlgo& playerB,
+										  const BoardData& playerAView,
+										  const BoardData& playerBView)
+	{
+		try
+		{
+			// Time spent in each player's code, the rest of the game's time is spent by the engine.
+			// Call latencies are also recorded per player, if the game is played within a GameLatencyScope
+			AlgoCallLatencies* playerALatencies = GameLatencyScope::playerALatencies();
+			AlgoCallLatencies* playerBLatencies = GameLatencyScope::playerBLatencies();
+			steady_clock::duration playerAAlgoTime = steady_clock::duration::zero();
+			steady_clock::duration playerBAlgoTime = steady_clock::duration::zero();
+			auto callStartTime = steady_clock::now();
+
+			playerA.setPlayer(0);
+			callStartTime = recordAlgoCall(callStartTime, playerAAlgoTime, nullptr);
+			playerB.setPlayer(1);
+			callStartTime = recordAlgoCall(callStartTime, playerBAlgoTime, nullptr);
+
+			playerA.setBoard(playerAView);
+			callStartTime = recordAlgoCall(callStartTime, playerAAlgoTime,
+										   (playerALatencies != nullptr) ? &playerALatencies->setBoard : nullptr);
+			playerB.setBoard(playerBView);
+			recordAlgoCall(callStartTime, playerBAlgoTime,
+						   (playerBLatencies != nullptr) ? &playerBLatencies->setBoard : nullptr);
+
+			GameResults results = dispatchBoardDims(board->height(), board->width(), board->depth(),
+				[&board, &playerA, &playerB, playerALatencies, playerBLatencies, &playerAAlgoTime,
+				 &playerBAlgoTime](const auto& dims)
+			{
+				return playMoves(dims, board.get(), playerA, playerB, playerALatencies, playerBLatencies,
+								 playerAAlgoTime, playerBAlgoTime);
+			});
+
+			results.durationMicros = 0;
+			results.algoMicros = std::chrono::duration_cast<std::chrono::microseconds>(playerAAlgoTime +
+																					  playerBAlgoTime).count();
+			results.playerAAlgoMicros = std::chrono::duration_cast<std::chrono::microseconds>(playerAAlgoTime).count();
+
+			return results;
+		}
+		catch (const exception& e)
+		{	// Protect game session from failing.
+			// This is possible if one of the players causes a fault.
+			return faultedGameResults(e);
+		}
+	}
+
+	template <typename Dims, typename PlayerAAlgo, typename PlayerBAlgo>
+	GameResults GameManager::playMoves(const Dims& dims,
+									   BattleBoard* board,
+									   PlayerAAlgo& playerA,
+									   PlayerBAlgo& playerB,
+									   AlgoCallLatencies* playerALatencies,
+									   AlgoCallLatencies* playerBLatencies,
+									   steady_clock::duration& playerAAlgoTime,
+									   steady_clock::duration& playerBAlgoTime)
+	{
+		// Per move debug messages are only formatted if they are going to be logged
+		const bool isLogMoves = Logger::getInstance().isLoggable(Severity::DEBUG_LEVEL);
+
+		bool isCurrPlayerA = true;
+		bool isPlayerAForfeit = false;
+		bool isPlayerBForfeit = false;
+		int playerAPoints = 0;
+		int playerBPoints = 0;
+		int moves = 0;
+		steady_clock::time_point callStartTime;
+
+		while (!isGameOver(board, isPlayerAForfeit, isPlayerBForfeit))
+		{
+			// Attack
+			callStartTime = steady_clock::now();
+			auto target = isCurrPlayerA ? playerA.attack() : playerB.attack();
+			AlgoCallLatencies* attackerLatencies = isCurrPlayerA ? playerALatencies : playerBLatencies;
+			recordAlgoCall(callStartTime, isCurrPlayerA ? playerAAlgoTime : playerBAlgoTime,
+						   (attackerLatencies != nullptr) ? &attackerLatencies->attack : nullptr);
+			moves++;
+			string currPlayerStr = isCurrPlayerA ? "A" : "B";
+			if (isLogMoves)
+				Logger::getInstance().log(Severity::DEBUG_LEVEL, "Player " + currPlayerStr + " attacks at " + to_string(target));
+
+			if (target == NO_MORE_MOVES)
+			{	// Player chose not to attack - from now on this player forfeits the game
+				if (isCurrPlayerA)
+					isPlayerAForfeit = true;
+				else
+					isPlayerBForfeit = true;
+
+				if (isLogMoves)
+					Logger::getInstance().log(Severity::DEBUG_LEVEL,
+											  "Player " + currPlayerStr + " has no more moves.");
+				isCurrPlayerA = switchPlayerTurns(isCurrPlayerA, nullptr, isPlayerAForfeit, isPlayerBForfeit);
+				continue;
+			}
+			else if (!dims.isOnBoard(target))
+			{	// Player performed an illegal move and will lose his turn
+				if (isLogMoves)
+					Logger::getInstance().log(Severity::DEBUG_LEVEL,
+											  "Player " + currPlayerStr + " tried to perform an invalid attack - loses turn.");
+
+				isCurrPlayerA = switchPlayerTurns(isCurrPlayerA, nullptr, isPlayerAForfeit, isPlayerBForfeit);
+				continue;
+			}
+
+			// Normalize coordinates to 0~BOARD_SIZE-1
+			Coordinate normalizedTarget{ target.row - 1, target.col - 1, target.depth - 1 };
+
+			// Execute attack move on the board itself and update the game-pieces status
+			// We get in return an object that describes the result of the attack
+			auto attackedGamePiece = board->executeAttack(normalizedTarget);
+
+			// Notify on attack results
+			int attackingPlayerNumber = isCurrPlayerA ? 0 : 1; // A - 0, B - 1
+			AttackResult attackResult;
+			string attackResultStr;
+
+			if (attackedGamePiece == nullptr)
+			{	// Miss
+				attackResult = AttackResult::Miss;
+				attackResultStr = "Miss";
+			}
+			else if (attackedGamePiece->_lifeLeft == 0)
+			{	// Sink
+				attackResult = AttackResult::Sink;
+				attackResultStr = "Sink";
+				updateCurrentGamePoints(attackedGamePiece.get(), playerAPoints, playerBPoints);
+			}
+			else
+			{	// Hit
+				attackResult = AttackResult::Hit;
+				attackResultStr = "Hit";
+			}
+
+			isCurrPlayerA = switchPlayerTurns(isCurrPlayerA, attackedGamePiece.get(),
+											  isPlayerAForfeit, isPlayerBForfeit);
+
+			callStartTime = steady_clock::now();
+			playerA.notifyOnAttackResult(attackingPlayerNumber, target, attackResult);
+			callStartTime = recordAlgoCall(callStartTime, playerAAlgoTime,
+										   (playerALatencies != nullptr) ? &playerALatencies->notifyOnAttackResult : nullptr);
+			playerB.notifyOnAttackResult(attackingPlayerNumber, target, attackResult);
+			recordAlgoCall(callStartTime, playerBAlgoTime,
+						   (playerBLatencies != nullptr) ? &playerBLatencies->notifyOnAttackResult : nullptr);
+			if (isLogMoves)
+				Logger::getInstance().log(Severity::DEBUG_LEVEL, "Attack result: " + attackResultStr);
+		}
+
+		auto winner = getWinner(board);
+
+		GameResults results;
+		results.winner = winner;
+		results.playerAPoints = playerAPoints;
+		results.playerBPoints = playerBPoints;
+		results.moves = moves;
+
+		return results;
+	}
 }
@@ -0,0 +1,139 @@
+#include "GameRecord.h"
+#include "IOUtil.h"
+#include "Logger.h"
+#include <string>
+
+using std::to_string;
+using std::lock_guard;
+using std::ifstream;
+
+namespace battleship
+{
+	GameRecord::GameRecord(size_t aTaskId, const string& aPlayerAName, const string& aPlayerBName,
+						   const string& aBoardName, const GameResults& aResults) :
+		taskId(aTaskId),
+		playerAName(aPlayerAName),
+		playerBName(aPlayerBName),
+		boardName(aBoardName),
+		results(aResults)
+	{
+	}
+
+	string GameRecord::toLine() const
+	{
+		return to_string(taskId) + FIELD_SEPARATOR +
+			   playerAName + FIELD_SEPARATOR +
+			   playerBName + FIELD_SEPARATOR +
+			   boardName + FIELD_SEPARATOR +
+			   to_string(static_cast<int>(results.winner)) + FIELD_SEPARATOR +
+			   to_string(results.playerAPoints) + FIELD_SEPARATOR +
+			   to_string(results.playerBPoints) + FIELD_SEPARATOR +
+			   to_string(results.moves);
+	}
+
+	bool GameRecord::fromLine(const string& line, GameRecord& record)
+	{
+		vector<string> fields;
+		size_t fieldStart = 0;
+		size_t separatorPos;
+
+		while ((separatorPos = line.find(FIELD_SEPARATOR, fieldStart)) != string::npos)
+		{
+			fields.push_back(line.substr(fieldStart, separatorPos - fieldStart));
+			fieldStart = separatorPos + 1;
+		}
+		fields.push_back(line.substr(fieldStart));
+
+		bool isLegacyLine = (fields.size() == LEGACY_FIELDS_COUNT);
+		if (((fields.size() != FIELDS_COUNT) && !isLegacyLine) ||
+			!IOUtil::isInteger(fields[0]) || !IOUtil::isInteger(fields[4]) ||
+			!IOUtil::isInteger(fields[5]) || !IOUtil::isInteger(fields[6]) ||
+			(!isLegacyLine && !IOUtil::isInteger(fields[7])))
+		{
+			return false;
+		}
+
+		int winner = std::stoi(fields[4]);
+		if ((winner < static_cast<int>(PlayerEnum::A)) || (winner > static_cast<int>(PlayerEnum::NONE)))
+			return false;
+
+		record.taskId = static_cast<size_t>(std::stoull(fields[0]));
+		record.playerAName = fields[1];
+		record.playerBName = fields[2];
+		record.boardName = fields[3];
+		record.results.winner = static_cast<PlayerEnum>(winner);
+		record.results.playerAPoints = std::stoi(fields[5]);
+		record.results.playerBPoints = std::stoi(fields[6]);
+		record.results.moves = isLegacyLine ? 0 : std::stoi(fields[7]);
+
+		return true;
+	}
+
+	vector<GameRecord> GameRecord::readAll(const string& filename)
+	{
+		vector<GameRecord> records;
+
+		// A missing file simply means no games were recorded yet
+		if (!ifstream(filename).good())
+			return records;
+
+		int malformedLines = 0;
+		auto lineParser = [&records, &malformedLines](string& nextLine)
+		{
+			if (nextLine.empty() || (nextLine[0] == COMMENT_MARKER))
+				return;
+
+			GameRecord record(0, "", "", "", GameResults{ PlayerEnum::NONE, 0, 0, 0, 0, 0, 0 });
+			if (fromLine(nextLine, record))
+				records.push_back(std::move(record));
+			else
+				malformedLines++;
+		};
+
+		IOUtil::parseFile(filename, lineParser);
+
+		if (malformedLines > 0)
+		{
+			Logger::getInstance().log(Severity::WARNING_LEVEL,
+									  "Skipped " + to_string(malformedLines) + " malformed game records in " + filename);
+		}
+
+		return records;
+	}
+
+	GameRecordWriter::GameRecordWriter(const string& filename, bool isAppend) :
+		_filename(filename),
+		_fs(filename, isAppend ? (std::ofstream::out | std::ofstream::app) : std::ofstream::out)
+	{
+		if (!_fs.is_open())
+		{
+			Logger::getInstance().log(Severity::ERROR_LEVEL, "Failed to open game records file " + filename);
+		}
+	}
+
+	GameRecordWriter::~GameRecordWriter()
+	{
+		_fs.close();
+	}
+
+	bool GameRecordWriter::isOpen() const
+	{
+		return _fs.is_open();
+	}
+
+	void GameRecordWriter::write(const GameRecord& record)
+	{
+		lock_guard<mutex> lock(_writeLock);
+
+		if (!_fs.is_open())
+			return;
+
+		// Flush every record, so a crash loses at most the game that was being written
+		_fs << record.toLine() << std::endl;
+
+		if (!_fs)
+		{
+			Logger::getInstance().log(Severity::ERROR_LEVEL, "IO error when writing game records to " + _filename);
+		}
+	}
+}
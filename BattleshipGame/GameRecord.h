@@ -0,0 +1,77 @@
+#pragma once
+
+#include <fstream>
+#include <mutex>
+#include <vector>
+#include "GameManager.h"
+
+using std::string;
+using std::vector;
+using std::ofstream;
+using std::mutex;
+
+namespace battleship
+{
+	/** The outcome of a single competition game, identified by the game's task id.
+	 *  Records are written to disk so games played by other processes (or in earlier runs) can be merged
+	 *  back into the scoreboard.
+	 */
+	struct GameRecord
+	{
+		size_t taskId;
+		string playerAName;
+		string playerBName;
+		string boardName;
+		GameResults results;
+
+		GameRecord(size_t aTaskId, const string& aPlayerAName, const string& aPlayerBName,
+				   const string& aBoardName, const GameResults& aResults);
+
+		/** Serializes the record into a single tab separated line (without the line break) */
+		string toLine() const;
+
+		/** Parses a line created by toLine(). Returns false if the line is malformed. */
+		static bool fromLine(const string& line, GameRecord& record);
+
+		/** Reads all well-formed records from the given file. Malformed lines (e.g. a line cut by a crash) are skipped,
+		 *  as are comment lines (starting with COMMENT_MARKER). If the file doesn't exist an empty list is returned.
+		 */
+		static vector<GameRecord> readAll(const string& filename);
+
+		/** Lines beginning with this character aren't records, they may be used for headers */
+		static constexpr char COMMENT_MARKER = '#';
+
+	private:
+		/** Separates the fields of a record line */
+		static constexpr char FIELD_SEPARATOR = '\t';
+
+		/** Number of fields in a record line */
+		static constexpr int FIELDS_COUNT = 8;
+
+		/** Number of fields in a record line written before the moves were recorded (their moves are read as 0) */
+		static constexpr int LEGACY_FIELDS_COUNT = 7;
+	};
+
+	/** Thread safe writer of game records into a file, one record per line */
+	class GameRecordWriter
+	{
+	public:
+		/** Opens the file for writing. If isAppend is false the file is truncated first. */
+		GameRecordWriter(const string& filename, bool isAppend);
+		virtual ~GameRecordWriter();
+
+		GameRecordWriter(GameRecordWriter const&) = delete;	// Disable copying
+		GameRecordWriter& operator=(GameRecordWriter const&) = delete;	// Disable copying (assignment)
+
+		/** Returns true if the file was opened successfully */
+		bool isOpen() const;
+
+		/** Writes a single record and flushes it to disk */
+		void write(const GameRecord& record);
+
+	private:
+		string _filename;
+		ofstream _fs;
+		mutex _writeLock;
+	};
+}
@@ -0,0 +1,216 @@
+#include "GameTaskCursor.h"
+#include <algorithm>
+
+using std::lock_guard;
+
+namespace battleship
+{
+	CompetitionShard::CompetitionShard() : index(0), count(1)
+	{
+	}
+
+	CompetitionShard::CompetitionShard(int aIndex, int aCount) : index(aIndex), count(aCount)
+	{
+	}
+
+	bool CompetitionShard::isOwnerOf(size_t taskId) const
+	{
+		return (taskId % count) == static_cast<size_t>(index);
+	}
+
+	GameTaskCursor::GameTaskCursor(const vector<string>& players, const vector<string>& boards,
+								   GameCostModel costModel, CompetitionShard shard) :
+		_players(players),
+		_boards(boards),
+		_shard(shard),
+		_boardGamesCount(players.size() * (players.size() - 1) / 2),
+		_forwardGamesCount(_boardGamesCount * boards.size()),
+		_completedGamesCount(0),
+		_bucketNextGames(new atomic<size_t>[boards.size()]),
+		_currentBucket(0),
+		_isBucketStarted(boards.size(), false),
+		_startedBucketsCount(0),
+		_costModel(std::move(costModel))
+	{
+		// Round #r is the r-th diagonal above the main diagonal of the game matrix, with (players - r) games
+		_roundStarts.push_back(0);
+		for (size_t round = 1; round < players.size(); round++)
+			_roundStarts.push_back(_roundStarts.back() + players.size() - round);
+
+		for (size_t bucket = 0; bucket < bucketsCount(); bucket++)
+			_bucketNextGames[bucket] = 0;
+
+		// Start from the bucket predicted to be the longest (no games were played yet, so the biggest board)
+		size_t firstBucket = nextUnstartedBucket();
+		if (firstBucket < bucketsCount())
+		{
+			_isBucketStarted[firstBucket] = true;
+			_startedBucketsCount = 1;
+		}
+		_currentBucket = firstBucket;
+	}
+
+	size_t GameTaskCursor::gamesCount() const
+	{
+		return 2 * _forwardGamesCount;
+	}
+
+	size_t GameTaskCursor::roundsCount() const
+	{
+		// Every player plays twice against each other player on each board
+		return _players.empty() ? 0 : ((_players.size() - 1) * 2 * _boards.size());
+	}
+
+	size_t GameTaskCursor::ownedGamesCount(size_t taskIdsCount) const
+	{
+		size_t shardIndex = static_cast<size_t>(_shard.index);
+		return (taskIdsCount > shardIndex) ? ((taskIdsCount - shardIndex - 1) / _shard.count + 1) : 0;
+	}
+
+	size_t GameTaskCursor::pendingGamesCount() const
+	{
+		return ownedGamesCount(gamesCount()) - _completedGamesCount;
+	}
+
+	bool GameTaskCursor::isExhausted() const
+	{
+		// When all games were completed elsewhere there's nothing to deal, and no worker would advance the cursor
+		if (pendingGamesCount() == 0)
+			return true;
+
+		size_t bucket = _currentBucket.load();
+		return (bucket >= bucketsCount()) ||
+			   ((_startedBucketsCount.load() == bucketsCount()) && (_bucketNextGames[bucket].load() >= bucketGamesCount()));
+	}
+
+	size_t GameTaskCursor::bucketsCount() const
+	{
+		return _boards.size();
+	}
+
+	size_t GameTaskCursor::bucketGamesCount() const
+	{
+		return 2 * _boardGamesCount;
+	}
+
+	size_t GameTaskCursor::taskIdOf(size_t bucket, size_t gameInBucket) const
+	{
+		// The board's forward games, followed by its inversed games, each in competition order
+		size_t inversedOffset = (gameInBucket >= _boardGamesCount) ? (_forwardGamesCount - _boardGamesCount) : 0;
+		return inversedOffset + bucket * _boardGamesCount + gameInBucket;
+	}
+
+	unique_ptr<SingleGameTask> GameTaskCursor::next()
+	{
+		size_t bucket = _currentBucket.load();
+		while (bucket < bucketsCount())
+		{
+			size_t gameInBucket = _bucketNextGames[bucket]++;
+			if (gameInBucket >= bucketGamesCount())
+			{
+				bucket = startNextBucket(bucket);
+				continue;
+			}
+
+			size_t taskId = taskIdOf(bucket, gameInBucket);
+			if (isPending(taskId))
+				return task(taskId);
+		}
+
+		return nullptr;
+	}
+
+	size_t GameTaskCursor::startNextBucket(size_t finishedBucket)
+	{
+		lock_guard<mutex> lock(_costModelLock);
+
+		size_t currentBucket = _currentBucket.load();
+		if (currentBucket != finishedBucket)
+			return currentBucket;
+
+		size_t nextBucket = nextUnstartedBucket();
+		if (nextBucket < bucketsCount())
+		{
+			_isBucketStarted[nextBucket] = true;
+			_startedBucketsCount++;
+		}
+
+		_currentBucket = nextBucket;
+		return nextBucket;
+	}
+
+	size_t GameTaskCursor::nextUnstartedBucket() const
+	{
+		// All buckets have the same number of games, so the longest bucket is the one whose games are predicted to
+		// be the longest (the first one on ties)
+		size_t nextBucket = bucketsCount();
+		double nextBucketCost = 0;
+		for (size_t bucket = 0; bucket < bucketsCount(); bucket++)
+		{
+			if (_isBucketStarted[bucket])
+				continue;
+
+			double cost = _costModel.predictBoardGameCost(_boards[bucket]);
+			if ((nextBucket == bucketsCount()) || (cost > nextBucketCost))
+			{
+				nextBucket = bucket;
+				nextBucketCost = cost;
+			}
+		}
+
+		return nextBucket;
+	}
+
+	void GameTaskCursor::onGameFinished(const SingleGameTask& task, const GameResults& results)
+	{
+		lock_guard<mutex> lock(_costModelLock);
+		_costModel.observeGame(task.playerAName(), task.playerBName(), task.boardName(), results);
+	}
+
+	unique_ptr<SingleGameTask> GameTaskCursor::task(size_t taskId) const
+	{
+		bool isInversed = (taskId >= _forwardGamesCount);
+		size_t forwardTaskId = isInversed ? (taskId - _forwardGamesCount) : taskId;
+		size_t board = forwardTaskId / _boardGamesCount;
+		size_t gameInBoard = forwardTaskId % _boardGamesCount;
+
+		// Find the round (diagonal) of the game, and the game's position on the diagonal
+		size_t round = std::upper_bound(_roundStarts.begin(), _roundStarts.end(), gameInBoard) - _roundStarts.begin();
+		size_t diagonalPosition = gameInBoard - _roundStarts[round - 1];
+
+		// The diagonal is run over from both of its sides alternately:
+		// even positions from its top, odd positions from its bottom
+		size_t lastPlayer = _players.size() - 1;
+		size_t step = diagonalPosition / 2;
+		size_t player1 = (diagonalPosition % 2 == 0) ? step : (lastPlayer - (step + round));
+		size_t player2 = (diagonalPosition % 2 == 0) ? (step + round) : (lastPlayer - step);
+
+		if (isInversed)
+			std::swap(player1, player2);
+
+		return std::make_unique<SingleGameTask>(taskId, _players[player1], _players[player2], _boards[board]);
+	}
+
+	bool GameTaskCursor::isCompleted(size_t taskId) const
+	{
+		return !_completedGames.empty() && _completedGames[taskId];
+	}
+
+	bool GameTaskCursor::isPending(size_t taskId) const
+	{
+		return (taskId < gamesCount()) && _shard.isOwnerOf(taskId) && !isCompleted(taskId);
+	}
+
+	void GameTaskCursor::markCompleted(size_t taskId)
+	{
+		if (!isPending(taskId))
+			return;
+
+		// Completed games are only tracked once there are some, a bit per game of the competition
+		if (_completedGames.empty())
+			_completedGames.assign(gamesCount(), false);
+
+		_completedGames[taskId] = true;
+		_completedGamesCount++;
+	}
+}
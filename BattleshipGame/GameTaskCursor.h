@@ -0,0 +1,156 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <string>
+#include <mutex>
+#include "SingleGameTask.h"
+#include "TournamentScheduler.h"
+#include "GameCostModel.h"
+
+using std::atomic;
+using std::unique_ptr;
+using std::vector;
+using std::string;
+using std::mutex;
+
+namespace battleship
+{
+	/** Identifies the part of the competition's games a single process is responsible for.
+	 *  Games are dealt to shards by their task id, so the split is deterministic.
+	 */
+	struct CompetitionShard
+	{
+		int index;	// Index of this shard, in the range [0, count-1]
+		int count;	// Total number of shards the competition is split into
+
+		/** Default shard: the entire competition */
+		CompetitionShard();
+		CompetitionShard(int aIndex, int aCount);
+
+		/** Returns true if the game with the given task id belongs to this shard */
+		bool isOwnerOf(size_t taskId) const;
+	};
+
+	/** Deals the games of a round robin competition to the worker threads without materializing them.
+	 *  Every game is derived on demand from its task id - (board, round, position on the round's diagonal) -
+	 *  so the cursor takes memory for the players and boards lists only, no matter how many games there are.
+	 *
+	 *  Competition order (task ids): on each board the games are played round by round, each round being a
+	 *  diagonal in the game matrix (without the main diagonal) that we run over from both sides in order to get a
+	 *  balanced tournament. All games are played once on every board, and then the inversed games (the same games
+	 *  with the players switched places) are played the same way: the inversed game of game #i is
+	 *  game #(i + forwardGamesCount).
+	 *  Games are dealt board by board: the forward and inversed games of a board are a bucket with its own
+	 *  position, which workers advance with a single atomic increment (the forward games first, each half in
+	 *  competition order). When a bucket runs out of games, the next one is the undealt bucket whose games are
+	 *  predicted to take the longest (Longest Processing Time first) - over the whole schedule, so the longest games
+	 *  don't land at the end of the competition and leave threads idle. The predictions are refined with the results
+	 *  of the games played (see GameCostModel).
+	 */
+	class GameTaskCursor : public TournamentScheduler
+	{
+	public:
+		/** Creates a cursor over the games of the given shard of the competition between players on boards.
+		 *  costModel predicts the cost of the boards' games (its board volumes should be set), and learns from the
+		 *  games the cursor dealt.
+		 */
+		GameTaskCursor(const vector<string>& players, const vector<string>& boards, GameCostModel costModel,
+					   CompetitionShard shard);
+		virtual ~GameTaskCursor() = default;
+
+		GameTaskCursor(GameTaskCursor const&) = delete;	// Disable copying
+		GameTaskCursor& operator=(GameTaskCursor const&) = delete;	// Disable copying (assignment)
+
+		/** Number of games in the entire competition (all shards) */
+		size_t gamesCount() const;
+
+		/** Number of rounds each player plays in the entire competition */
+		size_t roundsCount() const;
+
+		/** Number of games of this shard that weren't marked completed (games already dealt included) */
+		size_t pendingGamesCount() const override;
+
+		/** Returns true if all the games were dealt (games may still be running) */
+		bool isExhausted() const override;
+
+		/** Deals the next game of this shard that wasn't completed elsewhere, or NULL if there are no more games.
+		 *  This method is thread safe.
+		 */
+		unique_ptr<SingleGameTask> next() override;
+
+		/** Round robin games don't depend on earlier results, the results only refine the cost predictions */
+		void onGameFinished(const SingleGameTask& task, const GameResults& results) override;
+
+		/** Returns the game with the given task id (which must be smaller than gamesCount) */
+		unique_ptr<SingleGameTask> task(size_t taskId) const;
+
+		/** Returns true if the game with the given task id belongs to this shard and wasn't marked completed */
+		bool isPending(size_t taskId) const;
+
+		/** Marks a pending game as completed elsewhere, so it won't be dealt.
+		 *  Must not be called while games are being dealt.
+		 */
+		void markCompleted(size_t taskId);
+
+	private:
+		vector<string> _players;
+		vector<string> _boards;
+		CompetitionShard _shard;
+
+		/** Number of games between all players on a single board (each pair once) */
+		size_t _boardGamesCount;
+
+		/** Number of games in the competition before the inversed games */
+		size_t _forwardGamesCount;
+
+		/** Position of the first game of each round within a board's games (the last entry is the end) */
+		vector<size_t> _roundStarts;
+
+		/** Games of this shard that were completed elsewhere (empty if there are none) */
+		vector<bool> _completedGames;
+		size_t _completedGamesCount;
+
+		/** Position of the next game to deal within each bucket (may overshoot the bucket's games) */
+		unique_ptr<atomic<size_t>[]> _bucketNextGames;
+
+		/** Bucket the games are dealt from, or bucketsCount once all the buckets were dealt */
+		atomic<size_t> _currentBucket;
+
+		/** Buckets that games were dealt from */
+		vector<bool> _isBucketStarted;
+		atomic<size_t> _startedBucketsCount;
+
+		/** Predicts the cost of the buckets' games */
+		GameCostModel _costModel;
+
+		/** Protects the cost model and the starting of buckets (taken once per game finished, not to deal games) */
+		mutex _costModelLock;
+
+		/** Number of buckets, one per board (a bucket's index is its board's index) */
+		size_t bucketsCount() const;
+
+		/** Number of games in each bucket: the forward and inversed games of a board */
+		size_t bucketGamesCount() const;
+
+		/** Task id of the given game in the bucket */
+		size_t taskIdOf(size_t bucket, size_t gameInBucket) const;
+
+		/** Makes the undealt bucket whose games are predicted to be the longest the current bucket, unless another
+		 *  worker already replaced the finished bucket. Returns the new current bucket.
+		 */
+		size_t startNextBucket(size_t finishedBucket);
+
+		/** Returns the undealt bucket to deal next, or bucketsCount if all were dealt.
+		 *  Expected to be called while holding _costModelLock.
+		 */
+		size_t nextUnstartedBucket() const;
+
+		/** Number of games of this shard with task ids smaller than the given count */
+		size_t ownedGamesCount(size_t taskIdsCount) const;
+
+		/** Returns true if the game was marked completed */
+		bool isCompleted(size_t taskId) const;
+	};
+}
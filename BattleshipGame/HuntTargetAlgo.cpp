@@ -15,7 +15,9 @@ HuntTargetAlgo::HuntTargetAlgo():  IBattleshipGameAlgo(),
 								   playerId(0),
 								   boardSize(std::make_tuple(0, 0, 0)),
 								   visitedCoords({}),
-								   lastAttackDirection(AttackDirection::InPlace)
+								   lastAttackDirection(AttackDirection::InPlace),
+								   layerTaskRunner(nullptr),
+								   isParallelScan(false)
 {
 }
 
@@ -28,6 +30,11 @@ void HuntTargetAlgo::setPlayer(int player)
 	playerId = player;
 }
 
+void HuntTargetAlgo::setLayerTaskRunner(LayerTaskRunner* runner)
+{
+	layerTaskRunner = runner;
+}
+
 // This function assumes that coord is inside the board
 void HuntTargetAlgo::markRowNeighbors(Coordinate coord)
 {
@@ -64,35 +71,108 @@ void HuntTargetAlgo::setBoard(const BoardData& board)
 	visitedCoords = {};
 	targetsMap = {};
 
-	// Mark our ships and their surrounding as visited
-	for (int i = 0; i < std::get<0>(boardSize); ++i)
+	prepareParallelScan();
+
+	// Read the board directly from its snapshot buffer if the game provides one
+	const BoardSnapshot* snapshot = boardSnapshotOf(board);
+	const char* squares = (snapshot != nullptr) ? snapshot->squares() : nullptr;
+
+	// Collect our ships layer by layer
+	vector<vector<Coordinate>> layerShips(std::get<2>(boardSize));
+	auto scanLayer = [this, &board, squares, &layerShips](int k)
 	{
-		for (int j = 0; j < std::get<1>(boardSize); ++j)
+		for (int i = 0; i < std::get<0>(boardSize); ++i)
 		{
-			for (int k = 0; k < std::get<2>(boardSize); ++k)
+			for (int j = 0; j < std::get<1>(boardSize); ++j)
 			{
-				if (board.charAt(Coordinate(i+1, j+1, k+1)) != static_cast<char>(BoardSquare::Empty))
-				{
-					Coordinate coord(i, j, k);
-					visitedCoords.insert(coord);
-					markRowNeighbors(coord);
-					markColNeighbors(coord);
-					markDepthNeighbors(coord);
-				}
+				Coordinate square(i+1, j+1, k+1);
+				char squareChar = (squares != nullptr) ? squares[snapshotIndex(board, square)] : board.charAt(square);
+
+				if (squareChar != static_cast<char>(BoardSquare::Empty))
+					layerShips[k].emplace_back(i, j, k);
 			}
 		}
+	};
+
+	// Only the snapshot is known to be safe for concurrent reads
+	if (isParallelScan && (squares != nullptr))
+		layerTaskRunner->forEachLayer(std::get<2>(boardSize), scanLayer);
+	else
+		for (int k = 0; k < std::get<2>(boardSize); ++k)
+			scanLayer(k);
+
+	// Mark our ships and their surrounding as visited
+	for (const auto& ships : layerShips)
+	{
+		for (const auto& coord : ships)
+		{
+			visitedCoords.insert(coord);
+			markRowNeighbors(coord);
+			markColNeighbors(coord);
+			markDepthNeighbors(coord);
+		}
 	}
 
 	srand(static_cast<unsigned int>(time(nullptr)));	// Initialize random seed
 }
 
-Coordinate HuntTargetAlgo::searchUnvisitedCoord()
+void HuntTargetAlgo::prepareParallelScan()
+{
+	long long squaresCount = static_cast<long long>(std::get<0>(boardSize)) * std::get<1>(boardSize) * std::get<2>(boardSize);
+
+	isParallelScan = (layerTaskRunner != nullptr) && (layerTaskRunner->helperThreadsCount() > 0) &&
+					 (squaresCount >= layerTaskRunner->minParallelSquares()) && (std::get<2>(boardSize) > 1);
+}
+
+template <typename Dims>
+Coordinate HuntTargetAlgo::searchUnvisitedCoordInLayer(const Dims& dims, int k) const
 {
-	for (int i = 0; i < std::get<0>(boardSize); ++i)
+	for (int i = 0; i < dims.rows(); ++i)
 	{
-		for (int j = 0; j < std::get<1>(boardSize); ++j)
+		for (int j = 0; j < dims.cols(); ++j)
 		{
-			for (int k = 0; k < std::get<2>(boardSize); ++k)
+			if (visitedCoords.find(Coordinate(i, j, k)) == visitedCoords.end())
+				return Coordinate(i+1, j+1, k+1);
+		}
+	}
+
+	return NO_MORE_MOVES;
+}
+
+template <typename Dims>
+Coordinate HuntTargetAlgo::searchUnvisitedCoord(const Dims& dims)
+{
+	if (isParallelScan)
+	{
+		// Search each layer in parallel, then pick the coordinate the serial search would have found first
+		vector<Coordinate> layerCoords(dims.depth(), NO_MORE_MOVES);
+		layerTaskRunner->forEachLayer(dims.depth(), [this, &dims, &layerCoords](int k)
+		{
+			layerCoords[k] = searchUnvisitedCoordInLayer(dims, k);
+		});
+
+		Coordinate firstCoord = NO_MORE_MOVES;
+		for (const auto& coord : layerCoords)
+		{
+			if (coord == NO_MORE_MOVES)
+				continue;
+
+			// Layers are visited by ascending depth, so ties keep the shallower layer
+			if ((firstCoord == NO_MORE_MOVES) || (coord.row < firstCoord.row) ||
+				((coord.row == firstCoord.row) && (coord.col < firstCoord.col)))
+			{
+				firstCoord = coord;
+			}
+		}
+
+		return firstCoord;
+	}
+
+	for (int i = 0; i < dims.rows(); ++i)
+	{
+		for (int j = 0; j < dims.cols(); ++j)
+		{
+			for (int k = 0; k < dims.depth(); ++k)
 			{
 				if (visitedCoords.find(Coordinate(i, j, k)) == visitedCoords.end())
 					return Coordinate(i+1, j+1, k+1);
@@ -137,13 +217,14 @@ AttackDirection HuntTargetAlgo::getTargetDirection(targetsMapEntry targetIt)
 	return maxDirection->first;
 }
 
-bool HuntTargetAlgo::calcTargetNext(Coordinate& coord, AttackDirection direction, int size)
+template <typename Dims>
+bool HuntTargetAlgo::calcTargetNext(const Dims& dims, Coordinate& coord, AttackDirection direction, int size)
 {
 	switch (direction)
 	{
 	case AttackDirection::RowPlus:
 	{
-		if ((coord.row + size > std::get<0>(boardSize)) ||
+		if ((coord.row + size > dims.rows()) ||
 			(visitedCoords.find(Coordinate(coord.row-1+size, coord.col-1, coord.depth-1)) != visitedCoords.end()))
 			return false;
 		coord.row += size;
@@ -159,7 +240,7 @@ bool HuntTargetAlgo::calcTargetNext(Coordinate& coord, AttackDirection direction
 	}
 	case AttackDirection::ColPlus:
 	{
-		if ((coord.col + size > std::get<1>(boardSize)) ||
+		if ((coord.col + size > dims.cols()) ||
 			(visitedCoords.find(Coordinate(coord.row-1, coord.col-1+size, coord.depth-1)) != visitedCoords.end()))
 			return false;
 		coord.col += size;
@@ -175,7 +256,7 @@ bool HuntTargetAlgo::calcTargetNext(Coordinate& coord, AttackDirection direction
 	}
 	case AttackDirection::DepthPlus:
 	{
-		if ((coord.depth + size > std::get<2>(boardSize)) ||
+		if ((coord.depth + size > dims.depth()) ||
 			(visitedCoords.find(Coordinate(coord.row-1, coord.col-1, coord.depth-1+size)) != visitedCoords.end()))
 			return false;
 		coord.depth += size;
@@ -195,6 +276,13 @@ bool HuntTargetAlgo::calcTargetNext(Coordinate& coord, AttackDirection direction
 }
 
 Coordinate HuntTargetAlgo::attack()
+{
+	return dispatchBoardDims(std::get<0>(boardSize), std::get<1>(boardSize), std::get<2>(boardSize),
+							 [this](const auto& dims) { return attackOnBoard(dims); });
+}
+
+template <typename Dims>
+Coordinate HuntTargetAlgo::attackOnBoard(const Dims& dims)
 {
 	Coordinate coord = NO_MORE_MOVES;
 
@@ -204,9 +292,9 @@ Coordinate HuntTargetAlgo::attack()
 		{
 			int drawsCounter = 0;
 			do {
-				coord.row = rand() % std::get<0>(boardSize) + 1;	// In the range 1 to number of rows
-				coord.col = rand() % std::get<1>(boardSize) + 1;	// In the range 1 to number of columns
-				coord.depth = rand() % std::get<2>(boardSize) + 1;	// In the range 1 to number of depths
+				coord.row = rand() % dims.rows() + 1;	// In the range 1 to number of rows
+				coord.col = rand() % dims.cols() + 1;	// In the range 1 to number of columns
+				coord.depth = rand() % dims.depth() + 1;	// In the range 1 to number of depths
 				drawsCounter++;
 			} while ((visitedCoords.find(Coordinate(coord.row-1, coord.col-1, coord.depth-1)) != visitedCoords.end()) &&
 					 (drawsCounter <= MAX_NUM_OF_DRAWS));
@@ -214,7 +302,7 @@ Coordinate HuntTargetAlgo::attack()
 			lastAttackDirection = AttackDirection::InPlace;
 
 			if (drawsCounter > MAX_NUM_OF_DRAWS)
-				coord = searchUnvisitedCoord();
+				coord = searchUnvisitedCoord(dims);
 		}
 		else	// Target mode: we try to attack around the targets that we already found
 		{
@@ -231,17 +319,17 @@ Coordinate HuntTargetAlgo::attack()
 				if (maxDirection == -1)	// This is a redundant target that came from the other player
 				{						// We remove it to avoid infinite loop
 					targetsMap.erase(currTarget);
-					return attack();
+					return attackOnBoard(dims);
 				}
 
-				foundAttack = calcTargetNext(coord, lastAttackDirection, maxDirection + 1);
+				foundAttack = calcTargetNext(dims, coord, lastAttackDirection, maxDirection + 1);
 				if (!foundAttack)	// This direction is no longer applicable
 					currTarget->second[lastAttackDirection] = -1;
 			}
 		}
 
-		AttackValidator validator;
-		return validator(coord, std::get<0>(boardSize), std::get<1>(boardSize), std::get<2>(boardSize));
+		// Same as AttackValidator, with the board's dimensions
+		return dims.isOnBoard(coord) ? coord : NO_MORE_MOVES;
 	}
 	catch (...)
 	{	// This should be a barrier that stops the app from failing.
@@ -546,7 +634,16 @@ void HuntTargetAlgo::notifyOnAttackResult(int player, Coordinate move, AttackRes
 	}
 }
 
-ALGO_API IBattleshipGameAlgo* GetAlgorithm()
+IBattleshipGameAlgo* HuntTargetAlgo::create()
 {
 	return new HuntTargetAlgo();
-}
\ No newline at end of file
+}
+
+// The dll entry point is only exported when building the algorithm's dll,
+// the game executable creates its compiled-in instances with create()
+#ifdef ALGO_EXPORTS
+ALGO_API IBattleshipGameAlgo* GetAlgorithm()
+{
+	return HuntTargetAlgo::create();
+}
+#endif
\ No newline at end of file
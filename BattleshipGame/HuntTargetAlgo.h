@@ -6,6 +6,8 @@
 #include <unordered_set>
 #include "IBattleshipGameAlgo.h"
 #include "AlgoCommon.h"
+#include "AlgoParallel.h"
+#include "BoardDims.h"
 
 using std::tuple;
 using std::vector;
@@ -25,12 +27,19 @@ enum class AttackDirection
 
 using targetsMapEntry = map<Coordinate, map<AttackDirection, int>>::iterator;
 
-class HuntTargetAlgo : public IBattleshipGameAlgo
+/** Marked final so games between HuntTargetAlgo instances compiled into the game executable
+ *  can call it without virtual dispatch (see StaticAlgoRegistry).
+ *  Scans huge boards with the helper threads the game lends it, if any (see ParallelAlgo).
+ */
+class HuntTargetAlgo final : public IBattleshipGameAlgo, public ParallelAlgo
 {
 public:
 	HuntTargetAlgo();
 	~HuntTargetAlgo();
 
+	/** Creates a new instance of the algorithm (GetAlgorithm equivalent, when compiled into the executable) */
+	static IBattleshipGameAlgo* create();
+
 	HuntTargetAlgo(HuntTargetAlgo const&) = delete;	// Disable copying
 	HuntTargetAlgo& operator=(HuntTargetAlgo const&) = delete;	// Disable copying (assignment)
 	HuntTargetAlgo(HuntTargetAlgo&& other) noexcept = delete; // Disable moving
@@ -44,8 +53,11 @@ public:
 
 	void notifyOnAttackResult(int player, Coordinate move, AttackResult result) override;
 
+	void setLayerTaskRunner(LayerTaskRunner* runner) override;
+
 private:
 	static const int MAX_NUM_OF_DRAWS;
+
 	static const AttackDirection nonInPlaceDirections[];
 
 	int playerId;
@@ -63,6 +75,12 @@ private:
 	// Size of -1 is indicating that we failed to attack in that direction.
 	map<Coordinate, map<AttackDirection, int>> targetsMap;
 
+	// Helper threads lent by the game to split board scans between the depth layers (NULL if none were lent)
+	LayerTaskRunner* layerTaskRunner;
+
+	// True if the current board is huge enough to be scanned by the layer task runner
+	bool isParallelScan;
+
 	// coord is in the range 0 to board size - 1
 	void markRowNeighbors(Coordinate coord);
 	
@@ -80,14 +98,31 @@ private:
 
 	static void advanceInDirection(Coordinate& coord, AttackDirection direction, int size);
 
+	// The hunt / target kernels below are templated on the board dimensions (see BoardDims.h), so the common board
+	// shapes get their bounds checks and scan loops with constant dimensions. attack() dispatches to them.
+
+	// attack() for a board of the given dimensions
+	template <typename Dims>
+	Coordinate attackOnBoard(const Dims& dims);
+
 	// Search for an unvisited coordinate in 'visitedCoords'. The returned coordiante is in the range 1 to board size.
 	// If no square was found, battleship::NO_MORE_MOVES is returned.
-	Coordinate searchUnvisitedCoord();
+	template <typename Dims>
+	Coordinate searchUnvisitedCoord(const Dims& dims);
+
+	// Search for the first unvisited coordinate (by row, then column) in the given depth layer.
+	// The returned coordinate is in the range 1 to board size, or NO_MORE_MOVES if the layer was entirely visited.
+	template <typename Dims>
+	Coordinate searchUnvisitedCoordInLayer(const Dims& dims, int depth) const;
+
+	// Decides whether the current board is huge enough to be scanned in parallel
+	void prepareParallelScan();
 
 	// Check if the attempt to attack around a target is a valid attack, i.e. doesn't exceed the borders of the board
 	// and not yet visited.
 	// coord is in the range 1 to board size.
-	bool calcTargetNext(Coordinate& coord, AttackDirection direction, int size);
+	template <typename Dims>
+	bool calcTargetNext(const Dims& dims, Coordinate& coord, AttackDirection direction, int size);
 
 	// coord is in the range 0 to board size - 1
 	targetsMapEntry updateMapOnOtherAttack(Coordinate coord, AttackResult result);
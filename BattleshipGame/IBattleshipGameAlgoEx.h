@@ -0,0 +1,44 @@
+#pragma once
+
+#include "IBattleshipGameAlgo.h"
+
+/* Optional extension of IBattleshipGameAlgo, for algorithms that want to reduce the number of calls per move
+ * (e.g. algorithms that forward the calls to another process or a sandbox).
+ * An algorithm supports the extension by exporting GetAlgorithmEx next to GetAlgorithm.
+ * Algorithms that don't export it are played through IBattleshipGameAlgo, exactly as before.
+ */
+
+// Version of the extended interface defined in this file
+const int ALGO_EX_VERSION = 1;
+
+// Result of a single attack, as passed to notifyOnAttackResult
+struct AttackNotification
+{
+	int player;
+	Coordinate move;
+	AttackResult result;
+};
+
+class IBattleshipGameAlgoEx : public IBattleshipGameAlgo
+{
+public:
+	virtual ~IBattleshipGameAlgoEx() = default;
+
+	// Results of all the attacks made since the previous call (by both players), in the order they were made.
+	// Replaces notifyOnAttackResult, which isn't called for extended algorithms.
+	// Results of the last attacks of a game may not be delivered, since the player doesn't attack anymore.
+	virtual void notifyOnAttackResults(const AttackNotification* results, int count) = 0;
+
+	// Ask player for up to maxAttacks moves in advance, written to attacks. Returns the number of moves written.
+	// The moves are played in order for as long as the player keeps the turn, the rest are dropped once the
+	// opponent attacks (the player can tell which moves were played from the results it is notified on).
+	// Replaces attack(), which isn't called for extended algorithms. Returning 0 moves forfeits the game,
+	// same as returning (-1, -1, -1) from attack().
+	virtual int attackBatch(Coordinate* attacks, int maxAttacks) = 0;
+};
+
+/* Creates an instance of the extended algorithm, same as GetAlgorithm.
+ * version is the version of the extended interface the game supports (ALGO_EX_VERSION).
+ * If the algorithm doesn't support this version, it should return NULL - and the game will use GetAlgorithm instead.
+ */
+ALGO_API IBattleshipGameAlgoEx* GetAlgorithmEx(int version);
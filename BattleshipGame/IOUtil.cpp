@@ -140,6 +140,38 @@ namespace battleship
 		}
 	}
 
+	string IOUtil::escapeJson(const string& str)
+	{
+		static constexpr auto HEX_DIGITS = "0123456789abcdef";
+
+		string escaped;
+		escaped.reserve(str.length());
+		for (char c : str)
+		{
+			switch (c)
+			{
+			case '"':	escaped += "\\\"";	break;
+			case '\\':	escaped += "\\\\";	break;
+			case '\n':	escaped += "\\n";	break;
+			case '\r':	escaped += "\\r";	break;
+			case '\t':	escaped += "\\t";	break;
+			default:
+				if (static_cast<unsigned char>(c) < 0x20)
+				{
+					escaped += "\\u00";
+					escaped += HEX_DIGITS[(c >> 4) & 0xF];
+					escaped += HEX_DIGITS[c & 0xF];
+				}
+				else
+				{
+					escaped += c;
+				}
+			}
+		}
+
+		return escaped;
+	}
+
 	void IOUtil::removePrefix(string& fullString, const string& prefix)
 	{
 		fullString.erase(0, prefix.length());
@@ -194,4 +226,30 @@ namespace battleship
 		string fullPath(buffer, pathSize);
 		return fullPath;
 	}
+
+	uint64_t IOUtil::contentHash(const void* data, size_t size, uint64_t hash)
+	{
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= bytes[i];
+			hash *= CONTENT_HASH_PRIME;
+		}
+
+		return hash;
+	}
+
+	bool IOUtil::fileContentHash(const string& filename, uint64_t& hash)
+	{
+		ifstream fs(filename, std::ios::binary);
+		if (!fs.is_open())
+			return false;
+
+		vector<char> chunk(FILE_HASH_CHUNK_SIZE);
+		hash = CONTENT_HASH_BASIS;
+		while (fs.read(chunk.data(), static_cast<std::streamsize>(chunk.size())) || (fs.gcount() > 0))
+			hash = contentHash(chunk.data(), static_cast<size_t>(fs.gcount()), hash);
+
+		return fs.eof();
+	}
 }
\ No newline at end of file
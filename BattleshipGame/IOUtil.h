@@ -3,6 +3,7 @@
 #include <functional>
 #include <initializer_list>
 #include <vector>
+#include <cstdint>
 
 namespace battleship
 {
@@ -61,6 +62,11 @@ namespace battleship
 		 */
 		static void removeSuffix(string& fullString, const string& suffix);
 
+		/** Returns the string as the contents of a JSON string literal (without the surrounding quotes):
+		 *  quotes, backslashes (e.g. of Windows paths) and control characters are escaped.
+		 */
+		static string escapeJson(const string& str);
+
 		/** Returns true if the path argument points to a real valid path on disk, false if not. */
 		static bool validatePath(const string& path);
 
@@ -77,7 +83,26 @@ namespace battleship
 		 */
 		static string convertPathToAbsolute(const string& path);
 
+		/** Returns the 64 bit FNV-1a hash of size bytes of data.
+		 *  Hashes of several buffers are chained by passing the hash of the previous buffers as hash.
+		 */
+		static uint64_t contentHash(const void* data, size_t size, uint64_t hash = CONTENT_HASH_BASIS);
+
+		/** Computes the contentHash of the entire file into hash.
+		 *  Returns false if the file can't be read.
+		 */
+		static bool fileContentHash(const string& filename, uint64_t& hash);
+
+		/** Initial value of contentHash (the FNV-1a offset basis) */
+		static constexpr uint64_t CONTENT_HASH_BASIS = 14695981039346656037ULL;
+
 	private:
+		/** Multiplier of each step of contentHash (the FNV-1a prime) */
+		static constexpr uint64_t CONTENT_HASH_PRIME = 1099511628211ULL;
+
+		/** Size of the chunks files are read in by fileContentHash */
+		static constexpr size_t FILE_HASH_CHUNK_SIZE = 64 * 1024;
+
 		IOUtil() = default;	// This helper class shouldn't be instantiated
 	};
 }
\ No newline at end of file
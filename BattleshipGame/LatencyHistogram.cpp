@@ -0,0 +1,121 @@
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <cmath>
+
+namespace battleship
+{
+	// Profiles selected by the innermost GameLatencyScope of each thread
+	static thread_local AlgoCallLatencies* threadPlayerALatencies = nullptr;
+	static thread_local AlgoCallLatencies* threadPlayerBLatencies = nullptr;
+
+	LatencyHistogram::LatencyHistogram() :
+		_counts(BUCKETS_COUNT, 0),
+		_count(0),
+		_maxNanos(0)
+	{
+	}
+
+	int LatencyHistogram::bucketIndex(long long nanos)
+	{
+		// Small latencies are counted exactly
+		if (nanos < 2 * SUB_BUCKETS_COUNT)
+			return static_cast<int>(nanos);
+
+		// Find the power of two range, the sub bucket is made of the bits right after the leading bit
+		int exponent = 0;
+		for (unsigned long long value = static_cast<unsigned long long>(nanos); value > 1; value >>= 1)
+			exponent++;
+
+		int subBucket = static_cast<int>((nanos >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS_COUNT - 1));
+		return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKETS_COUNT + subBucket;
+	}
+
+	long long LatencyHistogram::bucketUpperBound(int index)
+	{
+		if (index < 2 * SUB_BUCKETS_COUNT)
+			return index;
+
+		int exponent = index / SUB_BUCKETS_COUNT + SUB_BUCKET_BITS - 1;
+		long long subBucket = index % SUB_BUCKETS_COUNT;
+		long long bucketWidth = 1LL << (exponent - SUB_BUCKET_BITS);
+		return (SUB_BUCKETS_COUNT + subBucket) * bucketWidth + bucketWidth - 1;
+	}
+
+	void LatencyHistogram::record(long long nanos)
+	{
+		nanos = std::max(nanos, 0LL);
+		_counts[bucketIndex(nanos)]++;
+		_count++;
+		_maxNanos = std::max(_maxNanos, nanos);
+	}
+
+	void LatencyHistogram::merge(const LatencyHistogram& other)
+	{
+		for (int i = 0; i < BUCKETS_COUNT; i++)
+			_counts[i] += other._counts[i];
+
+		_count += other._count;
+		_maxNanos = std::max(_maxNanos, other._maxNanos);
+	}
+
+	long long LatencyHistogram::count() const
+	{
+		return _count;
+	}
+
+	long long LatencyHistogram::maxNanos() const
+	{
+		return _maxNanos;
+	}
+
+	long long LatencyHistogram::percentileNanos(double percentile) const
+	{
+		if (_count == 0)
+			return 0;
+
+		// Rank of the latency the percentile points to, in the range [1, count]
+		long long rank = static_cast<long long>(std::ceil(percentile / 100.0 * _count));
+		rank = std::min(std::max(rank, 1LL), _count);
+
+		long long accumulated = 0;
+		for (int i = 0; i < BUCKETS_COUNT; i++)
+		{
+			accumulated += _counts[i];
+			if (accumulated >= rank)
+				return std::min(bucketUpperBound(i), _maxNanos);
+		}
+
+		return _maxNanos;
+	}
+
+	void AlgoCallLatencies::merge(const AlgoCallLatencies& other)
+	{
+		setBoard.merge(other.setBoard);
+		attack.merge(other.attack);
+		notifyOnAttackResult.merge(other.notifyOnAttackResult);
+	}
+
+	GameLatencyScope::GameLatencyScope(AlgoCallLatencies* playerALatencies, AlgoCallLatencies* playerBLatencies) :
+		_previousPlayerALatencies(threadPlayerALatencies),
+		_previousPlayerBLatencies(threadPlayerBLatencies)
+	{
+		threadPlayerALatencies = playerALatencies;
+		threadPlayerBLatencies = playerBLatencies;
+	}
+
+	GameLatencyScope::~GameLatencyScope()
+	{
+		threadPlayerALatencies = _previousPlayerALatencies;
+		threadPlayerBLatencies = _previousPlayerBLatencies;
+	}
+
+	AlgoCallLatencies* GameLatencyScope::playerALatencies()
+	{
+		return threadPlayerALatencies;
+	}
+
+	AlgoCallLatencies* GameLatencyScope::playerBLatencies()
+	{
+		return threadPlayerBLatencies;
+	}
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <vector>
+
+using std::vector;
+
+namespace battleship
+{
+	/** Histogram of latencies in nanoseconds with log-linear buckets (in the spirit of HDR histograms):
+	 *  every power of two range is split into SUB_BUCKETS_COUNT equal buckets, so any latency is counted with
+	 *  a relative error of at most 1/SUB_BUCKETS_COUNT, with a fixed amount of memory and no allocations when
+	 *  recording. Histograms aren't thread safe - each thread records into its own, and they're merged later.
+	 */
+	class LatencyHistogram
+	{
+	public:
+		LatencyHistogram();
+		virtual ~LatencyHistogram() = default;
+
+		/** Counts a single latency (negative latencies are counted as 0) */
+		void record(long long nanos);
+
+		/** Adds the counts of another histogram to this one */
+		void merge(const LatencyHistogram& other);
+
+		/** Number of latencies recorded */
+		long long count() const;
+
+		/** Highest latency recorded (exact) */
+		long long maxNanos() const;
+
+		/** Latency below which the given percentage (0-100) of the recorded latencies are.
+		 *  The value is the upper bound of the bucket the percentile falls in. Returns 0 if nothing was recorded.
+		 */
+		long long percentileNanos(double percentile) const;
+
+	private:
+		/** Number of bits of the sub bucket within a power of two range */
+		static constexpr int SUB_BUCKET_BITS = 3;
+
+		/** Number of buckets each power of two range is split to */
+		static constexpr int SUB_BUCKETS_COUNT = 1 << SUB_BUCKET_BITS;
+
+		/** Total number of buckets, enough for any non negative long long */
+		static constexpr int BUCKETS_COUNT = (64 - SUB_BUCKET_BITS) * SUB_BUCKETS_COUNT;
+
+		vector<long long> _counts;
+		long long _count;
+		long long _maxNanos;
+
+		/** Index of the bucket the latency is counted in */
+		static int bucketIndex(long long nanos);
+
+		/** Highest latency counted in the given bucket */
+		static long long bucketUpperBound(int index);
+	};
+
+	/** Latencies of the calls made by the game loop to a single algorithm */
+	struct AlgoCallLatencies
+	{
+		LatencyHistogram setBoard;
+		LatencyHistogram attack;
+		LatencyHistogram notifyOnAttackResult;
+
+		/** Adds the latencies of another profile to this one */
+		void merge(const AlgoCallLatencies& other);
+	};
+
+	/** Selects the latency profiles the game loop of the current thread records into, for as long as the scope
+	 *  lives. Outside of any scope game loops don't record latencies (e.g. benchmark games).
+	 */
+	class GameLatencyScope
+	{
+	public:
+		GameLatencyScope(AlgoCallLatencies* playerALatencies, AlgoCallLatencies* playerBLatencies);
+
+		/** Restores the profiles that were selected before the scope */
+		virtual ~GameLatencyScope();
+
+		GameLatencyScope(GameLatencyScope const&) = delete;	// Disable copying
+		GameLatencyScope& operator=(GameLatencyScope const&) = delete;	// Disable copying (assignment)
+
+		/** Profile of player A in the current thread's game (may be NULL) */
+		static AlgoCallLatencies* playerALatencies();
+
+		/** Profile of player B in the current thread's game (may be NULL) */
+		static AlgoCallLatencies* playerBLatencies();
+
+	private:
+		AlgoCallLatencies* _previousPlayerALatencies;
+		AlgoCallLatencies* _previousPlayerBLatencies;
+	};
+}
@@ -0,0 +1,269 @@
+#include "LockstepGameEngine.h"
+#include <unordered_map>
+#include <algorithm>
+
+using std::unordered_map;
+
+// Attack results are computed as isAlive + isSink
+static_assert((static_cast<int>(AttackResult::Miss) == 0) &&
+			  (static_cast<int>(AttackResult::Hit) == 1) &&
+			  (static_cast<int>(AttackResult::Sink) == 2), "Unexpected AttackResult values");
+
+namespace battleship
+{
+	LockstepGameEngine::LockstepGameEngine(const BattleBoard& prototype) :
+		_width(prototype.width()),
+		_height(prototype.height()),
+		_depth(prototype.depth()),
+		_initialPlayerAShips(prototype.getPlayerAShipCount()),
+		_initialPlayerBShips(prototype.getPlayerBShipCount()),
+		_gamesCount(0),
+		_paddedGamesCount(0)
+	{
+		// Flatten the prototype's pieces, in board order (all squares of a piece map to the same game piece)
+		unordered_map<const GamePiece*, int> pieceIndices;
+		_squareShipSquares.resize(static_cast<size_t>(_width) * _height * _depth);
+
+		for (int depth = 0; depth < _depth; depth++)
+		{
+			for (int row = 0; row < _height; row++)
+			{
+				for (int col = 0; col < _width; col++)
+				{
+					size_t square = (static_cast<size_t>(depth) * _height + row) * _width + col;
+					auto piece = prototype.pieceAt(Coordinate(row, col, depth));
+					if (piece == nullptr)
+					{
+						_squareShipSquares[square] = NO_TARGET;	// Set to the sentinel once all ship squares are known
+						continue;
+					}
+
+					auto pieceIt = pieceIndices.find(piece.get());
+					if (pieceIt == pieceIndices.end())
+					{
+						pieceIt = pieceIndices.insert(std::make_pair(piece.get(), static_cast<int>(_pieceSizes.size()))).first;
+						_pieceSizes.push_back(piece->_lifeLeft);
+						_piecePoints.push_back(piece->_shipType->_points);
+						_pieceIsPlayerA.push_back((piece->_player == PlayerEnum::A) ? 1 : 0);
+					}
+
+					_squareShipSquares[square] = static_cast<int>(_shipSquarePieces.size());
+					_shipSquarePieces.push_back(pieceIt->second);
+				}
+			}
+		}
+
+		// The sentinel: a piece without life, covering all empty squares
+		int sentinelShipSquare = static_cast<int>(_shipSquarePieces.size());
+		_shipSquarePieces.push_back(static_cast<int>(_pieceSizes.size()));
+		_pieceSizes.push_back(0);
+		_piecePoints.push_back(0);
+		_pieceIsPlayerA.push_back(0);
+
+		for (auto& shipSquare : _squareShipSquares)
+		{
+			if (shipSquare == NO_TARGET)
+				shipSquare = sentinelShipSquare;
+		}
+	}
+
+	void LockstepGameEngine::resetGames(int gamesCount)
+	{
+		_gamesCount = gamesCount;
+		const size_t games = static_cast<size_t>(gamesCount);
+
+		// Piece life is laid out piece by piece, with the games of each piece next to each other
+		_pieceLife.resize(_pieceSizes.size() * games);
+		for (size_t piece = 0; piece < _pieceSizes.size(); piece++)
+			std::fill_n(_pieceLife.begin() + piece * games, games, _pieceSizes[piece]);
+
+		_shipSquareDamaged.assign(_shipSquarePieces.size() * games, 0);
+
+		// The padding games never attack the board, so they never change
+		_paddedGamesCount = (gamesCount + SIMD_LANES - 1) / SIMD_LANES * SIMD_LANES;
+		const size_t paddedGames = static_cast<size_t>(_paddedGamesCount);
+
+		_isCurrPlayerA.assign(paddedGames, 1);
+		_isPlayerAForfeit.assign(paddedGames, 0);
+		_isPlayerBForfeit.assign(paddedGames, 0);
+		_playerAShips.assign(paddedGames, _initialPlayerAShips);
+		_playerBShips.assign(paddedGames, _initialPlayerBShips);
+		_playerAPoints.assign(paddedGames, 0);
+		_playerBPoints.assign(paddedGames, 0);
+		_moves.assign(games, 0);
+		_isActive.assign(games, 1);
+		_isFaulted.assign(games, 0);
+
+		_attackers.assign(games, 0);
+		_targets.assign(games, static_cast<int>(NO_TARGET));	// By value, NO_TARGET has no definition
+		_targetMoves.assign(games, NO_MORE_MOVES);
+		_attackResults.assign(games, AttackResult::Miss);
+
+		_stepLifePositions.assign(games, 0);
+		_stepDamagedPositions.assign(games, 0);
+		_stepLife.assign(paddedGames, 0);
+		_stepDamaged.assign(paddedGames, 0);
+		_stepIsPlayerAPiece.assign(paddedGames, 0);
+		_stepPiecePoints.assign(paddedGames, 0);
+		_stepHasTarget.assign(paddedGames, 0);
+		_stepResults.assign(paddedGames, 0);
+	}
+
+	void LockstepGameEngine::resolveAttacks()
+	{
+		const int games = _gamesCount;
+		const int sentinelShipSquare = static_cast<int>(_shipSquarePieces.size()) - 1;
+
+		const int* __restrict targets = _targets.data();
+		const int* __restrict squareShipSquares = _squareShipSquares.data();
+		const int* __restrict shipSquarePieces = _shipSquarePieces.data();
+		const int* __restrict pieceIsPlayerA = _pieceIsPlayerA.data();
+		const int* __restrict piecePoints = _piecePoints.data();
+		int* __restrict pieceLife = _pieceLife.data();
+		int* __restrict shipSquareDamaged = _shipSquareDamaged.data();
+		int* __restrict lifePositions = _stepLifePositions.data();
+		int* __restrict damagedPositions = _stepDamagedPositions.data();
+		int* __restrict stepLife = _stepLife.data();
+		int* __restrict stepDamaged = _stepDamaged.data();
+		int* __restrict stepIsPlayerAPiece = _stepIsPlayerAPiece.data();
+		int* __restrict stepPiecePoints = _stepPiecePoints.data();
+		int* __restrict stepHasTarget = _stepHasTarget.data();
+		const int* __restrict stepResults = _stepResults.data();
+
+		// Gather the attacked ship square and piece of every game.
+		// Games that didn't attack the board attack the sentinel, which is a miss that changes nothing.
+		for (int game = 0; game < games; game++)
+		{
+			int square = targets[game];
+			int hasTarget = (square != NO_TARGET) ? 1 : 0;
+			int shipSquare = hasTarget ? squareShipSquares[square] : sentinelShipSquare;
+			int piece = shipSquarePieces[shipSquare];
+
+			lifePositions[game] = piece * games + game;
+			damagedPositions[game] = shipSquare * games + game;
+			stepLife[game] = pieceLife[lifePositions[game]];
+			stepDamaged[game] = shipSquareDamaged[damagedPositions[game]];
+			stepIsPlayerAPiece[game] = pieceIsPlayerA[piece];
+			stepPiecePoints[game] = piecePoints[piece];
+			stepHasTarget[game] = hasTarget;
+		}
+
+		for (int game = 0; game < _paddedGamesCount; game += SIMD_LANES)
+			resolveGatheredAttacks(game);
+
+		// Scatter the updated ship squares and pieces back
+		for (int game = 0; game < games; game++)
+		{
+			pieceLife[lifePositions[game]] = stepLife[game];
+			shipSquareDamaged[damagedPositions[game]] = stepDamaged[game];
+			_attackResults[game] = static_cast<AttackResult>(stepResults[game]);
+		}
+	}
+
+	void LockstepGameEngine::resolveGatheredAttacks(int firstGame)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i one = _mm_set1_epi32(1);
+		auto load = [firstGame](const vector<int>& values)
+		{
+			return _mm_loadu_si128(reinterpret_cast<const __m128i*>(values.data() + firstGame));
+		};
+		auto store = [firstGame](vector<int>& values, __m128i lanes)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(values.data() + firstGame), lanes);
+		};
+
+		// Squares of sunk pieces are misses, and only the first hit on a square takes a piece's life
+		__m128i life = load(_stepLife);
+		__m128i isDamaged = load(_stepDamaged);
+		__m128i isAlive = _mm_and_si128(_mm_cmpgt_epi32(life, zero), one);
+		__m128i isFirstHit = _mm_andnot_si128(isDamaged, isAlive);
+		life = _mm_sub_epi32(life, isFirstHit);
+		store(_stepLife, life);
+		store(_stepDamaged, _mm_or_si128(isDamaged, isFirstHit));
+		__m128i isSink = _mm_and_si128(isAlive, _mm_and_si128(_mm_cmpeq_epi32(life, zero), one));
+
+		// The opponent of the sunk piece's owner gets its points (a sink's mask selects the points)
+		__m128i isPlayerAPiece = load(_stepIsPlayerAPiece);
+		__m128i isPlayerASink = _mm_and_si128(isSink, isPlayerAPiece);
+		__m128i isPlayerBSink = _mm_andnot_si128(isPlayerAPiece, isSink);
+		__m128i points = load(_stepPiecePoints);
+		store(_playerAShips, _mm_sub_epi32(load(_playerAShips), isPlayerASink));
+		store(_playerBShips, _mm_sub_epi32(load(_playerBShips), isPlayerBSink));
+		store(_playerAPoints, _mm_add_epi32(load(_playerAPoints),
+											_mm_and_si128(points, _mm_sub_epi32(zero, isPlayerBSink))));
+		store(_playerBPoints, _mm_add_epi32(load(_playerBPoints),
+											_mm_and_si128(points, _mm_sub_epi32(zero, isPlayerASink))));
+
+		store(_stepResults, _mm_add_epi32(isAlive, isSink));
+
+		// The attacker keeps the turn only if it hit the opponent's ship
+		__m128i isCurrPlayerA = load(_isCurrPlayerA);
+		__m128i isSwitch = _mm_or_si128(_mm_xor_si128(isAlive, one),
+										_mm_and_si128(_mm_cmpeq_epi32(isPlayerAPiece, isCurrPlayerA), one));
+		__m128i nextIsA = nextPlayerIsA(isSwitch, isCurrPlayerA, load(_isPlayerAForfeit), load(_isPlayerBForfeit));
+		__m128i hasTargetMask = _mm_sub_epi32(zero, load(_stepHasTarget));
+		store(_isCurrPlayerA, _mm_or_si128(_mm_and_si128(hasTargetMask, nextIsA),
+										   _mm_andnot_si128(hasTargetMask, isCurrPlayerA)));
+	}
+
+	int LockstepGameEngine::updateActiveGames()
+	{
+		int activeGames = 0;
+		for (int game = 0; game < _gamesCount; game++)
+		{
+			int isOver = (_isPlayerAForfeit[game] & _isPlayerBForfeit[game]) |
+						 ((_playerAShips[game] == 0) ? 1 : 0) | ((_playerBShips[game] == 0) ? 1 : 0);
+			_isActive[game] &= (isOver ^ 1);
+			activeGames += _isActive[game];
+		}
+
+		return activeGames;
+	}
+
+	void LockstepGameEngine::faultGame(int game, const exception& e)
+	{
+		string errorMsg = e.what();
+		Logger::getInstance().log(Severity::ERROR_LEVEL,
+								  "Error: an error occured during lockstep game " + std::to_string(game) +
+								  ", declaring a tie with 0 points. Details: " + errorMsg);
+
+		_isFaulted[game] = 1;
+		_isActive[game] = 0;
+		_targets[game] = NO_TARGET;
+	}
+
+	vector<GameResults> LockstepGameEngine::collectResults() const
+	{
+		vector<GameResults> results(_gamesCount);
+		for (int game = 0; game < _gamesCount; game++)
+		{
+			GameResults& gameResults = results[game];
+			gameResults.durationMicros = 0;
+			gameResults.algoMicros = 0;
+			gameResults.playerAAlgoMicros = 0;
+
+			if (_isFaulted[game])
+			{	// Same as a game that faulted in GameManager
+				gameResults.winner = PlayerEnum::NONE;
+				gameResults.playerAPoints = 0;
+				gameResults.playerBPoints = 0;
+				gameResults.moves = 0;
+				continue;
+			}
+
+			if (_playerAShips[game] == 0)
+				gameResults.winner = PlayerEnum::B;
+			else if (_playerBShips[game] == 0)
+				gameResults.winner = PlayerEnum::A;
+			else
+				gameResults.winner = PlayerEnum::NONE;
+
+			gameResults.playerAPoints = _playerAPoints[game];
+			gameResults.playerBPoints = _playerBPoints[game];
+			gameResults.moves = _moves[game];
+		}
+
+		return results;
+	}
+}
@@ -0,0 +1,290 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <exception>
+#include <emmintrin.h>
+#include "BattleBoard.h"
+#include "GameManager.h"
+#include "AlgoCommon.h"
+#include "BoardDims.h"
+#include "Logger.h"
+
+using std::vector;
+using std::string;
+using std::exception;
+
+namespace battleship
+{
+	/** Plays a batch of independent games on the same board prototype in lockstep: every step, each game that
+	 *  isn't over yet makes a single move.
+	 *  The board state of all the games is kept as structure of arrays - piece life, damaged squares, ship counts,
+	 *  points and turns are each a contiguous array with an entry per game. The attacks of a step are resolved in
+	 *  three passes: the state of each game's attacked square and piece is gathered into contiguous step arrays,
+	 *  hit / sink detection, ship counts, points and the next turn are computed for four games per SSE2 instruction,
+	 *  and the updated square and piece state is scattered back. The players' algorithms are still called one game
+	 *  at a time.
+	 *  Games are played by the same rules as GameManager::runTypedGame and produce the same results, except that
+	 *  moves aren't logged and the game and algorithm times aren't measured (reported as 0).
+	 *  This is a fast mode for self-play parameter sweeps between compiled-in algorithms.
+	 */
+	class LockstepGameEngine
+	{
+	public:
+		/** The prototype must be a valid board, it is only read while the engine is constructed */
+		LockstepGameEngine(const BattleBoard& prototype);
+		virtual ~LockstepGameEngine() = default;
+
+		LockstepGameEngine(LockstepGameEngine const&) = delete;	// Disable copying
+		LockstepGameEngine& operator=(LockstepGameEngine const&) = delete;	// Disable copying (assignment)
+
+		/** Plays a game between playersA[i] and playersB[i] for every i, and returns the results of each game
+		 *  (in the same order). Both lists must be of the same size, and every player instance is used by a single
+		 *  game. The views are the players' views of the prototype.
+		 *  When PlayerAAlgo / PlayerBAlgo are final classes, the calls to the algorithms are resolved statically.
+		 *  A game whose player throws is a tie where nobody gets points, as in GameManager.
+		 */
+		template <typename PlayerAAlgo, typename PlayerBAlgo>
+		vector<GameResults> runGames(const vector<PlayerAAlgo*>& playersA, const vector<PlayerBAlgo*>& playersB,
+									 const BoardData& playerAView, const BoardData& playerBView);
+
+	private:
+		/** Target of a game whose player didn't attack the board in the current step */
+		static constexpr int NO_TARGET = -1;
+
+		/** Number of games resolved by a single SSE2 instruction (32 bit lanes of a 128 bit register) */
+		static constexpr int SIMD_LANES = 4;
+
+		/** Board dimensions */
+		int _width;
+		int _height;
+		int _depth;
+
+		// -- Board prototype, shared by all games --
+		// Ships are flattened into pieces and ship squares. The last piece and ship square are a sentinel:
+		// an already sunk piece that stands for all the empty squares, so misses are resolved like any other attack.
+
+		/** Ship square of each board square (the sentinel for empty squares), indexed like BattleBoard::playerSquares */
+		vector<int> _squareShipSquares;
+
+		/** Piece of each ship square */
+		vector<int> _shipSquarePieces;
+
+		/** Size, points and owner (1 for player A, 0 for player B) of each piece */
+		vector<int> _pieceSizes;
+		vector<int> _piecePoints;
+		vector<int> _pieceIsPlayerA;
+
+		/** Number of ships each player has when a game starts */
+		int _initialPlayerAShips;
+		int _initialPlayerBShips;
+
+		// -- Games state, structure of arrays --
+		// Per piece / ship square state is indexed by (piece or ship square) * games count + game.
+		// Booleans are kept as ints (0 / 1), so all the arrays of the resolution loop have the same element size.
+		// The arrays the resolution loop reads and writes are padded to a multiple of SIMD_LANES games.
+
+		int _gamesCount;
+		int _paddedGamesCount;
+		vector<int> _pieceLife;
+		vector<int> _shipSquareDamaged;
+
+		vector<int> _isCurrPlayerA;
+		vector<int> _isPlayerAForfeit;
+		vector<int> _isPlayerBForfeit;
+		vector<int> _playerAShips;
+		vector<int> _playerBShips;
+		vector<int> _playerAPoints;
+		vector<int> _playerBPoints;
+		vector<int> _moves;
+		vector<int> _isActive;
+		vector<int> _isFaulted;
+
+		/** The current step of each game: the attacking player, the attacked board square (or NO_TARGET),
+		 *  the attack as the player made it, and its result
+		 */
+		vector<int> _attackers;
+		vector<int> _targets;
+		vector<Coordinate> _targetMoves;
+		vector<AttackResult> _attackResults;
+
+		/** Step arrays of resolveAttacks: the positions of the attacked piece and ship square of each game in
+		 *  _pieceLife and _shipSquareDamaged, their state, and the attacked piece's owner and points.
+		 *  The results are kept as ints (in AttackResult order) until they're scattered into _attackResults.
+		 */
+		vector<int> _stepLifePositions;
+		vector<int> _stepDamagedPositions;
+		vector<int> _stepLife;
+		vector<int> _stepDamaged;
+		vector<int> _stepIsPlayerAPiece;
+		vector<int> _stepPiecePoints;
+		vector<int> _stepHasTarget;
+		vector<int> _stepResults;
+
+		/** Resets the state of all games to the beginning of a game on the prototype */
+		void resetGames(int gamesCount);
+
+		/** Plays the games from their first move until all of them are over.
+		 *  Templated on the board dimensions (see BoardDims.h), so the common board shapes get the attacks' bounds
+		 *  checks and square indices with constant dimensions.
+		 */
+		template <typename Dims, typename PlayerAAlgo, typename PlayerBAlgo>
+		void playGames(const Dims& dims, const vector<PlayerAAlgo*>& playersA, const vector<PlayerBAlgo*>& playersB);
+
+		/** Applies a move of the game's current player that doesn't reach the board (a forfeit or an illegal attack),
+		 *  or sets the game's target square for resolveAttacks
+		 */
+		template <typename Dims>
+		void prepareAttack(const Dims& dims, int game, const Coordinate& move);
+
+		/** Executes the attacks of the current step in all games: updates the pieces, ship counts, points and
+		 *  turns of the games that attacked the board, and sets their attack results
+		 */
+		void resolveAttacks();
+
+		/** Resolves the gathered attacks of SIMD_LANES games, starting at the given game */
+		void resolveGatheredAttacks(int firstGame);
+
+		/** Deactivates the games that are over. Returns the number of games still active. */
+		int updateActiveGames();
+
+		/** Ends the game as a tie where nobody gets points, after one of its players threw */
+		void faultGame(int game, const exception& e);
+
+		/** Returns the results of all games */
+		vector<GameResults> collectResults() const;
+
+		/** Returns true if the next player of a game should be player A (false for player B), according to
+		 *  GameManager's turn rules: isSwitch is 1 if the last move was a miss, a hit on the attacker's own ship,
+		 *  or didn't reach the board
+		 */
+		static int nextPlayerIsA(int isSwitch, int isCurrPlayerA, int isPlayerAForfeit, int isPlayerBForfeit)
+		{
+			// A switch passes the turn to player B unless B forfeited, and back to player A unless A forfeited
+			return (isSwitch & ((isCurrPlayerA ^ 1) | isPlayerBForfeit) & (isPlayerAForfeit ^ 1)) |
+				   ((isSwitch ^ 1) & isCurrPlayerA);
+		}
+
+		/** nextPlayerIsA for SIMD_LANES games at once (each lane holds 0 or 1) */
+		static __m128i nextPlayerIsA(__m128i isSwitch, __m128i isCurrPlayerA, __m128i isPlayerAForfeit,
+									 __m128i isPlayerBForfeit)
+		{
+			const __m128i one = _mm_set1_epi32(1);
+			__m128i switchTurn = _mm_and_si128(_mm_and_si128(isSwitch,
+															 _mm_or_si128(_mm_xor_si128(isCurrPlayerA, one),
+																		  isPlayerBForfeit)),
+											   _mm_xor_si128(isPlayerAForfeit, one));
+			return _mm_or_si128(switchTurn, _mm_andnot_si128(isSwitch, isCurrPlayerA));
+		}
+	};
+
+	template <typename PlayerAAlgo, typename PlayerBAlgo>
+	vector<GameResults> LockstepGameEngine::runGames(const vector<PlayerAAlgo*>& playersA,
+													 const vector<PlayerBAlgo*>& playersB,
+													 const BoardData& playerAView, const BoardData& playerBView)
+	{
+		if (playersA.size() != playersB.size())
+		{
+			Logger::getInstance().log(Severity::ERROR_LEVEL, "Error: lockstep games got " +
+									  std::to_string(playersA.size()) + " A players and " +
+									  std::to_string(playersB.size()) + " B players.");
+			return vector<GameResults>();
+		}
+
+		resetGames(static_cast<int>(playersA.size()));
+
+		for (int game = 0; game < _gamesCount; game++)
+		{
+			try
+			{
+				playersA[game]->setPlayer(0);
+				playersB[game]->setPlayer(1);
+				playersA[game]->setBoard(playerAView);
+				playersB[game]->setBoard(playerBView);
+			}
+			catch (const exception& e)
+			{
+				faultGame(game, e);
+			}
+		}
+
+		dispatchBoardDims(_height, _width, _depth, [this, &playersA, &playersB](const auto& dims)
+		{
+			playGames(dims, playersA, playersB);
+		});
+
+		return collectResults();
+	}
+
+	template <typename Dims, typename PlayerAAlgo, typename PlayerBAlgo>
+	void LockstepGameEngine::playGames(const Dims& dims, const vector<PlayerAAlgo*>& playersA,
+									   const vector<PlayerBAlgo*>& playersB)
+	{
+		int activeGames = updateActiveGames();
+		while (activeGames > 0)
+		{
+			// Collect the moves of all active games
+			for (int game = 0; game < _gamesCount; game++)
+			{
+				_targets[game] = NO_TARGET;
+				if (!_isActive[game])
+					continue;
+
+				try
+				{
+					_attackers[game] = _isCurrPlayerA[game] ? 0 : 1;
+					Coordinate move = _isCurrPlayerA[game] ? playersA[game]->attack() : playersB[game]->attack();
+					prepareAttack(dims, game, move);
+				}
+				catch (const exception& e)
+				{
+					faultGame(game, e);
+				}
+			}
+
+			resolveAttacks();
+
+			// Notify both players of every game that attacked the board
+			for (int game = 0; game < _gamesCount; game++)
+			{
+				if (_targets[game] == NO_TARGET)
+					continue;
+
+				try
+				{
+					playersA[game]->notifyOnAttackResult(_attackers[game], _targetMoves[game], _attackResults[game]);
+					playersB[game]->notifyOnAttackResult(_attackers[game], _targetMoves[game], _attackResults[game]);
+				}
+				catch (const exception& e)
+				{
+					faultGame(game, e);
+				}
+			}
+
+			activeGames = updateActiveGames();
+		}
+	}
+
+	template <typename Dims>
+	void LockstepGameEngine::prepareAttack(const Dims& dims, int game, const Coordinate& move)
+	{
+		_moves[game]++;
+		_targetMoves[game] = move;
+
+		if (move == NO_MORE_MOVES)
+		{	// Player chose not to attack - from now on this player forfeits the game
+			if (_isCurrPlayerA[game])
+				_isPlayerAForfeit[game] = 1;
+			else
+				_isPlayerBForfeit[game] = 1;
+		}
+		else if (dims.isOnBoard(move))
+		{	// A legal attack, executed by resolveAttacks
+			_targets[game] = dims.squareIndex(move);
+			return;
+		}
+
+		// Forfeits and illegal attacks lose the turn
+		_isCurrPlayerA[game] = nextPlayerIsA(1, _isCurrPlayerA[game], _isPlayerAForfeit[game], _isPlayerBForfeit[game]);
+	}
+}
@@ -24,9 +24,9 @@ namespace battleship
 
 		// Stream errors are guaranteed to appear only after "flush",
 		// which is only guaranteed when we explicitly flush or close the file for writing
-		if (!_fs)
+		if ((_path != nullptr) && !_fs)
 		{
-			auto logFilePath = *_path + "\\" + LOG_FILE;
+			auto logFilePath = *_path + "\\" + _logFileName;
 			cerr << "Error: IO error when flushing logger content to " << logFilePath << endl;
 		}
 	}
@@ -52,6 +52,11 @@ namespace battleship
 			return "DEBUG";
 	}
 
+	bool Logger::isLoggable(Severity severity) const
+	{
+		return (_path != nullptr) && (severity >= _limit);
+	}
+
 	void Logger::log(Severity severity, const string& msg, bool isPrintToConsole)
 	{
 		// Errors are force printed to console as well
@@ -93,7 +98,7 @@ namespace battleship
 		return this;
 	}
 
-	Logger* Logger::setPath(const string& path)
+	Logger* Logger::setPath(const string& path, const string& logFileName)
 	{
 		// Avoid incorrect usage
 		if (_path)
@@ -102,8 +107,9 @@ namespace battleship
 		}
 
 		_path = std::make_unique<string>(path);
+		_logFileName = logFileName;
 
-		auto logFilePath = *_path + "\\" + LOG_FILE;
+		auto logFilePath = *_path + "\\" + _logFileName;
 
 		// This should create the logger
 		_fs.open(logFilePath, std::fstream::out | std::fstream::app);
@@ -46,15 +46,21 @@ namespace battleship
 		 */
 		Logger* setLevel(Severity limit);
 
-		/** Sets a path for the log file and creates it.
+		/** Returns true if messages of the given severity are written to the log file.
+		 *  Used to skip formatting messages on hot paths when they would be filtered anyway.
+		 */
+		bool isLoggable(Severity severity) const;
+
+		/** Sets a path for the log file and creates it (logFileName in path).
 		 *	The logger is usable only after this method is called.
 		 *  Repeated calls to this method do nothing.
 		 */
-		Logger* setPath(const string& path);
+		Logger* setPath(const string& path, const string& logFileName = LOG_FILE);
 
 	private:
-		static constexpr auto LOG_FILE = "game.log"; // Log file name
+		static constexpr auto LOG_FILE = "game.log"; // Default log file name
 		unique_ptr<string> _path; // Path of the log file, logger is active only after this is initialized
+		string _logFileName; // Name of the log file in _path
 
 		fstream _fs; // Logger file pointer
 		Severity _limit; // Limit of which log messages are filtered
@@ -3,6 +3,12 @@
 #include "IOUtil.h"
 #include "Logger.h"
 #include "CompetitionManager.h"
+#include "ShardCoordinator.h"
+#include "CompetitionJournal.h"
+#include "CompetitionManifest.h"
+#include "StaticAlgoRegistry.h"
+#include "ResultsExporter.h"
+#include "ResourceWatcher.h"
 #include <iostream>
 
 using std::exception;
@@ -14,6 +20,7 @@ using std::to_string;
 namespace battleship
 {
 	void MainBattleshipGame::startCompetition(const Configuration& config,
+											  const string& absolutePath,
 											  shared_ptr<BattleshipGameBoardFactory> boardFactory,
 											  shared_ptr<AlgoLoader> algoLoader)
 	{
@@ -27,14 +34,171 @@ namespace battleship
 			PRINT_TO_CONSOLE);
 
 		Logger::getInstance().log(Severity::DEBUG_LEVEL, "All resources validated, proceeding to competition");
-		CompetitionManager competitionMgr(boardFactory, algoLoader, config.threads);
 
-		Logger::getInstance().log(Severity::DEBUG_LEVEL, "Competition tasks ready to run..");
-		competitionMgr.run();
+		if (config.shardIndex != Configuration::NOT_A_SHARD)
+		{
+			// Shard process: play only this shard's games and record them for the coordinator
+			CompetitionManager competitionMgr(boardFactory, algoLoader, config.threads,
+											  CompetitionShard(config.shardIndex, config.shards));
+			competitionMgr.setResultsOutput(ShardCoordinator::shardResultsFile(absolutePath, config.shardIndex));
+			competitionMgr.scoreboard().setConsoleOutput(false);	// Only the coordinator prints the merged rounds
+			competitionMgr.setAlgoPoolCapacity(config.algoPoolCapacity);
+			competitionMgr.setParallelScanMinSquares(config.parallelScanMinSquares);
+			competitionMgr.setStatsOutput(absolutePath + "\\" + SHARD_STATS_FILE_PREFIX + to_string(config.shardIndex) +
+										  SHARD_STATS_FILE_SUFFIX, config.statsInterval);
+
+			// Shards only read the cache, so processes never write to the cache file at the same time
+			if (config.resultsCache)
+				competitionMgr.setResultsCache(absolutePath, config.randomSeed, config.resultsCacheVerify, true);
+
+			// The coordinator resumed the games its journal has, shards don't play them either.
+			// Only the coordinator writes to the journal (the games played by shards are journaled once merged).
+			if (config.checkpoint)
+			{
+				CompetitionJournal journal(absolutePath, algoLoader->loadedGameAlgos(),
+										   boardFactory->loadedBoardsList());
+				competitionMgr.mergeCompletedGames(journal.readCompletedGames());
+			}
+
+			// The coordinator reuses the unchanged games of the previous competition, shards don't play them either
+			if (config.incremental)
+			{
+				CompetitionManifest manifest(absolutePath, *algoLoader, *boardFactory);
+				competitionMgr.mergePreviousGames(manifest.loadUnchangedGames());
+			}
+
+			Logger::getInstance().log(Severity::DEBUG_LEVEL, "Shard #" + to_string(config.shardIndex) +
+									  " competition tasks ready to run..");
+			competitionMgr.run();
+		}
+		else
+		{
+			CompetitionManager competitionMgr(boardFactory, algoLoader, config.threads, CompetitionShard(),
+											  config.tournamentFormat);
+			competitionMgr.setAlgoPoolCapacity(config.algoPoolCapacity);
+			competitionMgr.setParallelScanMinSquares(config.parallelScanMinSquares);
+			competitionMgr.setStatsOutput(absolutePath + "\\" + STATS_FILE, config.statsInterval);
+			competitionMgr.scoreboard().setRatingSystem(config.ratingSystem);
+			if (config.resultsCache)
+				competitionMgr.setResultsCache(absolutePath, config.randomSeed, config.resultsCacheVerify);
+			CompetitionJournal journal(absolutePath, algoLoader->loadedGameAlgos(), boardFactory->loadedBoardsList());
+			CompetitionManifest manifest(absolutePath, *algoLoader, *boardFactory);
+
+			// Export every game the scoreboard sees, including games resumed from the journal or played by shards
+			unique_ptr<ResultsExporter> resultsExporter;
+			if (config.resultsExport != ResultsFormat::NONE)
+			{
+				string extension = ResultsExporter::fileExtension(config.resultsExport);
+				resultsExporter = std::make_unique<ResultsExporter>(absolutePath + "\\" + RESULTS_GAMES_FILE + extension,
+																	absolutePath + "\\" + RESULTS_STANDINGS_FILE + extension,
+																	config.resultsExport);
+				resultsExporter->attach(competitionMgr.scoreboard());
+			}
+
+			// Games of other formats depend on earlier results, they can't be resumed, reused or split between shards
+			bool isRoundRobin = (config.tournamentFormat == TournamentFormat::ROUND_ROBIN);
+			if (!isRoundRobin && (config.checkpoint || config.incremental || config.hotAdd || (config.shards > 1)))
+			{
+				Logger::getInstance().log(Severity::INFO_LEVEL,
+										  "Checkpoint, incremental competitions, hot-add and shards are only supported "
+										  "in round robin competitions, the tournament is played in this process "
+										  "without a journal and all of its games are played.",
+										  PRINT_TO_CONSOLE);
+			}
+
+			// The manifest of this competition records all of its games, including the ones merged below
+			bool isIncremental = config.incremental && isRoundRobin;
+			if (isIncremental)
+				manifest.attach(competitionMgr.scoreboard());
+
+			if (config.checkpoint && isRoundRobin)
+			{
+				// Resume from the games an interrupted run of this competition already completed,
+				// and journal every game completed from now on
+				auto completedGames = journal.loadCompletedGames();
+				if (!completedGames.empty())
+				{
+					Logger::getInstance().log(Severity::INFO_LEVEL,
+											  "Resuming competition, skipping " + to_string(completedGames.size()) +
+											  " completed games..",
+											  PRINT_TO_CONSOLE);
+					competitionMgr.mergeCompletedGames(completedGames);
+				}
+
+				competitionMgr.setResultsOutput(journal.filename(), true);
+			}
+
+			if (isIncremental)
+			{
+				// Only play the games of algorithms and boards that changed since the previous competition
+				competitionMgr.mergePreviousGames(manifest.loadUnchangedGames(), config.checkpoint);
+			}
+
+			if ((config.shards > 1) && isRoundRobin)
+			{
+				// Coordinator: let the shard processes play the games, then merge their results.
+				// Games lost with a failed shard remain queued and are played by this process.
+				Logger::getInstance().log(Severity::INFO_LEVEL,
+										  "Splitting competition between " + to_string(config.shards) + " shards..",
+										  PRINT_TO_CONSOLE);
+				ShardCoordinator shardCoordinator(config, absolutePath);
+				competitionMgr.mergeCompletedGames(shardCoordinator.runShards(), config.checkpoint);
+			}
+
+			// Boards and algorithms that appear in the path while the competition runs join it.
+			// Shards have played their games by now, so a split competition can't take new entrants.
+			unique_ptr<ResourceWatcher> resourceWatcher;
+			if (config.hotAdd && isRoundRobin && (config.shards <= 1))
+			{
+				resourceWatcher = std::make_unique<ResourceWatcher>(absolutePath, boardFactory, algoLoader,
+					[&competitionMgr](const vector<string>& newAlgos, const vector<string>& newBoards)
+				{
+					competitionMgr.addEntrants(newAlgos, newBoards);
+				});
+				resourceWatcher->start();
+			}
+
+			Logger::getInstance().log(Severity::DEBUG_LEVEL, "Competition tasks ready to run..");
+			competitionMgr.run();
+
+			if (resourceWatcher != nullptr)
+				resourceWatcher->stop();
+
+			if (resultsExporter != nullptr)
+				resultsExporter->close();
+
+			// The competition is complete, the next run starts a new one
+			if (config.checkpoint && isRoundRobin)
+				journal.discard();
+
+			// The next incremental competition reuses the games of this one
+			if (isIncremental)
+				manifest.save();
+		}
 
 		Logger::getInstance().log(Severity::INFO_LEVEL, "Battleship game ended.");
 	}
 
+	const vector<string>& MainBattleshipGame::generateRandomBoards(const Configuration& config,
+																   shared_ptr<BattleshipGameBoardFactory> boardFactory)
+	{
+		int rows = 0;
+		int cols = 0;
+		int depth = 0;
+
+		if (!BattleshipGameBoardFactory::parseDimensions(config.randomBoardSize, rows, cols, depth) ||
+			(rows < 1) || (cols < 1) || (depth < 1))
+		{
+			Logger::getInstance().log(Severity::WARNING_LEVEL,
+				"Invalid random board size: " + config.randomBoardSize + " (expected [cols]x[rows]x[depth])",
+				PRINT_TO_CONSOLE);
+			return boardFactory->loadedBoardsList();
+		}
+
+		RandomBoardSpec spec(cols, rows, depth, RandomBoardSpec::defaultShipMix());
+		return boardFactory->generateRandomBattleBoards(spec, config.randomBoards, config.randomSeed);
+	}
+
 	bool MainBattleshipGame::validateLoadedResources(const Configuration& config,
 												     const vector<string>& loadedBoards,
 												     const vector<string>& loadedAlgos)
@@ -67,8 +231,9 @@ namespace battleship
 														shared_ptr<AlgoLoader> algoLoader)
 	{
 		auto availableBoards = boardFactory->availableBoardsList();
+		bool isMissingBoards = availableBoards.empty() && (config.randomBoards == 0);
 
-		if (availableBoards.empty())
+		if (isMissingBoards)
 		{
 			Logger::getInstance().log(Severity::ERROR_LEVEL,
 				"No board files (*.sboard) looking in path: " + config.path,
@@ -76,15 +241,16 @@ namespace battleship
 		}
 
 		auto availableAlgos = algoLoader->availableGameAlgos();
+		bool isMissingAlgos = (availableAlgos.size() < 2) && !config.staticAlgos; // Compiled-in algos may fill the gap
 
-		if (availableAlgos.size() < 2)
+		if (isMissingAlgos)
 		{
 			Logger::getInstance().log(Severity::ERROR_LEVEL,
 				"Missing algorithm (dll) files looking in path: " + config.path + " (need at least two)",
 				PRINT_TO_CONSOLE);
 		}
 
-		if (availableBoards.empty() || availableAlgos.size() < 2)
+		if (isMissingBoards || isMissingAlgos)
 		{
 			Logger::getInstance().log(Severity::INFO_LEVEL, "Battleship game ended.");
 			return false;
@@ -107,7 +273,16 @@ namespace battleship
 
 	void MainBattleshipGame::startLogger(const Configuration& config, bool isLegalConfiguration)
 	{
-		Logger::getInstance().setPath(config.path)->setLevel(config.logSeverity);
+		if (config.shardIndex != Configuration::NOT_A_SHARD)
+		{
+			Logger::getInstance().setPath(config.path, SHARD_LOG_FILE_PREFIX + to_string(config.shardIndex) +
+										  SHARD_LOG_FILE_SUFFIX)->setLevel(config.logSeverity);
+		}
+		else
+		{
+			Logger::getInstance().setPath(config.path)->setLevel(config.logSeverity);
+		}
+
 		Logger::getInstance().log(Severity::INFO_LEVEL, "Battleship game started.");
 
 		// Report all accumulated configuration issues now that the logger is loaded
@@ -126,6 +301,24 @@ namespace battleship
 			Logger::getInstance().log(Severity::INFO_LEVEL, "Worker threads count = " + to_string(config.threads));
 			string severityStr = Logger::severityToString(config.logSeverity);
 			Logger::getInstance().log(Severity::INFO_LEVEL, "Logger level = " + severityStr);
+
+			if (config.randomBoards > 0)
+			{
+				Logger::getInstance().log(Severity::INFO_LEVEL,
+										  "Random boards = " + to_string(config.randomBoards) + " of size " +
+										  config.randomBoardSize + " (seed " + to_string(config.randomSeed) + ")");
+			}
+
+			if (config.shardIndex != Configuration::NOT_A_SHARD)
+			{
+				Logger::getInstance().log(Severity::INFO_LEVEL,
+										  "Running as shard #" + to_string(config.shardIndex) +
+										  " of " + to_string(config.shards));
+			}
+			else if (config.shards > 1)
+			{
+				Logger::getInstance().log(Severity::INFO_LEVEL, "Shards count = " + to_string(config.shards));
+			}
 		}
 		else
 		{
@@ -163,14 +356,22 @@ namespace battleship
 				return ERROR_CODE;
 
 			auto loadedBoards = boardFactory->loadAllBattleBoards();
+			if (config.randomBoards > 0)
+				loadedBoards = generateRandomBoards(config, boardFactory);
+
 			auto loadedAlgos = algoLoader->loadAllAvailableAlgorithms();
+			if (config.staticAlgos)
+			{	// Compiled-in algorithms are registered after the dlls, so a dll with the same name wins
+				StaticAlgoRegistry::registerAll(*algoLoader);
+				loadedAlgos = algoLoader->loadedGameAlgos();
+			}
 
 			// Validation #3: Not enough valid boards or dlls
 			if (!validateLoadedResources(config, loadedBoards, loadedAlgos))
 				return ERROR_CODE;
 
 			// All validations complete - begin battleship competition between resources
-			startCompetition(config, boardFactory, algoLoader);
+			startCompetition(config, absolutePath, boardFactory, algoLoader);
 
 			return SUCCESS_CODE;
 		}
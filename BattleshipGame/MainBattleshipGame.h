@@ -31,14 +31,39 @@ namespace battleship
 		/** For logger param - to make it clear which messages are printed to the console */
 		static constexpr bool PRINT_TO_CONSOLE = true;
 
+		/** Name of the worker stats file of a competition that isn't split (see Configuration::statsInterval) */
+		static constexpr auto STATS_FILE = "worker_stats.json";
+
+		/** Name of the worker stats file of shard processes: prefix, shard index, suffix */
+		static constexpr auto SHARD_STATS_FILE_PREFIX = "worker_stats.shard";
+		static constexpr auto SHARD_STATS_FILE_SUFFIX = ".json";
+
+		/** Name of the log file of shard processes, so shards don't share the game log: prefix, shard index, suffix */
+		static constexpr auto SHARD_LOG_FILE_PREFIX = "game.shard";
+		static constexpr auto SHARD_LOG_FILE_SUFFIX = ".log";
+
+		/** Names of the results export files, without the format's extension (see Configuration::resultsExport) */
+		static constexpr auto RESULTS_GAMES_FILE = "results_games.";
+		static constexpr auto RESULTS_STANDINGS_FILE = "results_standings.";
+
 		/** Hide the ctor - this class shouldn't be instantiated */
 		MainBattleshipGame() = default;
 
-		/** Begin the competition after all resources have been loaded and validated */
+		/** Begin the competition after all resources have been loaded and validated.
+		 *  Depending on the configuration, the competition is played in this process, split between shard
+		 *  processes, or this process is itself a shard that plays its part of the competition.
+		 */
 		static void startCompetition(const Configuration& config,
+									 const string& absolutePath,
 									 shared_ptr<BattleshipGameBoardFactory> boardFactory,
 									 shared_ptr<AlgoLoader> algoLoader);
 
+		/** Generates the random boards requested by the configuration, in addition to the loaded board files.
+		 *  Returns the updated list of boards available for creation.
+		 */
+		static const vector<string>& generateRandomBoards(const Configuration& config,
+														  shared_ptr<BattleshipGameBoardFactory> boardFactory);
+
 		/** Validate that there are enough valid loaded boards and algorithms */
 		static bool validateLoadedResources(const Configuration& config,
 											const vector<string>& loadedBoards,
@@ -0,0 +1,107 @@
+#include "BoardMicrobenchmarks.h"
+#include "RandomBoardGenerator.h"
+#include "IOUtil.h"
+#include <iostream>
+#include <iomanip>
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::setw;
+using std::left;
+using std::exception;
+using std::string;
+using namespace battleship;
+
+/** Default directory of the board files to benchmark (relative to the project's working directory) */
+static constexpr auto DEFAULT_BOARDS_PATH = "..\\Test Files\\Good Boards";
+
+/** Default JSON results file */
+static constexpr auto DEFAULT_OUTPUT_FILE = "microbenchmark.json";
+
+/** Default number of measured runs of each benchmark */
+static constexpr int DEFAULT_REPETITIONS = 5;
+
+/** Sizes of the generated large boards benchmarked in addition to the board files */
+static const RandomBoardSpec GENERATED_BOARDS[] = {
+	RandomBoardSpec(20, 20, 20, RandomBoardSpec::defaultShipMix()),
+	RandomBoardSpec(30, 30, 30, RandomBoardSpec::defaultShipMix())
+};
+
+/** Seed of the generated boards */
+static constexpr unsigned int GENERATED_BOARDS_SEED = 0;
+
+int main(int argc, char* argv[])
+{
+	try
+	{
+		string boardsPath = DEFAULT_BOARDS_PATH;
+		string outputFile = DEFAULT_OUTPUT_FILE;
+		int repetitions = DEFAULT_REPETITIONS;
+		double iterationsScale = 1.0;
+
+		for (int i = 1; i + 1 < argc; i += 2)
+		{
+			string arg = argv[i];
+			string value = argv[i + 1];
+
+			if (arg == "-boards")
+				boardsPath = value;
+			else if (arg == "-output")
+				outputFile = value;
+			else if ((arg == "-repeat") && IOUtil::isInteger(value))
+				repetitions = std::stoi(value);
+			else if (arg == "-scale")
+				iterationsScale = std::stod(value);
+			else
+			{
+				cerr << "Error: Illegal argument " << arg << ". Try: BattleshipMicrobenchmark [-boards <path>] "
+					 << "[-repeat <#count>] [-scale <iterations multiplier>] [-output <file>]" << endl;
+				return -1;
+			}
+		}
+
+		MicroBenchmarkRunner runner(repetitions, iterationsScale);
+
+		// Board files
+		const string absoluteBoardsPath = IOUtil::convertPathToAbsolute(boardsPath);
+		auto factory = std::make_shared<BattleshipGameBoardFactory>(absoluteBoardsPath);
+		for (const auto& boardFilename : factory->availableBoardsList())
+		{
+			string boardFile = absoluteBoardsPath + "\\" + boardFilename;
+			shared_ptr<const BattleBoard> board = factory->buildBoardFromFile(boardFile);
+			if (board != nullptr)
+				BoardMicrobenchmarks::addBenchmarks(runner, boardFilename, board, factory, boardFile);
+		}
+
+		// Generated large boards
+		for (const auto& spec : GENERATED_BOARDS)
+		{
+			RandomBoardGenerator generator(spec, GENERATED_BOARDS_SEED);
+			shared_ptr<const BattleBoard> board = generator.generate();
+			string boardName = "generated_" + std::to_string(spec.width) + "x" + std::to_string(spec.height) + "x" +
+							   std::to_string(spec.depth);
+			if (board != nullptr)
+				BoardMicrobenchmarks::addBenchmarks(runner, boardName, board, factory, "");
+		}
+
+		cout << left << setw(80) << "Benchmark" << setw(12) << "Iterations" << setw(14) << "ns/op"
+			 << setw(12) << "allocs/op" << setw(12) << "bytes/op" << endl;
+
+		auto results = runner.runAll();
+
+		if (!MicroBenchmarkRunner::writeJson(results, outputFile))
+		{
+			cerr << "Error: Failed to write benchmark results to " << outputFile << endl;
+			return -1;
+		}
+
+		cout << endl << "Results written to " << outputFile << endl;
+		return 0;
+	}
+	catch (const exception& e)
+	{
+		cerr << "Error: General error of type " << e.what() << endl;
+		return -1;
+	}
+}
@@ -0,0 +1,30 @@
+#include "TournamentBenchmark.h"
+#include <iostream>
+
+using std::cerr;
+using std::endl;
+using std::exception;
+using std::string;
+
+int main(int argc, char* argv[])
+{
+	try
+	{
+		battleship::TournamentBenchmarkConfig config;
+		string error;
+
+		if (!config.parseArgs(argc, argv, error))
+		{
+			cerr << error << endl;
+			return battleship::TournamentBenchmark::ERROR_CODE;
+		}
+
+		battleship::TournamentBenchmark benchmark(config);
+		return benchmark.run();
+	}
+	catch (const exception& e)
+	{
+		cerr << "Error: General error of type " << e.what() << endl;
+		return battleship::TournamentBenchmark::ERROR_CODE;
+	}
+}
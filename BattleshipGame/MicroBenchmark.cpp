@@ -0,0 +1,155 @@
+#include "MicroBenchmark.h"
+#include "AllocationCounter.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <algorithm>
+
+using std::cout;
+using std::endl;
+using std::setw;
+using std::setprecision;
+using std::fixed;
+using std::left;
+using std::ofstream;
+using std::max;
+using std::chrono::steady_clock;
+using std::chrono::duration;
+using std::nano;
+
+namespace battleship
+{
+	MicroBenchmarkState::MicroBenchmarkState(long long iterations) :
+		_iterations(iterations),
+		_isRunning(false),
+		_startAllocations(0),
+		_startBytes(0),
+		_elapsedNanos(0),
+		_allocations(0),
+		_allocatedBytes(0),
+		_sink(0)
+	{
+	}
+
+	long long MicroBenchmarkState::iterations() const
+	{
+		return _iterations;
+	}
+
+	void MicroBenchmarkState::pauseTiming()
+	{
+		if (!_isRunning)
+			return;
+
+		_elapsedNanos += duration<double, nano>(steady_clock::now() - _startTime).count();
+		_allocations += AllocationCounter::allocationsCount() - _startAllocations;
+		_allocatedBytes += AllocationCounter::allocatedBytes() - _startBytes;
+		_isRunning = false;
+	}
+
+	void MicroBenchmarkState::resumeTiming()
+	{
+		if (_isRunning)
+			return;
+
+		_isRunning = true;
+		_startAllocations = AllocationCounter::allocationsCount();
+		_startBytes = AllocationCounter::allocatedBytes();
+		_startTime = steady_clock::now();
+	}
+
+	void MicroBenchmarkState::consume(long long value)
+	{
+		_sink = _sink + value;
+	}
+
+	MicroBenchmarkRunner::MicroBenchmarkRunner(int repetitions, double iterationsScale) :
+		_repetitions(max(1, repetitions)),
+		_iterationsScale(iterationsScale)
+	{
+	}
+
+	void MicroBenchmarkRunner::add(const string& name, long long iterations, BenchmarkBody body)
+	{
+		_benchmarks.push_back(BenchmarkEntry{ name, iterations, std::move(body) });
+	}
+
+	MicroBenchmarkResult MicroBenchmarkRunner::runOnce(const BenchmarkEntry& benchmark, long long iterations)
+	{
+		MicroBenchmarkState state(iterations);
+		state.resumeTiming();
+		benchmark.body(state);
+		state.pauseTiming();
+
+		MicroBenchmarkResult result;
+		result.name = benchmark.name;
+		result.iterations = iterations;
+		result.nanosPerOp = state._elapsedNanos / iterations;
+		result.allocationsPerOp = static_cast<double>(state._allocations) / iterations;
+		result.bytesPerOp = static_cast<double>(state._allocatedBytes) / iterations;
+		return result;
+	}
+
+	vector<MicroBenchmarkResult> MicroBenchmarkRunner::runAll() const
+	{
+		vector<MicroBenchmarkResult> results;
+
+		for (const auto& benchmark : _benchmarks)
+		{
+			long long iterations = max(1LL, static_cast<long long>(benchmark.iterations * _iterationsScale));
+
+			// Warm up caches and lazily initialized state, the warm up run isn't reported
+			runOnce(benchmark, max(1LL, iterations / 10));
+
+			vector<MicroBenchmarkResult> measurements;
+			for (int repetition = 0; repetition < _repetitions; repetition++)
+			{
+				measurements.push_back(runOnce(benchmark, iterations));
+			}
+
+			// Report the median run, it's the least sensitive to noise from the rest of the machine
+			std::sort(measurements.begin(), measurements.end(),
+					  [](const MicroBenchmarkResult& a, const MicroBenchmarkResult& b) { return a.nanosPerOp < b.nanosPerOp; });
+			results.push_back(measurements[measurements.size() / 2]);
+
+			printResults({ results.back() });
+		}
+
+		return results;
+	}
+
+	void MicroBenchmarkRunner::printResults(const vector<MicroBenchmarkResult>& results)
+	{
+		for (const auto& result : results)
+		{
+			cout << left << setw(80) << result.name
+				 << setw(12) << result.iterations
+				 << setw(14) << setprecision(1) << fixed << result.nanosPerOp
+				 << setw(12) << setprecision(2) << fixed << result.allocationsPerOp
+				 << setw(12) << setprecision(1) << fixed << result.bytesPerOp << endl;
+		}
+	}
+
+	bool MicroBenchmarkRunner::writeJson(const vector<MicroBenchmarkResult>& results, const string& filename)
+	{
+		ofstream fs(filename, std::ofstream::out | std::ofstream::trunc);
+		if (!fs.is_open())
+			return false;
+
+		fs << "{" << endl << "  \"benchmark\": \"micro\"," << endl << "  \"results\": [" << endl;
+
+		for (size_t i = 0; i < results.size(); i++)
+		{
+			const auto& result = results[i];
+			fs << "    { \"name\": \"" << result.name << "\""
+			   << ", \"iterations\": " << result.iterations
+			   << ", \"ns_per_op\": " << setprecision(3) << fixed << result.nanosPerOp
+			   << ", \"allocs_per_op\": " << result.allocationsPerOp
+			   << ", \"bytes_per_op\": " << result.bytesPerOp
+			   << " }" << ((i + 1 < results.size()) ? "," : "") << endl;
+		}
+
+		fs << "  ]" << endl << "}" << endl;
+		return fs.good();
+	}
+}
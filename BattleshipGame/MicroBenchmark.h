@@ -0,0 +1,104 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <chrono>
+
+using std::string;
+using std::vector;
+using std::function;
+
+namespace battleship
+{
+	/** Passed to a microbenchmark body: holds the number of iterations to run, and lets the body exclude
+	 *  setup work from the measurement.
+	 */
+	class MicroBenchmarkState
+	{
+	public:
+		MicroBenchmarkState(long long iterations);
+		virtual ~MicroBenchmarkState() = default;
+
+		/** Number of operations the body should run */
+		long long iterations() const;
+
+		/** Stops measuring time and allocations (e.g. while preparing inputs) */
+		void pauseTiming();
+
+		/** Resumes measuring time and allocations */
+		void resumeTiming();
+
+		/** Keeps the value "used", so the compiler can't optimize away the operation that produced it */
+		void consume(long long value);
+
+		friend class MicroBenchmarkRunner;
+
+	private:
+		long long _iterations;
+		bool _isRunning;
+		std::chrono::steady_clock::time_point _startTime;
+		long long _startAllocations;
+		long long _startBytes;
+
+		// Measurements accumulated while running
+		double _elapsedNanos;
+		long long _allocations;
+		long long _allocatedBytes;
+
+		volatile long long _sink;
+	};
+
+	/** Measurements of a single microbenchmark */
+	struct MicroBenchmarkResult
+	{
+		string name;
+		long long iterations;
+		double nanosPerOp;
+		double allocationsPerOp;
+		double bytesPerOp;
+	};
+
+	/** Runs microbenchmarks with fixed iteration counts, so results of different runs are comparable.
+	 *  Each benchmark is warmed up once and then measured several times; the median time is reported.
+	 */
+	class MicroBenchmarkRunner
+	{
+	public:
+		/** Microbenchmark body - runs state.iterations() operations */
+		using BenchmarkBody = function<void(MicroBenchmarkState& state)>;
+
+		/** repetitions is the number of measured runs of each benchmark, and iterationsScale multiplies
+		 *  all the iteration counts (for quick runs or more precise ones)
+		 */
+		MicroBenchmarkRunner(int repetitions, double iterationsScale);
+		virtual ~MicroBenchmarkRunner() = default;
+
+		/** Adds a benchmark to run */
+		void add(const string& name, long long iterations, BenchmarkBody body);
+
+		/** Runs all added benchmarks in the order they were added */
+		vector<MicroBenchmarkResult> runAll() const;
+
+		/** Prints the results table to the console */
+		static void printResults(const vector<MicroBenchmarkResult>& results);
+
+		/** Writes the results as JSON to the given file. Returns false on IO errors. */
+		static bool writeJson(const vector<MicroBenchmarkResult>& results, const string& filename);
+
+	private:
+		struct BenchmarkEntry
+		{
+			string name;
+			long long iterations;
+			BenchmarkBody body;
+		};
+
+		int _repetitions;
+		double _iterationsScale;
+		vector<BenchmarkEntry> _benchmarks;
+
+		/** Runs a single measurement of the benchmark */
+		static MicroBenchmarkResult runOnce(const BenchmarkEntry& benchmark, long long iterations);
+	};
+}
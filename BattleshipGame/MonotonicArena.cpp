@@ -0,0 +1,74 @@
+#include "MonotonicArena.h"
+#include <algorithm>
+
+namespace battleship
+{
+	MonotonicArena::MonotonicArena(size_t initialBlockSize) :
+		_offset(0),
+		_liveAllocationsCount(0)
+	{
+		_blocks.emplace_back(new char[initialBlockSize]);
+		_blockSizes.push_back(initialBlockSize);
+	}
+
+	void MonotonicArena::addBlock(size_t minSize)
+	{
+		size_t blockSize = std::max(_blockSizes.back() * 2, minSize);
+		_blocks.emplace_back(new char[blockSize]);
+		_blockSizes.push_back(blockSize);
+		_offset = 0;
+	}
+
+	void* MonotonicArena::allocate(size_t size, size_t alignment)
+	{
+		// Blocks are allocated with the fundamental alignment, so aligning the offset aligns the address
+		size_t alignedOffset = (_offset + alignment - 1) & ~(alignment - 1);
+		if (alignedOffset + size > _blockSizes.back())
+		{
+			addBlock(size);
+			alignedOffset = 0;
+		}
+
+		_offset = alignedOffset + size;
+		_liveAllocationsCount++;
+		return _blocks.back().get() + alignedOffset;
+	}
+
+	void MonotonicArena::deallocate(void*, size_t)
+	{
+		_liveAllocationsCount--;
+	}
+
+	bool MonotonicArena::release()
+	{
+		if (_liveAllocationsCount > 0)
+			return false;
+
+		// Merge the blocks, so the next game fits in a single block
+		if (_blocks.size() > 1)
+		{
+			size_t totalSize = capacity();
+			_blocks.clear();
+			_blockSizes.clear();
+			_blocks.emplace_back(new char[totalSize]);
+			_blockSizes.push_back(totalSize);
+		}
+
+		_offset = 0;
+		return true;
+	}
+
+	size_t MonotonicArena::liveAllocationsCount() const
+	{
+		return _liveAllocationsCount;
+	}
+
+	size_t MonotonicArena::capacity() const
+	{
+		size_t totalSize = 0;
+		for (size_t blockSize : _blockSizes)
+			totalSize += blockSize;
+
+		return totalSize;
+	}
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <new>
+
+using std::unique_ptr;
+using std::vector;
+
+namespace battleship
+{
+	/** Monotonic (bump pointer) memory arena for the objects of a single game.
+	 *  Allocation advances a pointer within the current memory block, and deallocation only counts the allocation
+	 *  as freed - the memory of all allocations is reclaimed at once by release(), once the game is over.
+	 *  Blocks are kept between games, and a game that spilled into several blocks makes release() merge them into a
+	 *  single block, so after the first few games the arena doesn't call the general purpose allocator at all.
+	 *  Not thread safe: an arena belongs to a single worker thread.
+	 */
+	class MonotonicArena
+	{
+	public:
+		MonotonicArena(size_t initialBlockSize = DEFAULT_BLOCK_SIZE);
+		virtual ~MonotonicArena() = default;
+
+		MonotonicArena(MonotonicArena const&) = delete;	// Disable copying
+		MonotonicArena& operator=(MonotonicArena const&) = delete;	// Disable copying (assignment)
+
+		/** Returns size bytes of memory aligned to alignment (a power of 2, not stricter than the fundamental alignment) */
+		void* allocate(size_t size, size_t alignment);
+
+		/** Marks an allocation as freed. The memory itself is reclaimed by release(). */
+		void deallocate(void* memory, size_t size);
+
+		/** Reclaims the memory of all allocations at once.
+		 *  If some allocations weren't deallocated yet nothing is reclaimed (their objects may still be in use),
+		 *  and false is returned.
+		 */
+		bool release();
+
+		/** Number of allocations that weren't deallocated yet */
+		size_t liveAllocationsCount() const;
+
+		/** Total size of the arena's memory blocks */
+		size_t capacity() const;
+
+	private:
+		/** Size of the first memory block, enough for a game on a mid sized board */
+		static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+		/** Memory blocks and their sizes, allocations are made from the last one */
+		vector<unique_ptr<char[]>> _blocks;
+		vector<size_t> _blockSizes;
+
+		/** Offset of the free memory in the last block */
+		size_t _offset;
+
+		size_t _liveAllocationsCount;
+
+		/** Adds a block of at least minSize bytes (double the size of the last block, unless more is needed) */
+		void addBlock(size_t minSize);
+	};
+
+	/** Standard allocator over a MonotonicArena, for the containers and shared objects of a game.
+	 *  A default constructed allocator (no arena) allocates from the general purpose heap, so the same container
+	 *  types serve long lived objects (e.g. board prototypes) as well.
+	 */
+	template <typename T>
+	class ArenaAllocator
+	{
+	public:
+		using value_type = T;
+
+		ArenaAllocator() : _arena(nullptr) {}
+		explicit ArenaAllocator(MonotonicArena* arena) : _arena(arena) {}
+
+		template <typename U>
+		ArenaAllocator(const ArenaAllocator<U>& other) : _arena(other.arena()) {}
+
+		T* allocate(size_t count)
+		{
+			if (_arena == nullptr)
+				return static_cast<T*>(::operator new(count * sizeof(T)));
+
+			return static_cast<T*>(_arena->allocate(count * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T* memory, size_t count)
+		{
+			if (_arena == nullptr)
+				::operator delete(memory);
+			else
+				_arena->deallocate(memory, count * sizeof(T));
+		}
+
+		/** The arena the memory is allocated from, or NULL for the heap */
+		MonotonicArena* arena() const { return _arena; }
+
+	private:
+		MonotonicArena* _arena;
+	};
+
+	template <typename T, typename U>
+	bool operator==(const ArenaAllocator<T>& allocator1, const ArenaAllocator<U>& allocator2)
+	{
+		return allocator1.arena() == allocator2.arena();
+	}
+
+	template <typename T, typename U>
+	bool operator!=(const ArenaAllocator<T>& allocator1, const ArenaAllocator<U>& allocator2)
+	{
+		return !(allocator1 == allocator2);
+	}
+}
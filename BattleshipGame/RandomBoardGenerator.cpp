@@ -0,0 +1,193 @@
+#include "RandomBoardGenerator.h"
+#include "BoardBuilder.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cctype>
+#include <string>
+
+using std::uniform_int_distribution;
+using std::to_string;
+
+namespace battleship
+{
+	RandomBoardSpec::RandomBoardSpec(int aWidth, int aHeight, int aDepth, vector<BoardSquare> aShipMix) :
+		width(aWidth),
+		height(aHeight),
+		depth(aDepth),
+		shipMix(std::move(aShipMix))
+	{
+	}
+
+	vector<BoardSquare> RandomBoardSpec::defaultShipMix()
+	{
+		return { BoardSquare::RubberBoat, BoardSquare::RocketShip, BoardSquare::Submarine, BoardSquare::Battleship };
+	}
+
+	RandomBoardGenerator::RandomBoardGenerator(const RandomBoardSpec& spec, unsigned int seed) :
+		_spec(spec),
+		_randomEngine(seed)
+	{
+		// Ignore squares that don't represent a ship
+		auto& mix = _spec.shipMix;
+		mix.erase(std::remove_if(mix.begin(), mix.end(),
+								 [](BoardSquare ship) { return BattleBoard::shipTypeOf(ship) == nullptr; }),
+				  mix.end());
+
+		// Place big ships first, they are the hardest to fit once the board gets crowded
+		std::stable_sort(mix.begin(), mix.end(), [](BoardSquare ship1, BoardSquare ship2)
+		{
+			return BattleBoard::shipTypeOf(ship1)->_size > BattleBoard::shipTypeOf(ship2)->_size;
+		});
+	}
+
+	int RandomBoardGenerator::squareIndex(int row, int col, int depth) const
+	{
+		return (depth * _spec.height + row) * _spec.width + col;
+	}
+
+	bool RandomBoardGenerator::isOccupied(int row, int col, int depth) const
+	{
+		if ((row < 0) || (row >= _spec.height) || (col < 0) || (col >= _spec.width) ||
+			(depth < 0) || (depth >= _spec.depth))
+		{
+			return false;
+		}
+
+		return _squares[squareIndex(row, col, depth)] != static_cast<char>(BoardSquare::Empty);
+	}
+
+	bool RandomBoardGenerator::canPlaceShip(const Coordinate& firstPos, int size, Orientation orient) const
+	{
+		int deltaCol = (orient == Orientation::X_AXIS) ? 1 : 0;
+		int deltaRow = (orient == Orientation::Y_AXIS) ? 1 : 0;
+		int deltaDepth = (orient == Orientation::Z_AXIS) ? 1 : 0;
+
+		for (int index = 0; index < size; index++)
+		{
+			int row = firstPos.row + index * deltaRow;
+			int col = firstPos.col + index * deltaCol;
+			int depth = firstPos.depth + index * deltaDepth;
+
+			if ((row >= _spec.height) || (col >= _spec.width) || (depth >= _spec.depth))
+				return false;
+
+			// The square itself and all of its side neighbours must be empty,
+			// otherwise BoardBuilder would merge the ships or report them as adjacent
+			if (isOccupied(row, col, depth) ||
+				isOccupied(row + 1, col, depth) || isOccupied(row - 1, col, depth) ||
+				isOccupied(row, col + 1, depth) || isOccupied(row, col - 1, depth) ||
+				isOccupied(row, col, depth + 1) || isOccupied(row, col, depth - 1))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool RandomBoardGenerator::placeShip(BoardSquare ship, PlayerEnum player)
+	{
+		const ShipType* shipType = BattleBoard::shipTypeOf(ship);
+		int size = shipType->_size;
+
+		// Only orientations the ship physically fits in are drawn
+		vector<Orientation> orientations;
+		if (size <= _spec.width)
+			orientations.push_back(Orientation::X_AXIS);
+		if ((size > 1) && (size <= _spec.height))
+			orientations.push_back(Orientation::Y_AXIS);
+		if ((size > 1) && (size <= _spec.depth))
+			orientations.push_back(Orientation::Z_AXIS);
+
+		if (orientations.empty())
+			return false;
+
+		uniform_int_distribution<size_t> orientDist(0, orientations.size() - 1);
+		char shipChar = static_cast<char>(shipType->_representation);
+		if (player == PlayerEnum::B)
+			shipChar = static_cast<char>(tolower(shipChar));
+
+		for (int attempt = 0; attempt < MAX_SHIP_PLACEMENT_ATTEMPTS; attempt++)
+		{
+			Orientation orient = orientations[orientDist(_randomEngine)];
+			int extentCol = (orient == Orientation::X_AXIS) ? size : 1;
+			int extentRow = (orient == Orientation::Y_AXIS) ? size : 1;
+			int extentDepth = (orient == Orientation::Z_AXIS) ? size : 1;
+
+			uniform_int_distribution<int> rowDist(0, _spec.height - extentRow);
+			uniform_int_distribution<int> colDist(0, _spec.width - extentCol);
+			uniform_int_distribution<int> depthDist(0, _spec.depth - extentDepth);
+			Coordinate firstPos(rowDist(_randomEngine), colDist(_randomEngine), depthDist(_randomEngine));
+
+			if (canPlaceShip(firstPos, size, orient))
+			{
+				int deltaCol = (orient == Orientation::X_AXIS) ? 1 : 0;
+				int deltaRow = (orient == Orientation::Y_AXIS) ? 1 : 0;
+				int deltaDepth = (orient == Orientation::Z_AXIS) ? 1 : 0;
+
+				for (int index = 0; index < size; index++)
+				{
+					_squares[squareIndex(firstPos.row + index * deltaRow,
+										 firstPos.col + index * deltaCol,
+										 firstPos.depth + index * deltaDepth)] = shipChar;
+				}
+
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool RandomBoardGenerator::placeAllShips()
+	{
+		_squares.assign(_spec.width * _spec.height * _spec.depth, static_cast<char>(BoardSquare::Empty));
+
+		// Alternate between players so both get a fair share of the free space
+		for (const auto& ship : _spec.shipMix)
+		{
+			if (!placeShip(ship, PlayerEnum::A) || !placeShip(ship, PlayerEnum::B))
+				return false;
+		}
+
+		return true;
+	}
+
+	unique_ptr<BattleBoard> RandomBoardGenerator::generate()
+	{
+		if ((_spec.width < 1) || (_spec.height < 1) || (_spec.depth < 1) || _spec.shipMix.empty())
+		{
+			Logger::getInstance().log(Severity::WARNING_LEVEL, "Random board generator was given an empty board spec");
+			return nullptr;
+		}
+
+		for (int attempt = 0; attempt < MAX_BOARD_ATTEMPTS; attempt++)
+		{
+			if (!placeAllShips())
+				continue;
+
+			// Feed the board to a BoardBuilder, same as a board loaded from a file
+			BoardBuilder builder(_spec.width, _spec.height, _spec.depth);
+			for (int depth = 0; depth < _spec.depth; depth++)
+			{
+				for (int row = 0; row < _spec.height; row++)
+				{
+					for (int col = 0; col < _spec.width; col++)
+					{
+						char square = _squares[squareIndex(row, col, depth)];
+						if (square != static_cast<char>(BoardSquare::Empty))
+							builder.addPiece(Coordinate(row, col, depth), square);
+					}
+				}
+			}
+
+			return builder.build();
+		}
+
+		Logger::getInstance().log(Severity::WARNING_LEVEL,
+								  "Random board generator couldn't fit " + to_string(_spec.shipMix.size()) +
+								  " ships per player in a " + to_string(_spec.width) + "x" + to_string(_spec.height) +
+								  "x" + to_string(_spec.depth) + " board");
+		return nullptr;
+	}
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <random>
+#include "BattleBoard.h"
+#include "AlgoCommon.h"
+
+using std::unique_ptr;
+using std::vector;
+using std::mt19937;
+
+namespace battleship
+{
+	/** Describes the boards a RandomBoardGenerator should produce: dimensions and the ships each player gets.
+	 *  Both players receive the exact same ship mix, so generated boards are always balanced.
+	 */
+	struct RandomBoardSpec
+	{
+		int width;	// Number of columns
+		int height;	// Number of rows
+		int depth;	// Number of levels
+		vector<BoardSquare> shipMix; // Ships placed for each of the players
+
+		RandomBoardSpec(int aWidth, int aHeight, int aDepth, vector<BoardSquare> aShipMix);
+
+		/** Default ship mix: one ship of each type per player */
+		static vector<BoardSquare> defaultShipMix();
+	};
+
+	/** Generates random valid battle boards out of a seed.
+	 *  Ships are placed so that they never touch each other (by side), which means every board produced satisfies
+	 *  the BoardBuilder shape and adjacency rules by construction.
+	 *  The same seed and spec always reproduce the same sequence of boards.
+	 */
+	class RandomBoardGenerator
+	{
+	public:
+		RandomBoardGenerator(const RandomBoardSpec& spec, unsigned int seed);
+		virtual ~RandomBoardGenerator() = default;
+
+		RandomBoardGenerator(RandomBoardGenerator const&) = delete;	// Disable copying
+		RandomBoardGenerator& operator=(RandomBoardGenerator const&) = delete;	// Disable copying (assignment)
+
+		/** Generates the next board in the sequence.
+		 *  Returns NULL if the ship mix couldn't be fit into the board dimensions.
+		 */
+		unique_ptr<BattleBoard> generate();
+
+	private:
+		/** Number of random positions tried for a single ship before the whole board is restarted */
+		static constexpr int MAX_SHIP_PLACEMENT_ATTEMPTS = 200;
+
+		/** Number of times a board is restarted before the generator gives up */
+		static constexpr int MAX_BOARD_ATTEMPTS = 100;
+
+		RandomBoardSpec _spec;
+		mt19937 _randomEngine;
+
+		/** Board squares of the board currently generated, indexed by (depth, row, col) */
+		vector<char> _squares;
+
+		/** Flat index of (row, col, depth) within _squares */
+		int squareIndex(int row, int col, int depth) const;
+
+		/** Returns true if the square is inside the board and is occupied by a ship */
+		bool isOccupied(int row, int col, int depth) const;
+
+		/** Returns true if a ship of the given size can be put in firstPos (lowest coordinate) and orientation,
+		 *  without exceeding the board or touching another ship.
+		 */
+		bool canPlaceShip(const Coordinate& firstPos, int size, Orientation orient) const;
+
+		/** Tries to put a single ship in a random position. Returns false if no legal position was found. */
+		bool placeShip(BoardSquare ship, PlayerEnum player);
+
+		/** Tries to put the entire ship mix for both players on an empty board */
+		bool placeAllShips();
+	};
+}
@@ -0,0 +1,133 @@
+#include "RatingEngine.h"
+#include <cmath>
+
+namespace battleship
+{
+	PlayerRating::PlayerRating(double aElo, double aGlicko, double aGlickoDeviation, double aGlickoVolatility) :
+		elo(aElo),
+		glicko(aGlicko),
+		glickoDeviation(aGlickoDeviation),
+		glickoVolatility(aGlickoVolatility)
+	{
+	}
+
+	RatingEngine::RatingEngine(size_t playersCount) :
+		_ratings(playersCount,
+				 PlayerRating(INITIAL_RATING, INITIAL_RATING, GLICKO_INITIAL_DEVIATION, GLICKO_INITIAL_VOLATILITY))
+	{
+	}
+
+	void RatingEngine::updateWithGame(size_t playerAId, size_t playerBId, PlayerEnum winner)
+	{
+		// Both players are rated against the opponent's ratings from before the game
+		PlayerRating playerA = _ratings[playerAId];
+		PlayerRating playerB = _ratings[playerBId];
+		double playerAScore = gameScore(PlayerEnum::A, winner);
+		double playerBScore = gameScore(PlayerEnum::B, winner);
+
+		_ratings[playerAId] = updatedGlicko(playerA, playerB, playerAScore);
+		_ratings[playerAId].elo = updatedElo(playerA, playerB, playerAScore);
+		_ratings[playerBId] = updatedGlicko(playerB, playerA, playerBScore);
+		_ratings[playerBId].elo = updatedElo(playerB, playerA, playerBScore);
+	}
+
+	void RatingEngine::addPlayer()
+	{
+		_ratings.push_back(PlayerRating(INITIAL_RATING, INITIAL_RATING, GLICKO_INITIAL_DEVIATION,
+										GLICKO_INITIAL_VOLATILITY));
+	}
+
+	const PlayerRating& RatingEngine::getRating(size_t playerId) const
+	{
+		return _ratings[playerId];
+	}
+
+	double RatingEngine::gameScore(PlayerEnum player, PlayerEnum winner)
+	{
+		if (winner == PlayerEnum::NONE)
+			return 0.5;
+
+		return (winner == player) ? 1 : 0;
+	}
+
+	double RatingEngine::updatedElo(const PlayerRating& player, const PlayerRating& opponent, double score)
+	{
+		double expectedScore = 1 / (1 + std::pow(10, (opponent.elo - player.elo) / ELO_SCALE));
+		return player.elo + ELO_K_FACTOR * (score - expectedScore);
+	}
+
+	PlayerRating RatingEngine::updatedGlicko(const PlayerRating& player, const PlayerRating& opponent, double score)
+	{
+		const double pi = 3.14159265358979323846;
+
+		// Convert to the Glicko-2 scale
+		double mu = (player.glicko - INITIAL_RATING) / GLICKO_SCALE;
+		double phi = player.glickoDeviation / GLICKO_SCALE;
+		double sigma = player.glickoVolatility;
+		double opponentMu = (opponent.glicko - INITIAL_RATING) / GLICKO_SCALE;
+		double opponentPhi = opponent.glickoDeviation / GLICKO_SCALE;
+
+		// Expected score against the opponent, weighted down by the opponent's uncertainty
+		double g = 1 / std::sqrt(1 + 3 * opponentPhi * opponentPhi / (pi * pi));
+		double expectedScore = 1 / (1 + std::exp(-g * (mu - opponentMu)));
+
+		// Estimated variance of the rating based on the game outcome, and the estimated improvement
+		double variance = 1 / (g * g * expectedScore * (1 - expectedScore));
+		double delta = variance * g * (score - expectedScore);
+
+		// Find the new volatility (Illinois algorithm, as in Glickman's Glicko-2 paper)
+		double a = std::log(sigma * sigma);
+		double tauSquared = GLICKO_TAU * GLICKO_TAU;
+		auto f = [=](double x)
+		{
+			double ex = std::exp(x);
+			double denominator = phi * phi + variance + ex;
+			return ex * (delta * delta - phi * phi - variance - ex) / (2 * denominator * denominator) -
+				   (x - a) / tauSquared;
+		};
+
+		double lowerBound = a;
+		double upperBound;
+		if (delta * delta > phi * phi + variance)
+		{
+			upperBound = std::log(delta * delta - phi * phi - variance);
+		}
+		else
+		{
+			int k = 1;
+			while (f(a - k * GLICKO_TAU) < 0)
+				k++;
+			upperBound = a - k * GLICKO_TAU;
+		}
+
+		double fLower = f(lowerBound);
+		double fUpper = f(upperBound);
+		while (std::abs(upperBound - lowerBound) > GLICKO_EPSILON)
+		{
+			double candidate = lowerBound + (lowerBound - upperBound) * fLower / (fUpper - fLower);
+			double fCandidate = f(candidate);
+			if (fCandidate * fUpper <= 0)
+			{
+				lowerBound = upperBound;
+				fLower = fUpper;
+			}
+			else
+			{
+				fLower /= 2;
+			}
+
+			upperBound = candidate;
+			fUpper = fCandidate;
+		}
+
+		double newSigma = std::exp(lowerBound / 2);
+
+		// Update the deviation and the rating
+		double preGamePhi = std::sqrt(phi * phi + newSigma * newSigma);
+		double newPhi = 1 / std::sqrt(1 / (preGamePhi * preGamePhi) + 1 / variance);
+		double newMu = mu + newPhi * newPhi * g * (score - expectedScore);
+
+		// Convert back to the Glicko scale
+		return PlayerRating(player.elo, newMu * GLICKO_SCALE + INITIAL_RATING, newPhi * GLICKO_SCALE, newSigma);
+	}
+}
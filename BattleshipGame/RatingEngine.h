@@ -0,0 +1,89 @@
+#pragma once
+
+#include <vector>
+#include "AlgoCommon.h"
+
+using std::vector;
+
+namespace battleship
+{
+	/** Rating systems the standings can be ordered by */
+	enum class RatingSystem : int
+	{
+		WIN_PERCENTAGE = 0,	// Percentage of games won (out of the games that weren't a tie)
+		ELO = 1,			// Elo rating
+		GLICKO2 = 2			// Glicko-2 rating
+	};
+
+	/** Skill ratings of a single player at a given point in time in the competition */
+	struct PlayerRating
+	{
+		double elo;					// Elo rating
+		double glicko;				// Glicko-2 rating, on the Glicko scale (same scale as Elo)
+		double glickoDeviation;		// Glicko-2 rating deviation (RD) - the uncertainty of the Glicko-2 rating
+		double glickoVolatility;	// Glicko-2 volatility - how erratic the player's results are
+
+		PlayerRating(double aElo, double aGlicko, double aGlickoDeviation, double aGlickoVolatility);
+	};
+
+	/** Maintains the Elo and Glicko-2 ratings of the competition players, updated incrementally per game.
+	 *  Unlike win percentage, both ratings account for the strength of the opponents, so standings are meaningful
+	 *  long before every player met every other player on every board.
+	 *  Each game is rated as its own Glicko-2 rating period, so an update costs O(1) regardless of the amount of
+	 *  players and games played. The Glicko-2 deviation shrinks as a player plays more games, and tells how much
+	 *  the player's rating can be trusted.
+	 *  This class isn't thread safe.
+	 */
+	class RatingEngine
+	{
+	public:
+		RatingEngine(size_t playersCount);
+		virtual ~RatingEngine() = default;
+
+		/** Updates the ratings of both players of a game with the game's winner (PlayerEnum::NONE for a tie) */
+		void updateWithGame(size_t playerAId, size_t playerBId, PlayerEnum winner);
+
+		/** Adds a player who hasn't played yet, with the next player id */
+		void addPlayer();
+
+		/** Current ratings of the player */
+		const PlayerRating& getRating(size_t playerId) const;
+
+	private:
+		/** Rating of a player who hasn't played yet (for both Elo and Glicko-2) */
+		static constexpr double INITIAL_RATING = 1500;
+
+		/** Maximal change of an Elo rating in a single game */
+		static constexpr double ELO_K_FACTOR = 32;
+
+		/** Rating difference for which the stronger Elo player is expected to score 10 times more */
+		static constexpr double ELO_SCALE = 400;
+
+		/** Glicko-2 rating deviation of a player who hasn't played yet */
+		static constexpr double GLICKO_INITIAL_DEVIATION = 350;
+
+		/** Glicko-2 volatility of a player who hasn't played yet */
+		static constexpr double GLICKO_INITIAL_VOLATILITY = 0.06;
+
+		/** Glicko-2 system constant, constrains the change in volatility over time */
+		static constexpr double GLICKO_TAU = 0.5;
+
+		/** Conversion factor between the Glicko scale and the internal Glicko-2 scale */
+		static constexpr double GLICKO_SCALE = 173.7178;
+
+		/** Convergence tolerance of the Glicko-2 volatility iteration */
+		static constexpr double GLICKO_EPSILON = 0.000001;
+
+		/** Current ratings, indexed by player id */
+		vector<PlayerRating> _ratings;
+
+		/** Score of the player in a game with the given winner: 1 for a win, 0.5 for a tie and 0 for a loss */
+		static double gameScore(PlayerEnum player, PlayerEnum winner);
+
+		/** Returns the Elo rating of the player after a game with the given score */
+		static double updatedElo(const PlayerRating& player, const PlayerRating& opponent, double score);
+
+		/** Returns the Glicko-2 ratings of the player after a game with the given score (Elo is left unchanged) */
+		static PlayerRating updatedGlicko(const PlayerRating& player, const PlayerRating& opponent, double score);
+	};
+}
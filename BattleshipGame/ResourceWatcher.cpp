@@ -0,0 +1,192 @@
+#include "ResourceWatcher.h"
+#include "Logger.h"
+#include "IOUtil.h"
+#include <windows.h>
+#include <chrono>
+#include <algorithm>
+
+using std::to_string;
+using std::chrono::steady_clock;
+using std::chrono::milliseconds;
+using std::chrono::duration_cast;
+
+namespace battleship
+{
+	ResourceWatcher::ResourceWatcher(const string& path, shared_ptr<BattleshipGameBoardFactory> boardLoader,
+									 shared_ptr<AlgoLoader> algoLoader, EntrantsListener listener) :
+		_path(path),
+		_boardLoader(boardLoader),
+		_algoLoader(algoLoader),
+		_listener(std::move(listener)),
+		_isStopped(false)
+	{
+	}
+
+	ResourceWatcher::~ResourceWatcher()
+	{
+		stop();
+	}
+
+	void ResourceWatcher::start()
+	{
+		// Files that were listed before the competition started were already read
+		_knownFiles.clear();
+		_pendingFiles.clear();
+		_knownFiles.insert(_algoLoader->availableGameAlgos().begin(), _algoLoader->availableGameAlgos().end());
+		_knownFiles.insert(_boardLoader->availableBoardsList().begin(), _boardLoader->availableBoardsList().end());
+
+		_isStopped = false;
+		_watcherThread = thread(&ResourceWatcher::run, this);
+	}
+
+	void ResourceWatcher::stop()
+	{
+		if (!_watcherThread.joinable())
+			return;
+
+		_isStopped = true;
+		_watcherThread.join();
+	}
+
+	void ResourceWatcher::run()
+	{
+		// Files that are created, renamed into the path or written to signal a change
+		HANDLE changeHandle = FindFirstChangeNotificationA(_path.c_str(), FALSE,
+														   FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE);
+		if (changeHandle == INVALID_HANDLE_VALUE)
+		{
+			Logger::getInstance().log(Severity::ERROR_LEVEL,
+									  "Cannot watch path " + _path + " for new boards and algorithms (error " +
+									  to_string(GetLastError()) + ")");
+			return;
+		}
+
+		Logger::getInstance().log(Severity::INFO_LEVEL, "Watching path " + _path + " for new boards and algorithms..");
+
+		bool isChanged = false;
+		steady_clock::time_point lastListTime;
+
+		while (!_isStopped)
+		{
+			DWORD waitStatus = WaitForSingleObject(changeHandle, POLL_INTERVAL_MILLIS);
+
+			if (waitStatus == WAIT_OBJECT_0)
+			{
+				// Any file in the path may have changed (e.g. the competition's own log), so just list the path
+				isChanged = true;
+
+				if (!FindNextChangeNotification(changeHandle))
+				{
+					Logger::getInstance().log(Severity::ERROR_LEVEL, "Stopped watching path " + _path + " (error " +
+											  to_string(GetLastError()) + ")");
+					break;
+				}
+			}
+			else if (waitStatus != WAIT_TIMEOUT)
+			{
+				Logger::getInstance().log(Severity::ERROR_LEVEL, "Stopped watching path " + _path + " (error " +
+										  to_string(GetLastError()) + ")");
+				break;
+			}
+
+			// Pending files are listed until they settle, even if nothing signals a change
+			if ((!isChanged && _pendingFiles.empty()) ||
+				(duration_cast<milliseconds>(steady_clock::now() - lastListTime).count() < POLL_INTERVAL_MILLIS))
+				continue;
+
+			isChanged = false;
+			lastListTime = steady_clock::now();
+			updatePendingFiles();
+			loadSettledFiles();
+		}
+
+		FindCloseChangeNotification(changeHandle);
+	}
+
+	void ResourceWatcher::updatePendingFiles()
+	{
+		unordered_map<string, PendingFile> newFiles;
+		listNewFiles(AlgoLoader::DLL_EXTENSION, false, newFiles);
+		listNewFiles(BattleshipGameBoardFactory::BOARD_SUFFIX, true, newFiles);
+
+		// Files that are still being written restart their wait, and files that were removed are dropped
+		for (auto& newFile : newFiles)
+		{
+			auto pending = _pendingFiles.find(newFile.first);
+			if ((pending != _pendingFiles.end()) && (pending->second.size == newFile.second.size) &&
+				(pending->second.lastWriteTime == newFile.second.lastWriteTime))
+			{
+				newFile.second.stableSince = pending->second.stableSince;
+			}
+		}
+
+		_pendingFiles = std::move(newFiles);
+	}
+
+	void ResourceWatcher::listNewFiles(const string& extension, bool isBoard,
+									   unordered_map<string, PendingFile>& newFiles) const
+	{
+		WIN32_FIND_DATAA fileData;
+		const string targetExtension = "." + extension;
+		const steady_clock::time_point now = steady_clock::now();
+
+		HANDLE dir = FindFirstFileA((_path + "\\*" + targetExtension).c_str(), &fileData);
+		if (dir == INVALID_HANDLE_VALUE)
+			return;
+
+		do
+		{
+			// Same filtering as IOUtil::listFilesInPath, which the loaders list their files with
+			string filename = fileData.cFileName;
+			if (!IOUtil::endsWith(filename, targetExtension) || (_knownFiles.find(filename) != _knownFiles.end()))
+				continue;
+
+			PendingFile& newFile = newFiles[filename];
+			newFile.size = (static_cast<uint64_t>(fileData.nFileSizeHigh) << 32) | fileData.nFileSizeLow;
+			newFile.lastWriteTime = (static_cast<uint64_t>(fileData.ftLastWriteTime.dwHighDateTime) << 32) |
+									fileData.ftLastWriteTime.dwLowDateTime;
+			newFile.stableSince = now;
+			newFile.isBoard = isBoard;
+		} while (FindNextFileA(dir, &fileData));
+
+		FindClose(dir);
+	}
+
+	void ResourceWatcher::loadSettledFiles()
+	{
+		vector<string> settledDlls;
+		vector<string> settledBoards;
+		const steady_clock::time_point now = steady_clock::now();
+
+		for (auto it = _pendingFiles.begin(); it != _pendingFiles.end();)
+		{
+			if (duration_cast<milliseconds>(now - it->second.stableSince).count() < SETTLE_MILLIS)
+			{
+				++it;
+				continue;
+			}
+
+			(it->second.isBoard ? settledBoards : settledDlls).push_back(it->first);
+			_knownFiles.insert(it->first);
+			it = _pendingFiles.erase(it);
+		}
+
+		if (settledDlls.empty() && settledBoards.empty())
+			return;
+
+		// Same order as the loaders list their files in
+		std::sort(settledDlls.begin(), settledDlls.end());
+		std::sort(settledBoards.begin(), settledBoards.end());
+
+		vector<string> newAlgos = _algoLoader->loadNewAlgorithms(settledDlls);
+		vector<string> newBoards = _boardLoader->loadNewBattleBoards(settledBoards);
+
+		if (newAlgos.empty() && newBoards.empty())
+			return;
+
+		Logger::getInstance().log(Severity::INFO_LEVEL,
+								  "Found " + to_string(newAlgos.size()) + " new algorithms and " +
+								  to_string(newBoards.size()) + " new boards in " + _path);
+		_listener(newAlgos, newBoards);
+	}
+}
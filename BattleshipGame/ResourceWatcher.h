@@ -0,0 +1,101 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <chrono>
+#include <cstdint>
+#include "AlgoLoader.h"
+#include "BattleshipGameBoardFactory.h"
+
+using std::shared_ptr;
+using std::vector;
+using std::string;
+using std::thread;
+using std::atomic;
+using std::function;
+using std::unordered_map;
+using std::unordered_set;
+
+namespace battleship
+{
+	/** Watches the path of the boards and algorithms while a competition runs, and loads the board files and
+	 *  algorithm dlls that appear in it (see BattleshipGameBoardFactory::loadNewBattleBoards and
+	 *  AlgoLoader::loadNewAlgorithms). Each new file is read once its size and last write time didn't change for a
+	 *  while, so files that are still being copied aren't read half way.
+	 *  Only dlls and board files are tracked: other files in the path (e.g. the competition's journal, log and
+	 *  results) neither delay nor trigger loading. Changes in the path only wake the watcher up to list them.
+	 *  The entrants that were loaded are passed to the listener, on the watcher's thread.
+	 */
+	class ResourceWatcher
+	{
+	public:
+		/** Callback invoked with the names of the algorithms and boards that were loaded */
+		using EntrantsListener = function<void(const vector<string>& newAlgos, const vector<string>& newBoards)>;
+
+		/** Watches path, which the loaders load their algorithms and boards from */
+		ResourceWatcher(const string& path, shared_ptr<BattleshipGameBoardFactory> boardLoader,
+						shared_ptr<AlgoLoader> algoLoader, EntrantsListener listener);
+
+		/** Stops the watcher if it's still running */
+		virtual ~ResourceWatcher();
+
+		ResourceWatcher(ResourceWatcher const&) = delete;	// Disable copying
+		ResourceWatcher& operator=(ResourceWatcher const&) = delete;	// Disable copying (assignment)
+
+		/** Starts the watcher thread */
+		void start();
+
+		/** Stops the watcher thread. New files that didn't settle yet aren't loaded. */
+		void stop();
+
+	private:
+		/** Time to wait for a change in the path before checking whether the watcher was stopped.
+		 *  The path is listed at most once per interval.
+		 */
+		static constexpr int POLL_INTERVAL_MILLIS = 200;
+
+		/** Time a new file's size and last write time must stay the same before it's read */
+		static constexpr int SETTLE_MILLIS = 1000;
+
+		/** A new dll or board file that wasn't read yet */
+		struct PendingFile
+		{
+			uint64_t size;
+			uint64_t lastWriteTime;
+			std::chrono::steady_clock::time_point stableSince;	// When the size or last write time last changed
+			bool isBoard;
+		};
+
+		string _path;
+		shared_ptr<BattleshipGameBoardFactory> _boardLoader;
+		shared_ptr<AlgoLoader> _algoLoader;
+		EntrantsListener _listener;
+
+		thread _watcherThread;
+		atomic<bool> _isStopped;
+
+		/** Dlls and board files that were already read (whether they loaded or not), and ones that weren't yet.
+		 *  Only used by the watcher thread.
+		 */
+		unordered_set<string> _knownFiles;
+		unordered_map<string, PendingFile> _pendingFiles;
+
+		/** Logic of the watcher thread: wait for changes in the path and load new files until stopped */
+		void run();
+
+		/** Lists the dlls and board files in the path, and updates the pending files with the new ones */
+		void updatePendingFiles();
+
+		/** Adds the files in the path with the given extension that weren't read yet to newFiles */
+		void listNewFiles(const string& extension, bool isBoard, unordered_map<string, PendingFile>& newFiles) const;
+
+		/** Loads the pending files that settled, and passes the loaded algorithms and boards to the listener */
+		void loadSettledFiles();
+	};
+}
@@ -0,0 +1,228 @@
+#include "ResultsCache.h"
+#include "IOUtil.h"
+#include "Logger.h"
+#include <vector>
+
+using std::vector;
+using std::to_string;
+using std::lock_guard;
+using std::ifstream;
+
+namespace battleship
+{
+	ResultsCache::ResultsCache(const string& path, const AlgoLoader& algoLoader,
+							   const BattleshipGameBoardFactory& boardFactory,
+							   unsigned int seed, int verifyInterval, bool isReadOnly) :
+		_filename(path + "\\" + CACHE_FILE),
+		_seed(seed),
+		_verifyInterval(verifyInterval),
+		_hitsCount(0),
+		_storedCount(0),
+		_verifiedCount(0),
+		_mismatchesCount(0)
+	{
+		for (const auto& algoName : algoLoader.loadedGameAlgos())
+			_algoFingerprints[algoName] = algoLoader.fingerprint(algoName);
+		for (const auto& boardName : boardFactory.loadedBoardsList())
+			_boardFingerprints[boardName] = boardFactory.boardFingerprint(boardName);
+
+		size_t linesCount = load();
+		Logger::getInstance().log(Severity::INFO_LEVEL,
+								  "Results cache " + _filename + " holds results of " + to_string(_results.size()) +
+								  " games (" + to_string(linesCount) + " lines)");
+
+		if (!isReadOnly)
+		{
+			_fs.open(_filename, std::ofstream::out | std::ofstream::app);
+			if (!_fs.is_open())
+			{
+				Logger::getInstance().log(Severity::ERROR_LEVEL, "Failed to open results cache " + _filename +
+										  ", results of new games won't be cached");
+			}
+		}
+	}
+
+	uint64_t ResultsCache::gameKey(const string& playerAName, const string& playerBName, const string& boardName) const
+	{
+		auto playerAIt = _algoFingerprints.find(playerAName);
+		auto playerBIt = _algoFingerprints.find(playerBName);
+		auto boardIt = _boardFingerprints.find(boardName);
+
+		if ((playerAIt == _algoFingerprints.end()) || (playerBIt == _algoFingerprints.end()) ||
+			(boardIt == _boardFingerprints.end()) ||
+			(playerAIt->second == AlgoLoader::NO_FINGERPRINT) || (playerBIt->second == AlgoLoader::NO_FINGERPRINT))
+		{
+			return NO_KEY;
+		}
+
+		const uint64_t gameDesc[] = { playerAIt->second, playerBIt->second, boardIt->second, _seed };
+		uint64_t key = IOUtil::contentHash(gameDesc, sizeof(gameDesc));
+
+		// NO_KEY is reserved for games that can't be cached
+		return (key != NO_KEY) ? key : (key + 1);
+	}
+
+	ResultsCache::Lookup ResultsCache::lookup(const string& playerAName, const string& playerBName,
+											  const string& boardName, GameResults& cachedResults)
+	{
+		uint64_t key = gameKey(playerAName, playerBName, boardName);
+		if (key == NO_KEY)
+			return Lookup::MISS;
+
+		lock_guard<mutex> lock(_cacheLock);
+
+		auto resultsIt = _results.find(key);
+		if ((resultsIt == _results.end()) ||
+			(_unreliableAlgos.count(playerAName) > 0) || (_unreliableAlgos.count(playerBName) > 0))
+		{
+			return Lookup::MISS;
+		}
+
+		cachedResults = resultsIt->second;
+		_hitsCount++;
+
+		if ((_verifyInterval > 0) && ((_hitsCount % _verifyInterval) == 0))
+			return Lookup::VERIFY;
+
+		return Lookup::HIT;
+	}
+
+	void ResultsCache::store(const string& playerAName, const string& playerBName, const string& boardName,
+							 const GameResults& results)
+	{
+		uint64_t key = gameKey(playerAName, playerBName, boardName);
+		if ((key == NO_KEY) || (results.moves <= 0))
+			return;
+
+		lock_guard<mutex> lock(_cacheLock);
+
+		// Games that don't reproduce would only fill the cache with results that can't be used
+		if ((_unreliableAlgos.count(playerAName) > 0) || (_unreliableAlgos.count(playerBName) > 0))
+			return;
+
+		auto cachedIt = _results.find(key);
+		if ((cachedIt != _results.end()) && isSameResults(cachedIt->second, results))
+			return;
+
+		add(key, results);
+	}
+
+	bool ResultsCache::verify(const string& playerAName, const string& playerBName, const string& boardName,
+							  const GameResults& cachedResults, const GameResults& results)
+	{
+		bool isReproduced = isSameResults(cachedResults, results);
+
+		lock_guard<mutex> lock(_cacheLock);
+		_verifiedCount++;
+
+		if (!isReproduced)
+		{
+			_mismatchesCount++;
+			_unreliableAlgos.insert(playerAName);
+			_unreliableAlgos.insert(playerBName);
+			add(gameKey(playerAName, playerBName, boardName), results);
+
+			Logger::getInstance().log(Severity::WARNING_LEVEL,
+									  "Cached results of the game between Player A: " + playerAName +
+									  " and Player B: " + playerBName + " on board: " + boardName +
+									  " didn't reproduce, games of these players won't be served from the results cache");
+		}
+
+		return isReproduced;
+	}
+
+	void ResultsCache::logStats() const
+	{
+		lock_guard<mutex> lock(_cacheLock);
+
+		Logger::getInstance().log(Severity::INFO_LEVEL,
+								  "Results cache: " + to_string(_hitsCount - _verifiedCount) + " games served from cache, " +
+								  to_string(_storedCount) + " games added, " + to_string(_verifiedCount) +
+								  " games verified (" + to_string(_mismatchesCount) + " didn't reproduce)");
+	}
+
+	size_t ResultsCache::load()
+	{
+		// A missing file simply means no games were cached yet
+		if (!ifstream(_filename).good())
+			return 0;
+
+		size_t linesCount = 0;
+		int malformedLines = 0;
+		auto lineParser = [this, &linesCount, &malformedLines](string& nextLine)
+		{
+			if (nextLine.empty())
+				return;
+
+			vector<string> fields;
+			size_t fieldStart = 0;
+			size_t separatorPos;
+
+			while ((separatorPos = nextLine.find(FIELD_SEPARATOR, fieldStart)) != string::npos)
+			{
+				fields.push_back(nextLine.substr(fieldStart, separatorPos - fieldStart));
+				fieldStart = separatorPos + 1;
+			}
+			fields.push_back(nextLine.substr(fieldStart));
+
+			bool isWellFormed = (fields.size() == FIELDS_COUNT);
+			for (size_t field = 0; isWellFormed && (field < fields.size()); field++)
+				isWellFormed = IOUtil::isInteger(fields[field]);
+
+			int winner = isWellFormed ? std::stoi(fields[1]) : -1;
+			if ((winner < static_cast<int>(PlayerEnum::A)) || (winner > static_cast<int>(PlayerEnum::NONE)))
+			{	// E.g. a line cut by a crash
+				malformedLines++;
+				return;
+			}
+
+			GameResults results{ static_cast<PlayerEnum>(winner), std::stoi(fields[2]), std::stoi(fields[3]),
+								 std::stoi(fields[4]), 0, 0, 0 };
+			_results[std::stoull(fields[0])] = results;	// Later lines override earlier ones
+			linesCount++;
+		};
+
+		IOUtil::parseFile(_filename, lineParser);
+
+		if (malformedLines > 0)
+		{
+			Logger::getInstance().log(Severity::WARNING_LEVEL,
+									  "Skipped " + to_string(malformedLines) + " malformed lines in " + _filename);
+		}
+
+		return linesCount;
+	}
+
+	void ResultsCache::add(uint64_t key, const GameResults& results)
+	{
+		GameResults& cachedResults = _results[key];
+		cachedResults = results;
+		cachedResults.durationMicros = 0;
+		cachedResults.algoMicros = 0;
+		cachedResults.playerAAlgoMicros = 0;
+		_storedCount++;
+
+		if (!_fs.is_open())
+			return;
+
+		// Flush every line, so a crash loses at most the game that was being written
+		_fs << to_string(key) << FIELD_SEPARATOR <<
+			   to_string(static_cast<int>(results.winner)) << FIELD_SEPARATOR <<
+			   to_string(results.playerAPoints) << FIELD_SEPARATOR <<
+			   to_string(results.playerBPoints) << FIELD_SEPARATOR <<
+			   to_string(results.moves) << std::endl;
+
+		if (!_fs)
+		{
+			Logger::getInstance().log(Severity::ERROR_LEVEL, "IO error when writing to results cache " + _filename);
+		}
+	}
+
+	bool ResultsCache::isSameResults(const GameResults& results1, const GameResults& results2)
+	{
+		return (results1.winner == results2.winner) &&
+			   (results1.playerAPoints == results2.playerAPoints) &&
+			   (results1.playerBPoints == results2.playerBPoints) &&
+			   (results1.moves == results2.moves);
+	}
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdint>
+#include "GameManager.h"
+#include "AlgoLoader.h"
+#include "BattleshipGameBoardFactory.h"
+
+using std::string;
+using std::ofstream;
+using std::mutex;
+using std::unordered_map;
+using std::unordered_set;
+
+namespace battleship
+{
+	/** Results of games played by earlier competitions, persisted on disk so deterministic games aren't played again.
+	 *  A game is identified by what decides its outcome rather than by names: the fingerprints of both players'
+	 *  binaries (see AlgoLoader::fingerprint) in their order, the fingerprint of the board
+	 *  (see BattleshipGameBoardFactory::boardFingerprint) and the competition's seed. Rebuilding an algorithm
+	 *  therefore invalidates exactly the games it played, while renaming a dll or a board file invalidates nothing.
+	 *  Algorithms that aren't deterministic would be served results that don't reproduce, so one of every
+	 *  verifyInterval games found in the cache is played anyway and compared with its cached results. Once a game
+	 *  doesn't reproduce, the games of both of its algorithms aren't served from the cache for the rest of the
+	 *  competition, and the cached results of the game are replaced.
+	 *  The cache file is append-only: a line per game, flushed when written, and a later line of a game overrides
+	 *  earlier ones. This class is thread safe.
+	 */
+	class ResultsCache
+	{
+	public:
+		/** Opens the cache file in path and loads the results it holds.
+		 *  The algorithms and boards loaded by the loaders are fingerprinted right away, games of algorithms or
+		 *  boards loaded later aren't cached.
+		 *  A read only cache serves the results it loaded, but doesn't add games to the file (e.g. for shard
+		 *  processes, which would otherwise write to the same file at the same time).
+		 */
+		ResultsCache(const string& path, const AlgoLoader& algoLoader, const BattleshipGameBoardFactory& boardFactory,
+					 unsigned int seed, int verifyInterval, bool isReadOnly = false);
+		virtual ~ResultsCache() = default;
+
+		ResultsCache(ResultsCache const&) = delete;	// Disable copying
+		ResultsCache& operator=(ResultsCache const&) = delete;	// Disable copying (assignment)
+
+		/** Outcome of looking up a game in the cache */
+		enum class Lookup
+		{
+			MISS,	// The game should be played, and its results passed to store()
+			HIT,	// The game's cached results can be used as is
+			VERIFY	// The game should be played, and its results passed to verify() with the cached results
+		};
+
+		/** Looks up the results of the game between the given players on the given board.
+		 *  On a HIT or VERIFY cachedResults is set to the cached results (with no duration or algorithm time).
+		 */
+		Lookup lookup(const string& playerAName, const string& playerBName, const string& boardName,
+					  GameResults& cachedResults);
+
+		/** Adds the results of a game that was played because it missed the cache, or that was played elsewhere
+		 *  (e.g. by a shard process). Games that faulted (no moves were made) aren't cached: their tie doesn't
+		 *  depend on the players' moves, and the game might not fault again. Results that are already cached
+		 *  aren't written again.
+		 */
+		void store(const string& playerAName, const string& playerBName, const string& boardName,
+				   const GameResults& results);
+
+		/** Compares the results of a game that was played to verify the cache with its cached results.
+		 *  Returns false (and stops serving the games of both players from the cache) if they differ.
+		 */
+		bool verify(const string& playerAName, const string& playerBName, const string& boardName,
+					const GameResults& cachedResults, const GameResults& results);
+
+		/** Logs how many games were served from the cache, added to it and verified */
+		void logStats() const;
+
+	private:
+		/** Cache file name */
+		static constexpr auto CACHE_FILE = "results.cache";
+
+		/** Separates the fields of a cache line: key, winner, player A points, player B points, moves */
+		static constexpr char FIELD_SEPARATOR = '\t';
+
+		/** Number of fields in a cache line */
+		static constexpr int FIELDS_COUNT = 5;
+
+		/** Key of games that can't be cached, since the binary of one of their algorithms is unknown */
+		static constexpr uint64_t NO_KEY = 0;
+
+		string _filename;
+
+		/** Fingerprints of the loaded algorithms and boards, by name */
+		unordered_map<string, uint64_t> _algoFingerprints;
+		unordered_map<string, uint64_t> _boardFingerprints;
+
+		unsigned int _seed;
+
+		/** One of every _verifyInterval cache hits is verified (0 never verifies) */
+		int _verifyInterval;
+
+		/** Cached results by game key */
+		unordered_map<uint64_t, GameResults> _results;
+
+		/** Algorithms whose games didn't reproduce in this competition */
+		unordered_set<string> _unreliableAlgos;
+
+		/** Appends new results to the cache file (not open for a read only cache) */
+		ofstream _fs;
+
+		/** Locks all of the above */
+		mutable mutex _cacheLock;
+
+		/** Counters for logStats */
+		size_t _hitsCount;
+		size_t _storedCount;
+		size_t _verifiedCount;
+		size_t _mismatchesCount;
+
+		/** Returns the key of the game, or NO_KEY if it can't be cached */
+		uint64_t gameKey(const string& playerAName, const string& playerBName, const string& boardName) const;
+
+		/** Reads all well-formed lines of the cache file into _results. Returns the number of lines read. */
+		size_t load();
+
+		/** Sets the cached results of the game, and appends them to the cache file.
+		 *  Expected to be called while holding _cacheLock.
+		 */
+		void add(uint64_t key, const GameResults& results);
+
+		/** Returns true if the results are the same, ignoring the time they took */
+		static bool isSameResults(const GameResults& results1, const GameResults& results2);
+	};
+}
@@ -0,0 +1,339 @@
+#include "ResultsExporter.h"
+#include "Scoreboard.h"
+#include "IOUtil.h"
+#include "Logger.h"
+#include <chrono>
+
+using std::lock_guard;
+using std::unique_lock;
+using std::endl;
+using std::to_string;
+
+namespace battleship
+{
+	string ResultsExporter::csvField(const string& value)
+	{
+		string field = "\"";
+		for (char c : value)
+		{
+			if (c == '"')
+				field += '"';
+			field += c;
+		}
+		return field + "\"";
+	}
+
+	const char* ResultsExporter::winnerName(int winner)
+	{
+		switch (static_cast<PlayerEnum>(winner))
+		{
+		case PlayerEnum::A:	return "A";
+		case PlayerEnum::B:	return "B";
+		default:			return "TIE";
+		}
+	}
+
+	ResultsExporter::ResultsExporter(const string& gamesFilename, const string& standingsFilename,
+									 ResultsFormat format) :
+		_format(format),
+		_isClosed(false)
+	{
+		auto openMode = std::ofstream::out | std::ofstream::trunc;
+		if (format == ResultsFormat::BINARY)
+			openMode |= std::ofstream::binary;
+
+		_gamesFile.open(gamesFilename, openMode);
+		_standingsFile.open(standingsFilename, openMode);
+
+		if (!_gamesFile.is_open() || !_standingsFile.is_open())
+		{
+			Logger::getInstance().log(Severity::ERROR_LEVEL,
+									  "Failed to open results export files " + gamesFilename + ", " + standingsFilename);
+		}
+
+		writeHeaders();
+		_writerThread = thread(&ResultsExporter::run, this);
+	}
+
+	ResultsExporter::~ResultsExporter()
+	{
+		close();
+	}
+
+	string ResultsExporter::fileExtension(ResultsFormat format)
+	{
+		switch (format)
+		{
+		case ResultsFormat::CSV:	return "csv";
+		case ResultsFormat::NDJSON:	return "ndjson";
+		case ResultsFormat::BINARY:	return "bin";
+		default:					return "txt";
+		}
+	}
+
+	void ResultsExporter::attach(Scoreboard& scoreboard)
+	{
+		scoreboard.addGameResultsListener([this](const GameResults& results,
+												 const string& playerAName, const string& playerBName,
+												 const string& boardName)
+		{
+			queueGame(GameRow{ playerAName, playerBName, boardName, static_cast<int>(results.winner),
+							   results.playerAPoints, results.playerBPoints, results.moves, results.durationMicros });
+		});
+
+		scoreboard.addRoundResultsListener([this, &scoreboard](shared_ptr<const RoundResults> roundResults)
+		{
+			vector<StandingRow> rows;
+			int place = 1;
+
+			// Standings are already sorted by player's rating
+			for (const auto& playerStats : roundResults->standings)
+			{
+				rows.push_back(StandingRow{ roundResults->roundNum, place++,
+											scoreboard.getPlayerName(playerStats.playerId),
+											playerStats.wins, playerStats.loses, playerStats.ties, playerStats.rating,
+											playerStats.pointsFor, playerStats.pointsAgainst,
+											playerStats.elo, playerStats.glicko, playerStats.glickoDeviation });
+			}
+
+			queueStandings(std::move(rows));
+		});
+	}
+
+	void ResultsExporter::queueGame(GameRow row)
+	{
+		lock_guard<mutex> lock(_queueLock);
+		if (_isClosed)
+			return;
+
+		_queuedGames.push_back(std::move(row));
+		if (_queuedGames.size() >= WRITE_BATCH_SIZE)
+			_queueCV.notify_one();
+	}
+
+	void ResultsExporter::queueStandings(vector<StandingRow> rows)
+	{
+		lock_guard<mutex> lock(_queueLock);
+		if (_isClosed)
+			return;
+
+		for (auto& row : rows)
+			_queuedStandings.push_back(std::move(row));
+	}
+
+	void ResultsExporter::close()
+	{
+		if (!_writerThread.joinable())
+			return;
+
+		{
+			lock_guard<mutex> lock(_queueLock);
+			_isClosed = true;
+		}
+		_queueCV.notify_one();
+		_writerThread.join();
+
+		_gamesFile.close();
+		_standingsFile.close();
+	}
+
+	void ResultsExporter::run()
+	{
+		vector<GameRow> games;
+		vector<StandingRow> standings;
+		bool isClosed = false;
+		const std::chrono::milliseconds writeInterval(static_cast<int>(WRITE_INTERVAL_MILLIS));
+
+		while (!isClosed)
+		{
+			{	// Take the queued rows, so the worker threads can keep queueing while we write
+				unique_lock<mutex> lock(_queueLock);
+				_queueCV.wait_for(lock, writeInterval,
+								  [this] { return _isClosed || (_queuedGames.size() >= WRITE_BATCH_SIZE); });
+				games.swap(_queuedGames);
+				standings.swap(_queuedStandings);
+				isClosed = _isClosed;
+			}
+
+			if (!games.empty())
+			{
+				writeGames(games);
+				_gamesFile.flush();
+				games.clear();
+			}
+
+			if (!standings.empty())
+			{
+				writeStandings(standings);
+				_standingsFile.flush();
+				standings.clear();
+			}
+		}
+
+		if (!_gamesFile || !_standingsFile)
+		{
+			Logger::getInstance().log(Severity::ERROR_LEVEL, "IO error when exporting competition results");
+		}
+	}
+
+	void ResultsExporter::writeHeaders()
+	{
+		switch (_format)
+		{
+		case ResultsFormat::CSV:
+			_gamesFile << "player_a,player_b,board,winner,player_a_points,player_b_points,moves,duration_us" << endl;
+			_standingsFile << "round,place,player,wins,losses,ties,rating,points_for,points_against,elo,glicko,glicko_rd" << endl;
+			break;
+		case ResultsFormat::BINARY:
+			_gamesFile.write("BSGM", 4);
+			writeBinary(_gamesFile, BINARY_FORMAT_VERSION);
+			_standingsFile.write("BSRD", 4);
+			writeBinary(_standingsFile, BINARY_FORMAT_VERSION);
+			break;
+		default:	// NDJSON rows are self describing
+			break;
+		}
+	}
+
+	void ResultsExporter::writeGames(const vector<GameRow>& rows)
+	{
+		if (_format == ResultsFormat::CSV)
+		{
+			for (const auto& row : rows)
+			{
+				_gamesFile << csvField(row.playerAName) << "," << csvField(row.playerBName) << ","
+						   << csvField(row.boardName) << "," << winnerName(row.winner) << ","
+						   << row.playerAPoints << "," << row.playerBPoints << ","
+						   << row.moves << "," << row.durationMicros << "\n";
+			}
+		}
+		else if (_format == ResultsFormat::NDJSON)
+		{
+			for (const auto& row : rows)
+			{
+				_gamesFile << "{\"player_a\":\"" << IOUtil::escapeJson(row.playerAName)
+						   << "\",\"player_b\":\"" << IOUtil::escapeJson(row.playerBName)
+						   << "\",\"board\":\"" << IOUtil::escapeJson(row.boardName)
+						   << "\",\"winner\":\"" << winnerName(row.winner)
+						   << "\",\"player_a_points\":" << row.playerAPoints
+						   << ",\"player_b_points\":" << row.playerBPoints
+						   << ",\"moves\":" << row.moves
+						   << ",\"duration_us\":" << row.durationMicros << "}\n";
+			}
+		}
+		else if (_format == ResultsFormat::BINARY)
+		{
+			// Names must be in the dictionary before the block that refers to them
+			vector<unsigned int> nameIds;
+			nameIds.reserve(rows.size() * 3);
+			for (const auto& row : rows)
+			{
+				nameIds.push_back(dictionaryId(_gamesFile, _gamesDictionary, row.playerAName));
+				nameIds.push_back(dictionaryId(_gamesFile, _gamesDictionary, row.playerBName));
+				nameIds.push_back(dictionaryId(_gamesFile, _gamesDictionary, row.boardName));
+			}
+
+			_gamesFile.put('G');
+			writeBinary(_gamesFile, static_cast<unsigned int>(rows.size()));
+			for (size_t column = 0; column < 3; column++)
+			{
+				for (size_t i = 0; i < rows.size(); i++)
+					writeBinary(_gamesFile, nameIds[i * 3 + column]);
+			}
+			for (const auto& row : rows)
+				writeBinary(_gamesFile, static_cast<signed char>(row.winner));
+			for (const auto& row : rows)
+				writeBinary(_gamesFile, static_cast<int>(row.playerAPoints));
+			for (const auto& row : rows)
+				writeBinary(_gamesFile, static_cast<int>(row.playerBPoints));
+			for (const auto& row : rows)
+				writeBinary(_gamesFile, static_cast<int>(row.moves));
+			for (const auto& row : rows)
+				writeBinary(_gamesFile, static_cast<long long>(row.durationMicros));
+		}
+	}
+
+	void ResultsExporter::writeStandings(const vector<StandingRow>& rows)
+	{
+		if (_format == ResultsFormat::CSV)
+		{
+			for (const auto& row : rows)
+			{
+				_standingsFile << row.round << "," << row.place << "," << csvField(row.playerName) << ","
+							   << row.wins << "," << row.losses << "," << row.ties << "," << row.rating << ","
+							   << row.pointsFor << "," << row.pointsAgainst << ","
+							   << row.elo << "," << row.glicko << "," << row.glickoDeviation << "\n";
+			}
+		}
+		else if (_format == ResultsFormat::NDJSON)
+		{
+			for (const auto& row : rows)
+			{
+				_standingsFile << "{\"round\":" << row.round
+							   << ",\"place\":" << row.place
+							   << ",\"player\":\"" << IOUtil::escapeJson(row.playerName)
+							   << "\",\"wins\":" << row.wins
+							   << ",\"losses\":" << row.losses
+							   << ",\"ties\":" << row.ties
+							   << ",\"rating\":" << row.rating
+							   << ",\"points_for\":" << row.pointsFor
+							   << ",\"points_against\":" << row.pointsAgainst
+							   << ",\"elo\":" << row.elo
+							   << ",\"glicko\":" << row.glicko
+							   << ",\"glicko_rd\":" << row.glickoDeviation << "}\n";
+			}
+		}
+		else if (_format == ResultsFormat::BINARY)
+		{
+			vector<unsigned int> playerIds;
+			playerIds.reserve(rows.size());
+			for (const auto& row : rows)
+				playerIds.push_back(dictionaryId(_standingsFile, _standingsDictionary, row.playerName));
+
+			_standingsFile.put('R');
+			writeBinary(_standingsFile, static_cast<unsigned int>(rows.size()));
+			for (const auto& row : rows)
+				writeBinary(_standingsFile, static_cast<int>(row.round));
+			for (const auto& row : rows)
+				writeBinary(_standingsFile, static_cast<int>(row.place));
+			for (unsigned int playerId : playerIds)
+				writeBinary(_standingsFile, playerId);
+			for (const auto& row : rows)
+				writeBinary(_standingsFile, static_cast<int>(row.wins));
+			for (const auto& row : rows)
+				writeBinary(_standingsFile, static_cast<int>(row.losses));
+			for (const auto& row : rows)
+				writeBinary(_standingsFile, static_cast<int>(row.ties));
+			for (const auto& row : rows)
+				writeBinary(_standingsFile, static_cast<float>(row.rating));
+			for (const auto& row : rows)
+				writeBinary(_standingsFile, static_cast<int>(row.pointsFor));
+			for (const auto& row : rows)
+				writeBinary(_standingsFile, static_cast<int>(row.pointsAgainst));
+			for (const auto& row : rows)
+				writeBinary(_standingsFile, static_cast<float>(row.elo));
+			for (const auto& row : rows)
+				writeBinary(_standingsFile, static_cast<float>(row.glicko));
+			for (const auto& row : rows)
+				writeBinary(_standingsFile, static_cast<float>(row.glickoDeviation));
+		}
+	}
+
+	unsigned int ResultsExporter::dictionaryId(ofstream& file, unordered_map<string, unsigned int>& dictionary,
+											   const string& str)
+	{
+		auto entryIt = dictionary.find(str);
+		if (entryIt != dictionary.end())
+			return entryIt->second;
+
+		unsigned int id = static_cast<unsigned int>(dictionary.size());
+		dictionary.emplace(str, id);
+
+		file.put('S');
+		writeBinary(file, id);
+		writeBinary(file, static_cast<unsigned int>(str.length()));
+		file.write(str.data(), str.length());
+
+		return id;
+	}
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+using std::string;
+using std::vector;
+using std::unordered_map;
+using std::ofstream;
+using std::thread;
+using std::mutex;
+using std::condition_variable;
+
+namespace battleship
+{
+	class Scoreboard;
+
+	/** File formats of exported competition results */
+	enum class ResultsFormat : int
+	{
+		NONE = 0,	// Results aren't exported
+		CSV = 1,	// Comma separated values with a header line
+		NDJSON = 2,	// A JSON object per line
+		BINARY = 3	// Compact columnar blocks (see ResultsExporter)
+	};
+
+	/** Streams the results of a competition into two files: a row for every game played, and a row for every
+	 *  player in the standings of every finished round.
+	 *  Rows are queued by the worker threads (through the Scoreboard listeners) and written in batches by a
+	 *  background writer thread, so exporting doesn't slow the games down.
+	 *
+	 *  The binary format is made of tagged blocks, each file starts with a 4 bytes magic ("BSGM" for games,
+	 *  "BSRD" for standings) and a uint32 version. All values are little endian:
+	 *  - 'S' block: string dictionary entry - uint32 id, uint32 length, characters. Written before the first
+	 *    row that refers to the string.
+	 *  - 'G' block: games - uint32 rows count, then the columns one after the other: playerA id (uint32),
+	 *    playerB id (uint32), board id (uint32), winner (int8: 0 - A, 1 - B, 2 - tie), playerA points (int32),
+	 *    playerB points (int32), moves (int32), duration in microseconds (int64).
+	 *  - 'R' block: standings - uint32 rows count, then the columns: round (int32), place (int32),
+	 *    player id (uint32), wins (int32), losses (int32), ties (int32), rating (float32), points for (int32),
+	 *    points against (int32), Elo (float32), Glicko-2 rating (float32), Glicko-2 rating deviation (float32).
+	 */
+	class ResultsExporter
+	{
+	public:
+		/** Opens the games and standings files for writing (truncating them), and starts the writer thread */
+		ResultsExporter(const string& gamesFilename, const string& standingsFilename, ResultsFormat format);
+
+		/** Writes all queued rows and closes the files */
+		virtual ~ResultsExporter();
+
+		ResultsExporter(ResultsExporter const&) = delete;	// Disable copying
+		ResultsExporter& operator=(ResultsExporter const&) = delete;	// Disable copying (assignment)
+
+		/** Registers the exporter as a listener of the scoreboard's game and round results.
+		 *  The exporter must outlive the games played by the scoreboard.
+		 */
+		void attach(Scoreboard& scoreboard);
+
+		/** Writes all queued rows, closes the files and stops the writer thread. Rows queued later are ignored. */
+		void close();
+
+		/** File extension of the given format (without a dot) */
+		static string fileExtension(ResultsFormat format);
+
+	private:
+		/** Number of queued rows that wakes the writer thread before its interval is over */
+		static constexpr size_t WRITE_BATCH_SIZE = 1024;
+
+		/** Maximal time rows wait in the queue before they are written */
+		static constexpr int WRITE_INTERVAL_MILLIS = 500;
+
+		/** Version of the binary format */
+		static constexpr unsigned int BINARY_FORMAT_VERSION = 2;
+
+		/** A single game row */
+		struct GameRow
+		{
+			string playerAName;
+			string playerBName;
+			string boardName;
+			int winner;	// PlayerEnum value
+			int playerAPoints;
+			int playerBPoints;
+			int moves;
+			long long durationMicros;
+		};
+
+		/** A single player's row in a round's standings */
+		struct StandingRow
+		{
+			int round;
+			int place;
+			string playerName;
+			int wins;
+			int losses;
+			int ties;
+			float rating;
+			int pointsFor;
+			int pointsAgainst;
+			float elo;
+			float glicko;
+			float glickoDeviation;
+		};
+
+		ResultsFormat _format;
+		ofstream _gamesFile;
+		ofstream _standingsFile;
+
+		/** Ids of the strings written to the dictionary of each binary file */
+		unordered_map<string, unsigned int> _gamesDictionary;
+		unordered_map<string, unsigned int> _standingsDictionary;
+
+		/** Rows waiting for the writer thread, protected by _queueLock */
+		vector<GameRow> _queuedGames;
+		vector<StandingRow> _queuedStandings;
+		mutex _queueLock;
+		condition_variable _queueCV;
+		bool _isClosed;
+
+		thread _writerThread;
+
+		/** Logic of the writer thread: write the queued rows in batches until closed */
+		void run();
+
+		void queueGame(GameRow row);
+		void queueStandings(vector<StandingRow> rows);
+
+		/** Writes the file headers of the format */
+		void writeHeaders();
+
+		void writeGames(const vector<GameRow>& rows);
+		void writeStandings(const vector<StandingRow>& rows);
+
+		/** A string value as a CSV field: always quoted, with inner quotes doubled */
+		static string csvField(const string& value);
+
+		/** Textual representation of the game winner */
+		static const char* winnerName(int winner);
+
+		/** Writes the raw bytes of a value (little endian on the platforms we run on) */
+		template <typename T>
+		static void writeBinary(ofstream& file, T value)
+		{
+			file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+
+		/** Returns the id of the string in the binary file's dictionary, writing a dictionary entry if it's new */
+		unsigned int dictionaryId(ofstream& file, unordered_map<string, unsigned int>& dictionary, const string& str);
+	};
+}
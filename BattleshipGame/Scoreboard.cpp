@@ -22,22 +22,57 @@ using std::left;
 
 namespace battleship
 {
+	RoundStanding::RoundStanding(size_t aPlayerId, const PlayerStatistics& statistics,
+								 const PlayerRating& playerRating) :
+		playerId(aPlayerId),
+		pointsFor(statistics.pointsFor),
+		pointsAgainst(statistics.pointsAgainst),
+		wins(statistics.wins),
+		loses(statistics.loses),
+		ties(statistics.ties),
+		rating(statistics.rating),
+		elo(static_cast<float>(playerRating.elo)),
+		glicko(static_cast<float>(playerRating.glicko)),
+		glickoDeviation(static_cast<float>(playerRating.glickoDeviation))
+	{
+	}
+
+	float RoundStanding::getRating(RatingSystem ratingSystem) const
+	{
+		switch (ratingSystem)
+		{
+		case RatingSystem::ELO:		return elo;
+		case RatingSystem::GLICKO2:	return glicko;
+		default:					return rating;
+		}
+	}
+
 	RoundResults::RoundResults(int aRoundNum) : roundNum(aRoundNum)
 	{
 	}
 
-	Scoreboard::Scoreboard(vector<string> players, size_t totalRounds) :
+	Scoreboard::Scoreboard(vector<string> players, size_t totalRounds, bool isRoundPerGame) :
 		_totalRounds(totalRounds),
 		_playersPerRound(players.size()),
+		_isRoundPerGame(isRoundPerGame),
+		_finishedRoundsCount(0),
+		_ratingEngine(players.size()),
+		_ratingSystem(RatingSystem::WIN_PERCENTAGE),
+		_isConsoleOutput(true),
 		_resultsCursorPosition(std::make_pair(0, 0))
 	{
 		// Save max player name for score results table formatting
 		_maxPlayerNameLength = MIN_PLAYER_NAME_SIZE;
 
+		// Player ids follow the names order, so ties in the standings are broken the same way in every run
+		std::sort(players.begin(), players.end());
+		_score.reserve(players.size());
+
 		for (const string& player : players)
 		{
 			// Store initialized player score information
-			_score.emplace(std::make_pair(player, PlayerStatistics(player)));
+			_playerIds.emplace(player, _score.size());
+			_score.push_back(PlayerStatistics(player));
 
 			// Query for the longest name
 			if (_maxPlayerNameLength < player.length())
@@ -47,10 +82,10 @@ namespace battleship
 		_maxPlayerNameLength += 2; // Apply some spacing between tabs in printed scoreboard
 	}
 
-	int Scoreboard::getPlayerCurrentRound(const string& player) const
+	int Scoreboard::getPlayerCurrentRound(size_t playerId) const
 	{
 		// Fetch current score for player
-		const PlayerStatistics& playerStatistics = _score.at(player);
+		const PlayerStatistics& playerStatistics = _score[playerId];
 
 		// Calculate round number for this player, start from round #1
 		int playerRound = playerStatistics.getRoundsPlayed() + 1;
@@ -58,11 +93,28 @@ namespace battleship
 		return playerRound;
 	}
 
-	void Scoreboard::updatePlayerGameResults(PlayerEnum player, const string& playerName,
-											 const GameResults& results)
+	void Scoreboard::updatePlayerGameResults(PlayerEnum player, size_t playerId, const GameResults& results)
 	{
 		// Calculate round number for this player, start from round #1
-		int playerRound = getPlayerCurrentRound(playerName);
+		int playerRound = getPlayerCurrentRound(playerId);
+
+		// Fetch current score for player
+		PlayerStatistics& playerStatistics = _score[playerId];
+
+		// Update player score with the newest record
+		int pointsTo = (player == PlayerEnum::A) ? results.playerAPoints : results.playerBPoints;
+		int pointsAgainst = (player == PlayerEnum::A) ? results.playerBPoints : results.playerAPoints;
+		bool isWinner = (results.winner == player);
+		bool isLoser = (results.winner != player) && (results.winner != PlayerEnum::NONE);
+		playerStatistics = playerStatistics.updateStatistics(pointsTo, pointsAgainst, isWinner, isLoser);
+
+		// Rounds are finished by finishRound
+		if (!_isRoundPerGame)
+			return;
+
+		// Players that joined a running competition skip the rounds that were finished before they joined
+		if (playerRound <= _finishedRoundsCount)
+			return;
 
 		// Find RoundResults object for this round number
 		auto roundEntry = _trackedMatches.find(playerRound);
@@ -72,6 +124,7 @@ namespace battleship
 		if (roundEntry == _trackedMatches.end())
 		{
 			roundResults = std::make_shared<RoundResults>(playerRound);
+			roundResults->standings.reserve(_playersPerRound);
 			_trackedMatches.emplace(std::make_pair(playerRound, roundResults));
 			Logger::getInstance().log(Severity::DEBUG_LEVEL, "Round " + to_string(playerRound) + " started (1 game done).");
 		}
@@ -80,37 +133,88 @@ namespace battleship
 			roundResults = roundEntry->second;
 		}
 
-		// Fetch current score for player
-		PlayerStatistics& playerStatistics = _score.at(playerName);
-
-		// Update RoundResults with the new player's statistics
-		int pointsTo = (player == PlayerEnum::A) ? results.playerAPoints : results.playerBPoints;
-		int pointsAgainst = (player == PlayerEnum::A) ? results.playerBPoints : results.playerAPoints;
-		bool isWinner = (results.winner == player);
-		bool isLoser = (results.winner != player) && (results.winner != PlayerEnum::NONE);
-		auto newRoundStatistics = playerStatistics.updateStatistics(pointsTo, pointsAgainst, isWinner, isLoser);
-		roundResults->playerStatistics.emplace(PlayerStatistics(newRoundStatistics)); // Save a copy in round results
+		// Save a compact copy of the player's statistics in round results
+		roundResults->standings.emplace_back(playerId, playerStatistics, _ratingEngine.getRating(playerId));
 
-		// Update player score with the newest record
-		auto scoreIt = _score.find(playerName);
-		if (scoreIt != _score.end())
+		// If this is the last update for this round, push the RoundResults to the approporiate
+		// queue so the reporter thread can wake up and print it.
+		// The round is no longer tracked, it's released as soon as it's printed.
+		if (roundResults->standings.size() == _playersPerRound)
 		{
-			scoreIt->second = std::move(newRoundStatistics);
+			_trackedMatches.erase(playerRound);
+			_finishedRoundsCount = playerRound;
+			publishRoundResults(std::move(roundResults));
 		}
-		else
+	}
+
+	void Scoreboard::publishRoundResults(shared_ptr<RoundResults> roundResults)
+	{
+		std::sort(roundResults->standings.begin(), roundResults->standings.end(), RoundStandingRatingSort(_ratingSystem));
+
+		for (const auto& listener : _roundResultsListeners)
 		{
-			Logger::getInstance().log(Severity::ERROR_LEVEL, "Illegal state in scoretable - player data is missing.");
+			listener(roundResults);
 		}
 
-		// If this is the last update for this round, push the RoundResults to the approporiate
-		// list so the reporter thread can wake up and print it
-		if (roundResults->playerStatistics.size() == _playersPerRound)
+		unique_lock<mutex> lock(_roundResultsLock);
+		Logger::getInstance().log(Severity::INFO_LEVEL, "Round " + to_string(roundResults->roundNum) + " finished.");
+		_roundsResults.push(std::move(roundResults)); // Guaranteed to happen before lock is released
+		_roundResultsCV.notify_one();
+	}
+
+	vector<RoundStanding> Scoreboard::currentStandings() const
+	{
+		vector<RoundStanding> standings;
+		standings.reserve(_score.size());
+		for (size_t playerId = 0; playerId < _score.size(); playerId++)
+			standings.emplace_back(playerId, _score[playerId], _ratingEngine.getRating(playerId));
+
+		std::sort(standings.begin(), standings.end(), RoundStandingRatingSort(_ratingSystem));
+		return standings;
+	}
+
+	void Scoreboard::finishRound()
+	{
+		lock_guard<mutex> lock(_scoreLock);
+
+		auto roundResults = std::make_shared<RoundResults>(++_finishedRoundsCount);
+		roundResults->standings = currentStandings();
+		publishRoundResults(std::move(roundResults));
+	}
+
+	void Scoreboard::addPlayers(const vector<string>& players, size_t totalRounds)
+	{
+		lock_guard<mutex> lock(_scoreLock);
+
+		// Finished rounds are printed under the results lock, and the print reads the players' names
+		lock_guard<mutex> resultsLock(_roundResultsLock);
+
+		for (const string& player : players)
 		{
-			unique_lock<mutex> lock(_roundResultsLock);
-			Logger::getInstance().log(Severity::INFO_LEVEL, "Round " + to_string(playerRound) + " finished.");
-			_roundsResults.push_back(roundResults); // Guaranteed to happen before lock is released
-			_roundResultsCV.notify_one();
+			if (_playerIds.count(player) > 0)
+				continue;
+
+			_playerIds.emplace(player, _score.size());
+			_score.push_back(PlayerStatistics(player));
+			_ratingEngine.addPlayer();
+			_maxPlayerNameLength = std::max(_maxPlayerNameLength, player.length() + 2);
 		}
+
+		// Rounds in progress are now finished once the new players finished them as well
+		_playersPerRound = _score.size();
+		_totalRounds = totalRounds;
+	}
+
+	vector<string> Scoreboard::getRankedPlayers()
+	{
+		lock_guard<mutex> lock(_scoreLock);
+
+		vector<string> rankedPlayers;
+		rankedPlayers.reserve(_score.size());
+		for (const auto& standing : currentStandings())
+			rankedPlayers.push_back(_score[standing.playerId].playerName);
+
+		return rankedPlayers;
 	}
 
 	void Scoreboard::updateWithGameResults(const GameResults& results,
@@ -126,8 +230,18 @@ namespace battleship
 							   ((results.winner == PlayerEnum::B) ? "Player B wins" :
 																	 "Tie");
 
-		int playerARound = getPlayerCurrentRound(playerAName);
-		int playerBRound = getPlayerCurrentRound(playerBName);
+		auto playerAIdEntry = _playerIds.find(playerAName);
+		auto playerBIdEntry = _playerIds.find(playerBName);
+		if ((playerAIdEntry == _playerIds.end()) || (playerBIdEntry == _playerIds.end()))
+		{
+			Logger::getInstance().log(Severity::ERROR_LEVEL, "Illegal state in scoretable - player data is missing.");
+			return;
+		}
+
+		size_t playerAId = playerAIdEntry->second;
+		size_t playerBId = playerBIdEntry->second;
+		int playerARound = getPlayerCurrentRound(playerAId);
+		int playerBRound = getPlayerCurrentRound(playerBId);
 		string msg = "Game finished between Player A: " + playerAName +
 					 " (Round #" + std::to_string(playerARound) + ", " + std::to_string(results.playerAPoints) +
 					 " pts) and Player B: " + playerBName +
@@ -136,47 +250,94 @@ namespace battleship
 
 		Logger::getInstance().log(Severity::INFO_LEVEL, msg);
 
-		updatePlayerGameResults(PlayerEnum::A, playerAName, results);
-		updatePlayerGameResults(PlayerEnum::B, playerBName, results);
+		_ratingEngine.updateWithGame(playerAId, playerBId, results.winner);
+		updatePlayerGameResults(PlayerEnum::A, playerAId, results);
+		updatePlayerGameResults(PlayerEnum::B, playerBId, results);
+
+		for (const auto& listener : _gameResultsListeners)
+		{
+			listener(results, playerAName, playerBName, boardName);
+		}
+	}
+
+	void Scoreboard::addGameResultsListener(GameResultsListener listener)
+	{
+		lock_guard<mutex> lock(_scoreLock);
+		_gameResultsListeners.push_back(std::move(listener));
 	}
 
-	vector<shared_ptr<RoundResults>>& Scoreboard::getRoundResults()
+	void Scoreboard::addRoundResultsListener(RoundResultsListener listener)
+	{
+		lock_guard<mutex> lock(_scoreLock);
+		_roundResultsListeners.push_back(std::move(listener));
+	}
+
+	void Scoreboard::setRatingSystem(RatingSystem ratingSystem)
+	{
+		_ratingSystem = ratingSystem;
+	}
+
+	void Scoreboard::setConsoleOutput(bool isConsoleOutput)
+	{
+		_isConsoleOutput = isConsoleOutput;
+	}
+
+	queue<shared_ptr<RoundResults>>& Scoreboard::getRoundResults()
 	{
 		return _roundsResults;
 	}
 
+	const string& Scoreboard::getPlayerName(size_t playerId) const
+	{
+		return _score[playerId].playerName;
+	}
+
 	void Scoreboard::printRoundResults(shared_ptr<RoundResults> roundResults)
 	{
 		// Use string stream so log "block" will be printed in an atomic manner
 		stringstream ss;
 
-		ss << "Results for round " << to_string(roundResults->roundNum) << 
-			  "/" << to_string(_totalRounds) << endl;
+		ss << "Results for round " << to_string(roundResults->roundNum);
+		if (_totalRounds > 0)
+			ss << "/" << to_string(_totalRounds);
+		ss << endl;
 
 		ss << left << setw(8) << "#"
 		   << setw(_maxPlayerNameLength) << "Team Name"
 		   << setw(8) << "Wins"
 		   << setw(8) << "Losses"
 		   << setw(8) << "%"
+		   << setw(8) << "Elo"
+		   << setw(8) << "Glicko"
+		   << setw(8) << "RD"
 		   << setw(8) << "Pts For"
 		   << setw(12) << "Pts Against" << endl << endl;
 
 		int place = 1;
 
 		// RoundsResults are already sorted by player's rating
-		for (const auto& playerStats : roundResults->playerStatistics)
+		for (const auto& playerStats : roundResults->standings)
 		{
 			string placeStr = to_string(place) + ".";
 			ss << setw(8) << placeStr
-			   << setw(_maxPlayerNameLength) << playerStats.playerName
+			   << setw(_maxPlayerNameLength) << getPlayerName(playerStats.playerId)
 			   << setw(8) << playerStats.wins
 			   << setw(8) << playerStats.loses
 			   << setw(8) << setprecision(2) << fixed << playerStats.rating
+			   << setw(8) << setprecision(0) << playerStats.elo
+			   << setw(8) << playerStats.glicko
+			   << setw(8) << playerStats.glickoDeviation
 			   << setw(8) << playerStats.pointsFor
 			   << setw(12) << playerStats.pointsAgainst << endl;
 			place++;
 		}
 
+		if (!_isConsoleOutput)
+		{
+			Logger::getInstance().log(Severity::INFO_LEVEL, ss.str());
+			return;
+		}
+
 		// For the first round - we save the position of the scoreboard in the console, so we keep repainting
 		// over the same coordinate again and again
 		if (roundResults->roundNum == 1)
@@ -192,6 +353,50 @@ namespace battleship
 		Logger::getInstance().log(Severity::INFO_LEVEL, ss.str(), true); // true = Print to log & console
 	}
 
+	void Scoreboard::printAlgoLatencies(const unordered_map<string, AlgoCallLatencies>& algoLatencies) const
+	{
+		vector<pair<string, const AlgoCallLatencies*>> sortedLatencies;
+		for (const auto& latenciesEntry : algoLatencies)
+			sortedLatencies.push_back(std::make_pair(latenciesEntry.first, &latenciesEntry.second));
+
+		std::sort(sortedLatencies.begin(), sortedLatencies.end(),
+				  [](const pair<string, const AlgoCallLatencies*>& a, const pair<string, const AlgoCallLatencies*>& b)
+		{
+			return a.second->attack.percentileNanos(99) > b.second->attack.percentileNanos(99);
+		});
+
+		// Latencies are recorded in nanoseconds and printed in microseconds
+		auto toMicros = [](long long nanos) { return static_cast<double>(nanos) / 1000; };
+
+		stringstream ss;
+		ss << "Algorithm call latencies (microseconds)" << endl;
+
+		ss << left << setw(_maxPlayerNameLength) << "Team Name"
+		   << setw(10) << "Attacks"
+		   << setw(12) << "Attack p50"
+		   << setw(12) << "Attack p99"
+		   << setw(12) << "Attack max"
+		   << setw(12) << "Notify p50"
+		   << setw(12) << "Notify p99"
+		   << setw(12) << "Board max" << endl << endl;
+
+		for (const auto& latenciesEntry : sortedLatencies)
+		{
+			const AlgoCallLatencies& latencies = *latenciesEntry.second;
+			ss << setw(_maxPlayerNameLength) << latenciesEntry.first
+			   << setw(10) << latencies.attack.count()
+			   << setprecision(2) << fixed
+			   << setw(12) << toMicros(latencies.attack.percentileNanos(50))
+			   << setw(12) << toMicros(latencies.attack.percentileNanos(99))
+			   << setw(12) << toMicros(latencies.attack.maxNanos())
+			   << setw(12) << toMicros(latencies.notifyOnAttackResult.percentileNanos(50))
+			   << setw(12) << toMicros(latencies.notifyOnAttackResult.percentileNanos(99))
+			   << setw(12) << toMicros(latencies.setBoard.maxNanos()) << endl;
+		}
+
+		Logger::getInstance().log(Severity::INFO_LEVEL, ss.str(), _isConsoleOutput);
+	}
+
 	void Scoreboard::processRoundResultsQueue(bool isLockResultsQueue)
 	{
 		auto processQueueLogic = [this]() {
@@ -199,8 +404,8 @@ namespace battleship
 			// After they are printed, we pop this data from the queue
 			while (!_roundsResults.empty())
 			{
-				auto nextResults = _roundsResults.front();
-				_roundsResults.erase(_roundsResults.begin());
+				auto nextResults = std::move(_roundsResults.front());
+				_roundsResults.pop();
 				printRoundResults(nextResults);
 			}
 		};
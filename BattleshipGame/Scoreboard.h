@@ -2,18 +2,20 @@
 
 #include <memory>
 #include <vector>
-#include <map>
+#include <queue>
 #include <unordered_map>
 #include <mutex>
 #include <functional>
 #include "GameManager.h"
 #include "PlayerStatistics.h"
+#include "LatencyHistogram.h"
+#include "RatingEngine.h"
 
 using std::shared_ptr;
 using std::pair;
 using std::vector;
 using std::unordered_map;
-using std::map;
+using std::queue;
 using std::string;
 using std::mutex;
 using std::condition_variable;
@@ -21,17 +23,46 @@ using std::function;
 
 namespace battleship
 {
-	struct PlayerStatisticsRatingSort {
-		bool operator()(const PlayerStatistics& a, const PlayerStatistics& b) const
+	/** A player's standing at the end of a round, kept as a compact numeric row.
+	 *  The player is identified by its id in the scoreboard (see Scoreboard::getPlayerName).
+	 */
+	struct RoundStanding
+	{
+		size_t playerId;
+		int pointsFor;
+		int pointsAgainst;
+		int wins;
+		int loses;
+		int ties;
+		float rating;			// Win percentage
+		float elo;				// Elo rating
+		float glicko;			// Glicko-2 rating
+		float glickoDeviation;	// Glicko-2 rating deviation
+
+		RoundStanding(size_t aPlayerId, const PlayerStatistics& statistics, const PlayerRating& playerRating);
+
+		/** Returns the player's rating in the given rating system */
+		float getRating(RatingSystem ratingSystem) const;
+	};
+
+	struct RoundStandingRatingSort {
+		RatingSystem ratingSystem;
+
+		RoundStandingRatingSort(RatingSystem aRatingSystem) : ratingSystem(aRatingSystem) {}
+
+		bool operator()(const RoundStanding& a, const RoundStanding& b) const
 		{
-			if (a.rating == b.rating)
+			float aRating = a.getRating(ratingSystem);
+			float bRating = b.getRating(ratingSystem);
+
+			if (aRating == bRating)
 			{
-				return a.playerName > b.playerName; // Don't consider equal unless this is the same player
-													// (for equal rating we choose some inner order between the players)
+				return a.playerId > b.playerId; // Player ids follow the players' names order, so for equal rating
+												// we choose some inner order between the players
 			}
 			else
 			{
-				return a.rating > b.rating;
+				return aRating > bRating;
 			}
 		}
 	};
@@ -39,7 +70,7 @@ namespace battleship
 	struct RoundResults
 	{
 		int roundNum;
-		set<PlayerStatistics, PlayerStatisticsRatingSort> playerStatistics;
+		vector<RoundStanding> standings; // Sorted by rating once the round is finished
 
 		RoundResults(int aRoundNum);
 	};
@@ -52,7 +83,21 @@ namespace battleship
 	class Scoreboard
 	{
 	public:
-		Scoreboard(vector<string> players, size_t totalRounds);
+		/** Callback invoked for every game result the scoreboard is updated with */
+		using GameResultsListener = function<void(const GameResults& results,
+												  const string& playerAName, const string& playerBName,
+												  const string& boardName)>;
+
+		/** Callback invoked for every round that is finished, with the standings of the round */
+		using RoundResultsListener = function<void(shared_ptr<const RoundResults> roundResults)>;
+
+		/** Creates a scoreboard for the given players.
+		 *  If isRoundPerGame is true, round #r of a player is finished with the player's r-th game and the round's
+		 *  results are published once all players finished it. Otherwise rounds are finished by calling finishRound
+		 *  (e.g. by a tournament format whose rounds don't have the same number of games for all players).
+		 *  totalRounds is 0 if the number of rounds isn't known in advance.
+		 */
+		Scoreboard(vector<string> players, size_t totalRounds, bool isRoundPerGame = true);
 		virtual ~Scoreboard() = default;
 
 		/** Update the score table with the game results.
@@ -62,10 +107,31 @@ namespace battleship
 								   const string& playerAName, const string& playerBName,
 								   const string& boardName);
 
-		/** A "queue" of round results for rounds that are finished being played.
+		/** Publishes the current standings of all players as the results of the next round.
+		 *  Only used when rounds aren't finished per game (see the constructor). This method is thread safe.
+		 */
+		void finishRound();
+
+		/** Adds players to a competition that is already running, which now has totalRounds rounds.
+		 *  New players join from the first round that isn't finished yet: their games count towards their
+		 *  statistics from the start, but the rounds that were published before they joined aren't published again.
+		 *  New players get the next player ids, so ids no longer follow the names order.
+		 *  Only used when rounds are finished per game. This method is thread safe.
+		 */
+		void addPlayers(const vector<string>& players, size_t totalRounds);
+
+		/** Returns the names of all players, ordered by their current standing (best first).
+		 *  This method is thread safe.
+		 */
+		vector<string> getRankedPlayers();
+
+		/** A queue of round results for rounds that are finished being played.
 		 *  Outside consumers are expected to pop entries from this data structure after processing them.
 		 */
-		vector<shared_ptr<RoundResults>>& getRoundResults();
+		queue<shared_ptr<RoundResults>>& getRoundResults();
+
+		/** Returns the name of the player with the given id (as used in RoundStanding) */
+		const string& getPlayerName(size_t playerId) const;
 
 		/** Waits on round results queue until new data is ready,
 		 *  when it arrives - trigger the print results table function (as a callback)
@@ -77,6 +143,34 @@ namespace battleship
 		 */
 		void processRoundResultsQueue(bool isLockResultsQueue);
 
+		/** Registers a listener that is notified on each game result.
+		 *  Listeners are invoked under the score table lock (one at a time), so they should return quickly.
+		 *  Listeners should be registered before the competition starts.
+		 */
+		void addGameResultsListener(GameResultsListener listener);
+
+		/** Registers a listener that is notified on each finished round (before the round results are printed).
+		 *  Listeners are invoked under the score table lock (one at a time), so they should return quickly.
+		 *  Listeners should be registered before the competition starts.
+		 */
+		void addRoundResultsListener(RoundResultsListener listener);
+
+		/** Prints a table of the algorithms' call latencies below the round results (to the console, if console
+		 *  output is enabled, and to the log). Algorithms are listed from the slowest attack p99 to the fastest,
+		 *  so slow algorithms stand out. Expected to be called once the competition is over.
+		 */
+		void printAlgoLatencies(const unordered_map<string, AlgoCallLatencies>& algoLatencies) const;
+
+		/** Sets the rating system the round standings are ordered by (win percentage by default).
+		 *  Elo and Glicko-2 ratings are printed in any case. Should be called before the competition starts.
+		 */
+		void setRatingSystem(RatingSystem ratingSystem);
+
+		/** Sets whether round results tables are printed to the console (true by default).
+		 *  When disabled, round results are still written to the log.
+		 */
+		void setConsoleOutput(bool isConsoleOutput);
+
 	private:
 
 		/** Minimal space allocated for player name in the table (visual parameter) */
@@ -91,6 +185,13 @@ namespace battleship
 		// Number of player entries that must be present for a round to count as finished
 		size_t _playersPerRound;
 
+		// True if a player's round is finished with each game the player plays, false if rounds are
+		// finished by finishRound
+		bool _isRoundPerGame;
+
+		// Number of rounds finished so far (rounds are finished in order)
+		int _finishedRoundsCount;
+
 		// A mutex lock to protect the score table during updates from multiple worker thread updates
 		mutex _scoreLock;
 
@@ -100,19 +201,38 @@ namespace battleship
 		// A predicate to notify listeners on the _roundResults queue that new data is ready
 		condition_variable _roundResultsCV;
 
-		// Current points & statistics for each player, contains the most up to date info about each player
-		map<string, PlayerStatistics> _score;
+		// Current points & statistics for each player, contains the most up to date info about each player.
+		// Indexed by player id, players are sorted by name (players added by addPlayers follow them).
+		vector<PlayerStatistics> _score;
+
+		// Maps player name to the player id (index in _score)
+		unordered_map<string, size_t> _playerIds;
+
+		// Elo and Glicko-2 ratings of the players, updated with every game result
+		RatingEngine _ratingEngine;
+
+		// Rating system the round standings are ordered by
+		RatingSystem _ratingSystem;
 
 		// Tracked matches data - 
 		// key is round number
 		// value is RoundResults (that accumulates data from finished games for each player for that round)
+		// A round is removed from here as soon as it's finished, so only rounds in progress are kept
 		unordered_map<int, shared_ptr<RoundResults>> _trackedMatches;
 
 		// Contains results of finished rounds of games.
 		// This data is ready for printing and is kept here until queried by the reporter thread.
-		// Data is pushed to this vector only when the round is finished.
-		// _roundResults is volatile to make sure it's handled before condition_variables are notified
-		vector<shared_ptr<RoundResults>> _roundsResults;
+		// Data is pushed to this queue only when the round is finished, and released once it's printed.
+		queue<shared_ptr<RoundResults>> _roundsResults;
+
+		// Listeners notified on each game result
+		vector<GameResultsListener> _gameResultsListeners;
+
+		// Listeners notified on each finished round
+		vector<RoundResultsListener> _roundResultsListeners;
+
+		// True if round results tables are printed to the console
+		bool _isConsoleOutput;
 
 		// Holds the longest player name encountered
 		size_t _maxPlayerNameLength;
@@ -122,13 +242,21 @@ namespace battleship
 
 		/** Update the score table with the results for a single player from a single match
 		 */
-		void updatePlayerGameResults(PlayerEnum player, const string& playerName, const GameResults& results);
+		void updatePlayerGameResults(PlayerEnum player, size_t playerId, const GameResults& results);
+
+		/** Sorts the round's standings, notifies the listeners and queues the round for printing.
+		 *  Called with the score table locked.
+		 */
+		void publishRoundResults(shared_ptr<RoundResults> roundResults);
+
+		/** Current standings of all players, sorted by rating. Called with the score table locked. */
+		vector<RoundStanding> currentStandings() const;
 
 		/** Prints the round results in a formatted table to the console
 		 */
 		void printRoundResults(shared_ptr<RoundResults> roundResults);
 
 		/** Get the next round for the player (to submit score to) */
-		int getPlayerCurrentRound(const string& player) const;
+		int getPlayerCurrentRound(size_t playerId) const;
 	};
 }
@@ -0,0 +1,111 @@
+#include "ShardCoordinator.h"
+#include "Logger.h"
+#include <windows.h>
+#include <cstdio>
+#include <algorithm>
+#include <iterator>
+
+using std::to_string;
+using std::max;
+
+namespace battleship
+{
+	ShardCoordinator::ShardCoordinator(const Configuration& config, const string& absolutePath) :
+		_path(absolutePath),
+		_shardsCount(config.shards),
+		_threadsPerShard(max(1, config.threads / config.shards)) // Split the threads budget between the shards
+	{
+	}
+
+	string ShardCoordinator::shardResultsFile(const string& path, int shardIndex)
+	{
+		return path + "\\" + SHARD_RESULTS_FILE_PREFIX + to_string(shardIndex) + SHARD_RESULTS_FILE_SUFFIX;
+	}
+
+	string ShardCoordinator::shardCommandLine(const string& executable, int shardIndex) const
+	{
+		return "\"" + executable + "\" \"" + _path + "\"" +
+			   " -threads " + to_string(_threadsPerShard) +
+			   " -shards " + to_string(_shardsCount) +
+			   " -shard " + to_string(shardIndex);
+	}
+
+	vector<GameRecord> ShardCoordinator::runShards()
+	{
+		vector<GameRecord> records;
+
+		char executable[MAX_PATH];
+		if (GetModuleFileNameA(NULL, executable, MAX_PATH) == 0)
+		{
+			Logger::getInstance().log(Severity::ERROR_LEVEL, "Failed to locate the executable, can't start shard processes");
+			return records;
+		}
+
+		// Start all shards, they run in parallel to each other
+		vector<PROCESS_INFORMATION> shardProcesses;
+		vector<int> shardIndices;
+		for (int shardIndex = 0; shardIndex < _shardsCount; shardIndex++)
+		{
+			// Results left over from a previous run must not be mistaken for this run's results
+			std::remove(shardResultsFile(_path, shardIndex).c_str());
+
+			string commandLine = shardCommandLine(executable, shardIndex);
+			vector<char> commandLineBuffer(commandLine.begin(), commandLine.end());
+			commandLineBuffer.push_back('\0'); // CreateProcessA may modify the command line buffer
+
+			STARTUPINFOA startupInfo;
+			ZeroMemory(&startupInfo, sizeof(startupInfo));
+			startupInfo.cb = sizeof(startupInfo);
+			PROCESS_INFORMATION processInfo;
+			ZeroMemory(&processInfo, sizeof(processInfo));
+
+			if (!CreateProcessA(NULL, commandLineBuffer.data(), NULL, NULL, FALSE, CREATE_NO_WINDOW,
+								NULL, NULL, &startupInfo, &processInfo))
+			{
+				Logger::getInstance().log(Severity::ERROR_LEVEL,
+										  "Failed to start shard #" + to_string(shardIndex) +
+										  " (error " + to_string(GetLastError()) + ")");
+				continue;
+			}
+
+			Logger::getInstance().log(Severity::INFO_LEVEL, "Shard #" + to_string(shardIndex) + " started..");
+			shardProcesses.push_back(processInfo);
+			shardIndices.push_back(shardIndex);
+		}
+
+		// Wait for all shards and collect the games each of them recorded.
+		// Records of a crashed shard are still collected: every record is flushed as soon as the game ends.
+		for (size_t i = 0; i < shardProcesses.size(); i++)
+		{
+			auto& processInfo = shardProcesses[i];
+			int shardIndex = shardIndices[i];
+
+			WaitForSingleObject(processInfo.hProcess, INFINITE);
+
+			DWORD exitCode = 0;
+			GetExitCodeProcess(processInfo.hProcess, &exitCode);
+			CloseHandle(processInfo.hThread);
+			CloseHandle(processInfo.hProcess);
+
+			auto shardRecords = GameRecord::readAll(shardResultsFile(_path, shardIndex));
+
+			if (exitCode != SHARD_SUCCESS_CODE)
+			{
+				Logger::getInstance().log(Severity::WARNING_LEVEL,
+										  "Shard #" + to_string(shardIndex) + " failed with exit code " +
+										  to_string(exitCode) + " after " + to_string(shardRecords.size()) +
+										  " games, its remaining games will be played locally");
+			}
+			else
+			{
+				Logger::getInstance().log(Severity::INFO_LEVEL,
+										  "Shard #" + to_string(shardIndex) + " finished with " +
+										  to_string(shardRecords.size()) + " games");
+			}
+
+			std::move(shardRecords.begin(), shardRecords.end(), std::back_inserter(records));
+		}
+
+		return records;
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include "Configuration.h"
+#include "GameRecord.h"
+
+using std::string;
+using std::vector;
+
+namespace battleship
+{
+	/** Splits the competition between several local processes of this same executable (shards) and collects
+	 *  the games they played.
+	 *  Each shard plays a deterministic part of the competition games (see CompetitionShard) and records them to
+	 *  its own results file. A shard that crashes only loses its own games, which the coordinator can then
+	 *  play locally.
+	 */
+	class ShardCoordinator
+	{
+	public:
+		/** Creates a coordinator for the given configuration. The path must be absolute, since it's passed to
+		 *  the shard processes.
+		 */
+		ShardCoordinator(const Configuration& config, const string& absolutePath);
+		virtual ~ShardCoordinator() = default;
+
+		ShardCoordinator(ShardCoordinator const&) = delete;	// Disable copying
+		ShardCoordinator& operator=(ShardCoordinator const&) = delete;	// Disable copying (assignment)
+
+		/** Spawns all shard processes, waits for them to finish and returns the records of all games they played.
+		 *  Games of shards that failed are missing from the list.
+		 */
+		vector<GameRecord> runShards();
+
+		/** Name of the results file the shard with the given index writes its game records to */
+		static string shardResultsFile(const string& path, int shardIndex);
+
+	private:
+		/** Prefix of shard results files (followed by the shard index) */
+		static constexpr auto SHARD_RESULTS_FILE_PREFIX = "shard_";
+
+		/** Suffix of shard results files */
+		static constexpr auto SHARD_RESULTS_FILE_SUFFIX = ".results";
+
+		/** Process exit code of a shard that finished successfully */
+		static constexpr unsigned long SHARD_SUCCESS_CODE = 0;
+
+		// Absolute path of the dlls / boards, passed on to the shards
+		string _path;
+
+		// Total number of shards
+		int _shardsCount;
+
+		// Number of worker threads each shard runs
+		int _threadsPerShard;
+
+		/** Builds the command line that starts the shard with the given index */
+		string shardCommandLine(const string& executable, int shardIndex) const;
+	};
+}
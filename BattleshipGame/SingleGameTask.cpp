@@ -1,66 +1,109 @@
 #include "SingleGameTask.h"
-#include "BoardDataImpl.h"
 #include "Logger.h"
 #include <algorithm>
+#include <chrono>
 
 using std::min;
 using std::max;
+using std::chrono::steady_clock;
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
 
 namespace battleship
 {
-	SingleGameTask::SingleGameTask(const string& playerAName, const string& playerBName,
+	SingleGameTask::SingleGameTask(size_t taskId, const string& playerAName, const string& playerBName,
 								   const string& boardName):
+		_taskId(taskId),
 		_playerAName(playerAName),
 		_playerBName(playerBName),
 		_boardName(boardName)
 	{
-		string msg = "Created game between Player A: " + _playerAName +
-					 " and Player B: " + _playerBName +
-					 " on board: " + _boardName + ".";
-		Logger::getInstance().log(Severity::DEBUG_LEVEL, msg);
+		// Tasks are created as the games are dealt, don't format the message unless it's logged
+		if (Logger::getInstance().isLoggable(Severity::DEBUG_LEVEL))
+		{
+			string msg = "Created game between Player A: " + _playerAName +
+						 " and Player B: " + _playerBName +
+						 " on board: " + _boardName + ".";
+			Logger::getInstance().log(Severity::DEBUG_LEVEL, msg);
+		}
 	}
 
-	void SingleGameTask::run(WorkerThreadResourcePool& resourcePool, Scoreboard* scoreBoard) const
+	GameResults SingleGameTask::run(WorkerThreadResourcePool& resourcePool, Scoreboard* scoreBoard,
+									ResultsCache* resultsCache) const
 	{
+		auto gameStartTime = steady_clock::now();
+
+		// Games played by earlier competitions aren't played again
+		GameResults cachedResults{ PlayerEnum::NONE, 0, 0, 0, 0, 0, 0 };
+		auto cacheLookup = ResultsCache::Lookup::MISS;
+		if (resultsCache != nullptr)
+		{
+			cacheLookup = resultsCache->lookup(_playerAName, _playerBName, _boardName, cachedResults);
+			if (cacheLookup == ResultsCache::Lookup::HIT)
+			{
+				cachedResults.durationMicros = duration_cast<microseconds>(steady_clock::now() - gameStartTime).count();
+				scoreBoard->updateWithGameResults(cachedResults, _playerAName, _playerBName, _boardName);
+				return cachedResults;
+			}
+		}
+
 		// Load resources
-		auto playerA = resourcePool.requestAlgo(_playerAName);
-		auto playerB = resourcePool.requestAlgo(_playerBName);
+		auto playerA = resourcePool.acquireAlgo(_playerAName);
+		auto playerB = resourcePool.acquireAlgo(_playerBName);
 		auto board = resourcePool.requestBoard(_boardName);
+		auto playerAView = resourcePool.requestBoardView(_boardName, PlayerEnum::A);
+		auto playerBView = resourcePool.requestBoardView(_boardName, PlayerEnum::B);
 
-		if ((playerA == nullptr) || (playerB == nullptr) || (board == nullptr))
+		if ((playerA == nullptr) || (playerB == nullptr) || (board == nullptr) ||
+			(playerAView == nullptr) || (playerBView == nullptr))
 		{
 			string msg = "Error: Can't start a game between Player A: " + _playerAName +
 						 " and Player B: " + _playerBName +
 					     " on board: " + _boardName + " due to invalid resources";
 			Logger::getInstance().log(Severity::ERROR_LEVEL, msg);
 
+			// Return whichever player was created, it's still good for other games
+			resourcePool.releaseAlgo(_playerAName, std::move(playerA));
+			resourcePool.releaseAlgo(_playerBName, std::move(playerB));
+
 			// Declare a tie so we won't be missing games for a round
-			GameResults gameResults{ PlayerEnum::NONE, 0, 0 };
+			GameResults gameResults{ PlayerEnum::NONE, 0, 0, 0, 0, 0, 0 };
 			scoreBoard->updateWithGameResults(gameResults, _playerAName, _playerBName, _boardName);
-			return;
+			return gameResults;
 		}
 
 		Logger::getInstance().log(Severity::DEBUG_LEVEL,
 								  "Game started between Player A: " + _playerAName +
 								  " and Player B: " + _playerBName + " on board: " + _boardName + ".");
 
-		// Player views will be kept alive for the duration of the game (this scope)
-		auto playerAView = std::make_unique<BoardDataImpl>(PlayerEnum::A, board);
-		auto playerBView = std::make_unique<BoardDataImpl>(PlayerEnum::B, board);
+		// Player views are shared with all other games on this board, and outlive this game.
+		// Algorithms that access the view after the game is over won't collapse the game manager.
+		auto runGame = resourcePool.requestGameRunner(_playerAName, _playerBName);
+		GameLatencyScope latencyScope(&resourcePool.algoLatencies(_playerAName),
+									  &resourcePool.algoLatencies(_playerBName));
+		GameResults gameResults = runGame(board, playerA.get(), playerB.get(), *playerAView, *playerBView);
+
+		// The game's board is gone, all of the game's memory can be reused by the next game
+		board.reset();
+		resourcePool.releaseGameMemory();
+		gameResults.durationMicros = duration_cast<microseconds>(steady_clock::now() - gameStartTime).count();
 
-		// Run a single game and update scoreboard with results
-		auto gameResults = GameManager::runGame(board, playerA, playerB, *playerAView, *playerBView);
+		// Players go back to the pool for the next games of this worker thread
+		resourcePool.releaseAlgo(_playerAName, std::move(playerA));
+		resourcePool.releaseAlgo(_playerBName, std::move(playerB));
 
-		// Keep player held views alive until the player gets a new board from the next game.
-		// This should prevent pesky players that access the boardView after the game is over
-		// from collapsing the game manager.
-		// Note 1: The pointer is moved and no longer valid but the algo keeps a reference to the
-		// real object which stays intact.
-		// Note 2: BattleBoard lifetime is extended by the BoardDataImpl view so we only cache that.
-		resourcePool.cacheResourcesForPlayer(_playerAName, std::move(playerAView));
-		resourcePool.cacheResourcesForPlayer(_playerBName, std::move(playerBView));
+		if (cacheLookup == ResultsCache::Lookup::VERIFY)
+			resultsCache->verify(_playerAName, _playerBName, _boardName, cachedResults, gameResults);
+		else if (resultsCache != nullptr)
+			resultsCache->store(_playerAName, _playerBName, _boardName, gameResults);
 
-		scoreBoard->updateWithGameResults(*gameResults, _playerAName, _playerBName, _boardName);
+		scoreBoard->updateWithGameResults(gameResults, _playerAName, _playerBName, _boardName);
+		return gameResults;
+	}
+
+	size_t SingleGameTask::taskId() const
+	{
+		return _taskId;
 	}
 
 	const string& SingleGameTask::playerAName() const
@@ -3,6 +3,7 @@
 #include <memory>
 #include "Scoreboard.h"
 #include "WorkerThreadResourcePool.h"
+#include "ResultsCache.h"
 
 using std::shared_ptr;
 using std::string;
@@ -13,15 +14,22 @@ namespace battleship
 	class SingleGameTask
 	{
 	public:
-		SingleGameTask(const string& playerAName, const string& playerBName,
+		SingleGameTask(size_t taskId, const string& playerAName, const string& playerBName,
 					   const string& boardName);
 		virtual ~SingleGameTask() = default;
 
 		/** Run single game betwen playerA and playerB on stored board.
 		 *  This method will allocate the resources needed to run the game if not already cached for
-		 *  this worker thread, and then run the game and update the scoreboard with the results
+		 *  this worker thread, and then run the game and update the scoreboard with the results.
+		 *  The game results are returned as well.
+		 *  If a results cache is given, a game it holds isn't played (unless it's sampled for verification),
+		 *  and the results of a game that is played are added to it.
 		 */
-		void run(WorkerThreadResourcePool& resourcePool, Scoreboard* scoreBoard) const;
+		GameResults run(WorkerThreadResourcePool& resourcePool, Scoreboard* scoreBoard,
+						ResultsCache* resultsCache = nullptr) const;
+
+		/** Position of this game in the competition's full list of games (stable between runs and processes) */
+		size_t taskId() const;
 
 		const string& playerAName() const;
 		const string& playerBName() const;
@@ -29,6 +37,9 @@ namespace battleship
 
 	private:
 
+		// Position of the game in the competition
+		size_t _taskId;
+
 		// Player algo path identifiers
 		string _playerAName;
 		string _playerBName;
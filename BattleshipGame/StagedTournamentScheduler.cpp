@@ -0,0 +1,155 @@
+#include "StagedTournamentScheduler.h"
+#include "Logger.h"
+
+using std::lock_guard;
+using std::unique_lock;
+using std::to_string;
+
+namespace battleship
+{
+	StagedTournamentScheduler::Match::Match(size_t aPlayer1, size_t aPlayer2) :
+		player1(aPlayer1),
+		player2(aPlayer2),
+		player1Wins(0),
+		player2Wins(0),
+		player1Points(0),
+		player2Points(0)
+	{
+	}
+
+	StagedTournamentScheduler::StagedTournamentScheduler(const vector<string>& players, const vector<string>& boards,
+														 vector<size_t> boardsOrder, Scoreboard& scoreboard) :
+		_players(players),
+		_boards(boards),
+		_boardsOrder(std::move(boardsOrder)),
+		_scoreboard(scoreboard),
+		_roundFirstTaskId(0),
+		_dealtRoundGamesCount(0),
+		_finishedRoundGamesCount(0),
+		_isStarted(false),
+		_isOver(false)
+	{
+		for (size_t player = 0; player < _players.size(); player++)
+			_playerIndices.emplace(_players[player], player);
+	}
+
+	size_t StagedTournamentScheduler::playersCount() const
+	{
+		return _players.size();
+	}
+
+	vector<size_t> StagedTournamentScheduler::rankedPlayers() const
+	{
+		vector<size_t> ranking;
+		for (const string& player : _scoreboard.getRankedPlayers())
+			ranking.push_back(_playerIndices.at(player));
+
+		return ranking;
+	}
+
+	size_t StagedTournamentScheduler::pendingGamesUpperBound() const
+	{
+		size_t matchGamesCount = 2 * _boards.size();
+		size_t roundPendingGamesCount = _roundGames.size() - _finishedRoundGamesCount;
+		return roundPendingGamesCount + unpairedMatchesCount(_roundMatches.size()) * matchGamesCount;
+	}
+
+	size_t StagedTournamentScheduler::pendingGamesCount() const
+	{
+		lock_guard<mutex> lock(_roundLock);
+		return pendingGamesUpperBound();
+	}
+
+	bool StagedTournamentScheduler::isExhausted() const
+	{
+		// A tournament too small to have any games is over before it started
+		lock_guard<mutex> lock(_roundLock);
+		return _isOver || (pendingGamesUpperBound() == 0);
+	}
+
+	void StagedTournamentScheduler::startNextRound()
+	{
+		vector<Match> finishedMatches;
+		finishedMatches.swap(_roundMatches);
+		_roundFirstTaskId += _roundGames.size();
+		_roundGames.clear();
+		_dealtRoundGamesCount = 0;
+		_finishedRoundGamesCount = 0;
+
+		for (const auto& pairing : pairNextRound(finishedMatches))
+			_roundMatches.emplace_back(pairing.first, pairing.second);
+
+		// Deal the round board by board, so the biggest boards are played first
+		for (size_t board : _boardsOrder)
+		{
+			for (size_t match = 0; match < _roundMatches.size(); match++)
+			{
+				_roundGames.push_back(RoundGame{ match, board, false });
+				_roundGames.push_back(RoundGame{ match, board, true });
+			}
+		}
+
+		if (_roundGames.empty())
+		{
+			_isOver = true;
+			Logger::getInstance().log(Severity::INFO_LEVEL, "Tournament finished, no more rounds to pair.");
+		}
+		else
+		{
+			Logger::getInstance().log(Severity::INFO_LEVEL, "Next tournament round paired: " +
+									  to_string(_roundMatches.size()) + " matches, " +
+									  to_string(_roundGames.size()) + " games.");
+		}
+	}
+
+	unique_ptr<SingleGameTask> StagedTournamentScheduler::next()
+	{
+		unique_lock<mutex> lock(_roundLock);
+
+		if (!_isStarted)
+		{
+			_isStarted = true;
+			startNextRound();
+		}
+
+		// All games of the round were dealt: wait for the round to finish, the next round depends on its results
+		_roundCV.wait(lock, [this] { return _isOver || (_dealtRoundGamesCount < _roundGames.size()); });
+		if (_isOver)
+			return nullptr;
+
+		size_t gameIndex = _dealtRoundGamesCount++;
+		const RoundGame& game = _roundGames[gameIndex];
+		const Match& match = _roundMatches[game.match];
+		size_t playerA = game.isInversed ? match.player2 : match.player1;
+		size_t playerB = game.isInversed ? match.player1 : match.player2;
+
+		return std::make_unique<SingleGameTask>(_roundFirstTaskId + gameIndex, _players[playerA], _players[playerB],
+												_boards[game.board]);
+	}
+
+	void StagedTournamentScheduler::onGameFinished(const SingleGameTask& task, const GameResults& results)
+	{
+		lock_guard<mutex> lock(_roundLock);
+
+		const RoundGame& game = _roundGames[task.taskId() - _roundFirstTaskId];
+		Match& match = _roundMatches[game.match];
+
+		PlayerEnum player1Side = game.isInversed ? PlayerEnum::B : PlayerEnum::A;
+		PlayerEnum player2Side = game.isInversed ? PlayerEnum::A : PlayerEnum::B;
+		if (results.winner == player1Side)
+			match.player1Wins++;
+		else if (results.winner == player2Side)
+			match.player2Wins++;
+
+		match.player1Points += game.isInversed ? results.playerBPoints : results.playerAPoints;
+		match.player2Points += game.isInversed ? results.playerAPoints : results.playerBPoints;
+
+		// The scoreboard already has the results of all the round's games: publish the round and pair the next one
+		if (++_finishedRoundGamesCount == _roundGames.size())
+		{
+			_scoreboard.finishRound();
+			startNextRound();
+			_roundCV.notify_all();
+		}
+	}
+}
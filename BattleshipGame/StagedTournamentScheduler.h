@@ -0,0 +1,124 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <mutex>
+#include <condition_variable>
+#include "TournamentScheduler.h"
+#include "Scoreboard.h"
+
+using std::vector;
+using std::string;
+using std::unordered_map;
+using std::pair;
+using std::mutex;
+using std::condition_variable;
+
+namespace battleship
+{
+	/** Base of tournament formats that are played in rounds of matches, where the pairings of each round depend on
+	 *  the results of the rounds before it (e.g. Swiss or knockout).
+	 *  A match between two players is made of a game on every board in each of the players' orders.
+	 *  The games of a round are dealt once the previous round is finished. When the last game of a round is
+	 *  finished, the round's standings are published to the scoreboard and the next round is paired out of the live
+	 *  scoreboard state.
+	 *  The scoreboard must finish its rounds by finishRound (it shouldn't be a round per game scoreboard).
+	 */
+	class StagedTournamentScheduler : public TournamentScheduler
+	{
+	public:
+		/** boardsOrder is the order in which the boards are dealt within each round (indices into boards) */
+		StagedTournamentScheduler(const vector<string>& players, const vector<string>& boards,
+								  vector<size_t> boardsOrder, Scoreboard& scoreboard);
+		virtual ~StagedTournamentScheduler() = default;
+
+		StagedTournamentScheduler(StagedTournamentScheduler const&) = delete;	// Disable copying
+		StagedTournamentScheduler& operator=(StagedTournamentScheduler const&) = delete;	// Disable copying (assignment)
+
+		size_t pendingGamesCount() const override;
+		bool isExhausted() const override;
+		unique_ptr<SingleGameTask> next() override;
+		void onGameFinished(const SingleGameTask& task, const GameResults& results) override;
+
+	protected:
+		/** A match between two players (indices into the players list) and its results so far */
+		struct Match
+		{
+			size_t player1;
+			size_t player2;
+			int player1Wins;
+			int player2Wins;
+			int player1Points;
+			int player2Points;
+
+			Match(size_t aPlayer1, size_t aPlayer2);
+		};
+
+		/** Pairs the players for the next round. finishedMatches are the matches of the round that just finished
+		 *  (empty for the first round). Returns no pairs when the tournament is over.
+		 *  Called with the round lock held, after the scoreboard was updated with all the finished games.
+		 */
+		virtual vector<pair<size_t, size_t>> pairNextRound(const vector<Match>& finishedMatches) = 0;
+
+		/** Upper bound on the number of matches in the rounds that weren't paired yet.
+		 *  Called with the round lock held.
+		 */
+		virtual size_t unpairedMatchesCount(size_t currentRoundMatchesCount) const = 0;
+
+		/** Number of players in the tournament */
+		size_t playersCount() const;
+
+		/** All players (indices into the players list), ordered by their current standing in the scoreboard */
+		vector<size_t> rankedPlayers() const;
+
+	private:
+		/** A game of the current round: the match it belongs to, its board, and whether the match's second player
+		 *  plays as player A
+		 */
+		struct RoundGame
+		{
+			size_t match;
+			size_t board;
+			bool isInversed;
+		};
+
+		vector<string> _players;
+		vector<string> _boards;
+		vector<size_t> _boardsOrder;
+		Scoreboard& _scoreboard;
+
+		/** Maps each player's name to its index in _players */
+		unordered_map<string, size_t> _playerIndices;
+
+		/** Matches and games of the current round */
+		vector<Match> _roundMatches;
+		vector<RoundGame> _roundGames;
+
+		/** Task id of the first game of the current round, games get consecutive task ids in dealing order */
+		size_t _roundFirstTaskId;
+
+		/** Number of games of the current round that were dealt, and that were finished */
+		size_t _dealtRoundGamesCount;
+		size_t _finishedRoundGamesCount;
+
+		/** True once the first round was paired */
+		bool _isStarted;
+
+		/** True once there are no more rounds to play */
+		bool _isOver;
+
+		/** Protects the current round, and wakes up the workers waiting for the next round */
+		mutable mutex _roundLock;
+		condition_variable _roundCV;
+
+		/** Upper bound on the number of games left to play. Called with the round lock held. */
+		size_t pendingGamesUpperBound() const;
+
+		/** Pairs the next round and creates its games, or marks the tournament over.
+		 *  Called with the round lock held.
+		 */
+		void startNextRound();
+	};
+}
@@ -0,0 +1,84 @@
+#include "StaticAlgoRegistry.h"
+#include "HuntTargetAlgo.h"
+#include "Logger.h"
+#include <algorithm>
+
+namespace battleship
+{
+	const StaticAlgoRegistry::StaticAlgoEntry StaticAlgoRegistry::STATIC_ALGOS[] =
+	{
+		{ "HuntTargetAlgo", &HuntTargetAlgo::create }
+	};
+
+	const StaticAlgoRegistry::GameRunnerEntry StaticAlgoRegistry::GAME_RUNNERS[] =
+	{
+		// Most specific entries first, the first matching entry is used
+		{ "HuntTargetAlgo", "HuntTargetAlgo", false, &StaticAlgoRegistry::runStaticGame<HuntTargetAlgo, HuntTargetAlgo> },
+		{ "HuntTargetAlgo", nullptr, false, &StaticAlgoRegistry::runStaticGame<HuntTargetAlgo, IBattleshipGameAlgo> },
+		{ "HuntTargetAlgo", nullptr, true, &StaticAlgoRegistry::runStaticGame<HuntTargetAlgo, BatchedAlgoAdapter> },
+		{ nullptr, "HuntTargetAlgo", false, &StaticAlgoRegistry::runStaticGame<IBattleshipGameAlgo, HuntTargetAlgo> },
+		{ nullptr, "HuntTargetAlgo", true, &StaticAlgoRegistry::runStaticGame<BatchedAlgoAdapter, HuntTargetAlgo> }
+	};
+
+	int StaticAlgoRegistry::registerAll(AlgoLoader& algoLoader)
+	{
+		int registeredCount = 0;
+
+		for (const auto& staticAlgo : STATIC_ALGOS)
+		{
+			if (algoLoader.registerStaticAlgorithm(staticAlgo.name, staticAlgo.algoFunc))
+				registeredCount++;
+		}
+
+		return registeredCount;
+	}
+
+	bool StaticAlgoRegistry::isStaticAlgo(const AlgoLoader& algoLoader, const string& algoName)
+	{
+		auto algoFunc = algoLoader.staticAlgorithmFunc(algoName);
+		if (algoFunc == nullptr)
+			return false;
+
+		// The name must also be backed by the registry's own algorithm, otherwise the instance type is unknown
+		return std::any_of(std::begin(STATIC_ALGOS), std::end(STATIC_ALGOS),
+						   [&algoName, algoFunc](const StaticAlgoEntry& entry)
+		{
+			return (algoName == entry.name) && (algoFunc == entry.algoFunc);
+		});
+	}
+
+	bool StaticAlgoRegistry::isMatchingName(const char* entryName, bool isAnyAlgoExtended,
+											const string& algoName, bool isStatic, bool isExtended)
+	{
+		return (entryName == nullptr) ? (isAnyAlgoExtended == isExtended) : (isStatic && (algoName == entryName));
+	}
+
+	StaticAlgoRegistry::GameRunnerFuncType StaticAlgoRegistry::gameRunnerFor(const AlgoLoader& algoLoader,
+																			 const string& playerAName,
+																			 const string& playerBName)
+	{
+		bool isPlayerAStatic = isStaticAlgo(algoLoader, playerAName);
+		bool isPlayerBStatic = isStaticAlgo(algoLoader, playerBName);
+
+		if (isPlayerAStatic || isPlayerBStatic)
+		{
+			// Extended algorithms must be played through their batched calls, even against a compiled-in algorithm
+			bool isPlayerAExtended = algoLoader.isExtendedAlgorithm(playerAName);
+			bool isPlayerBExtended = algoLoader.isExtendedAlgorithm(playerBName);
+
+			for (const auto& entry : GAME_RUNNERS)
+			{
+				if (isMatchingName(entry.playerAName, entry.isAnyAlgoExtended, playerAName, isPlayerAStatic,
+								   isPlayerAExtended) &&
+					isMatchingName(entry.playerBName, entry.isAnyAlgoExtended, playerBName, isPlayerBStatic,
+								   isPlayerBExtended))
+				{
+					return entry.gameRunner;
+				}
+			}
+		}
+
+		// Both players are only known by their interface
+		return &GameManager::runGame;
+	}
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <memory>
+#include "AlgoLoader.h"
+#include "GameManager.h"
+#include "BatchedAlgoAdapter.h"
+
+using std::shared_ptr;
+using std::unique_ptr;
+using std::string;
+
+namespace battleship
+{
+	/** A player of a typed game loop, as the loop calls it: compiled-in algorithms (and algorithms only known by
+	 *  IBattleshipGameAlgo) are called on the instance itself.
+	 */
+	template <typename Algo>
+	class TypedPlayer
+	{
+	public:
+		explicit TypedPlayer(IBattleshipGameAlgo* algo) : _algo(*static_cast<Algo*>(algo)) {}
+
+		Algo& algo() { return _algo; }
+
+	private:
+		Algo& _algo;
+	};
+
+	/** Algorithms that implement IBattleshipGameAlgoEx are called through a BatchedAlgoAdapter, so their attack()
+	 *  and notifyOnAttackResult() are never called.
+	 */
+	template <>
+	class TypedPlayer<BatchedAlgoAdapter>
+	{
+	public:
+		explicit TypedPlayer(IBattleshipGameAlgo* algo) : _adapter(*static_cast<IBattleshipGameAlgoEx*>(algo)) {}
+
+		BatchedAlgoAdapter& algo() { return _adapter; }
+
+	private:
+		BatchedAlgoAdapter _adapter;
+	};
+
+	/** Registry of the algorithms that are compiled into the game executable (in addition to being built as dlls).
+	 *  Games between two compiled-in algorithms run a GameManager game loop that is instantiated with the
+	 *  algorithms' concrete types, so the calls to the algorithms don't go through the IBattleshipGameAlgo vtable.
+	 *  This is a fast mode for research sweeps between in-house algorithms.
+	 */
+	class StaticAlgoRegistry
+	{
+	public:
+		virtual ~StaticAlgoRegistry() = delete; // Shouldn't be instantiated / destroyed (stateless class)
+
+		using GameRunnerFuncType = GameManager::GameRunnerFuncType;
+
+		/** Registers all compiled-in algorithms with the algorithm loader.
+		 *  Algorithms whose name is already taken (e.g. by a dll) are skipped.
+		 *  Returns the number of algorithms registered.
+		 */
+		static int registerAll(AlgoLoader& algoLoader);
+
+		/** Returns the game loop for a game between the given players.
+		 *  If both players were registered by registerAll, a game loop typed for both algorithms is returned.
+		 *  If only one of them was, the game loop is typed for that player. The other is called through its interface,
+		 *  or through a BatchedAlgoAdapter if it implements IBattleshipGameAlgoEx.
+		 *  Otherwise GameManager::runGame is returned.
+		 */
+		static GameRunnerFuncType gameRunnerFor(const AlgoLoader& algoLoader,
+												const string& playerAName, const string& playerBName);
+
+	private:
+		/** Hide the ctor - this class is stateless */
+		StaticAlgoRegistry();
+
+		/** A compiled-in algorithm and the name it is registered under */
+		struct StaticAlgoEntry
+		{
+			const char* name;
+			AlgoLoader::GetAlgorithmFuncType algoFunc;
+		};
+
+		/** A typed game loop for a pair of algorithms. A NULL name stands for any algorithm (called through its
+		 *  interface): any extended algorithm or any other algorithm, as isAnyAlgoExtended says.
+		 */
+		struct GameRunnerEntry
+		{
+			const char* playerAName;
+			const char* playerBName;
+			bool isAnyAlgoExtended;
+			GameRunnerFuncType gameRunner;
+		};
+
+		/** All algorithms compiled into the executable */
+		static const StaticAlgoEntry STATIC_ALGOS[];
+
+		/** Typed game loops: one for each (ordered) pair of STATIC_ALGOS, and four for each algorithm against any other
+		 *  (on either side, extended or not)
+		 */
+		static const GameRunnerEntry GAME_RUNNERS[];
+
+		/** Returns true if the entry's name matches the player (a NULL name matches any player whose extension
+		 *  matches the entry's)
+		 */
+		static bool isMatchingName(const char* entryName, bool isAnyAlgoExtended,
+								   const string& algoName, bool isStatic, bool isExtended);
+
+		/** Returns true if the algorithm is loaded under the given name as the compiled-in algorithm (and not a dll) */
+		static bool isStaticAlgo(const AlgoLoader& algoLoader, const string& algoName);
+
+		/** Game loop instantiated for a pair of compiled-in algorithm types (or IBattleshipGameAlgo and
+		 *  BatchedAlgoAdapter for a player that isn't compiled-in, see TypedPlayer).
+		 *  The players must be instances created by the algorithms' registered functions.
+		 */
+		template <typename PlayerAAlgo, typename PlayerBAlgo>
+		static GameResults runStaticGame(shared_ptr<BattleBoard> board,
+										 IBattleshipGameAlgo* playerA,
+										 IBattleshipGameAlgo* playerB,
+										 const BoardData& playerAView,
+										 const BoardData& playerBView)
+		{
+			TypedPlayer<PlayerAAlgo> typedPlayerA(playerA);
+			TypedPlayer<PlayerBAlgo> typedPlayerB(playerB);
+			return GameManager::runTypedGame(board, typedPlayerA.algo(), typedPlayerB.algo(), playerAView, playerBView);
+		}
+	};
+}
@@ -0,0 +1,95 @@
+#include "SwissScheduler.h"
+#include "Logger.h"
+#include <algorithm>
+
+namespace battleship
+{
+	SwissScheduler::SwissScheduler(const vector<string>& players, const vector<string>& boards,
+								   vector<size_t> boardsOrder, Scoreboard& scoreboard) :
+		StagedTournamentScheduler(players, boards, std::move(boardsOrder), scoreboard),
+		_roundsCount(roundsCount(players.size())),
+		_pairedRoundsCount(0),
+		_havePlayed(players.size() * players.size(), false),
+		_hadBye(players.size(), false)
+	{
+	}
+
+	size_t SwissScheduler::roundsCount(size_t playersCount)
+	{
+		// Enough rounds for a single player to win all of its matches (as in a knockout bracket)
+		size_t rounds = 0;
+		while ((static_cast<size_t>(1) << rounds) < playersCount)
+			rounds++;
+
+		return rounds;
+	}
+
+	size_t SwissScheduler::unpairedMatchesCount(size_t) const
+	{
+		return (_roundsCount - _pairedRoundsCount) * (playersCount() / 2);
+	}
+
+	vector<pair<size_t, size_t>> SwissScheduler::pairNextRound(const vector<Match>&)
+	{
+		vector<pair<size_t, size_t>> pairings;
+		if (_pairedRoundsCount == _roundsCount)
+			return pairings;
+
+		size_t players = playersCount();
+		vector<size_t> ranking = rankedPlayers();
+
+		// The lowest ranked player without a bye sits out, so everyone else can be paired
+		if (players % 2 == 1)
+		{
+			auto byeIt = std::find_if(ranking.rbegin(), ranking.rend(), [this](size_t player) { return !_hadBye[player]; });
+			if (byeIt == ranking.rend())
+				byeIt = ranking.rbegin();
+
+			_hadBye[*byeIt] = true;
+			ranking.erase(std::next(byeIt).base());
+		}
+
+		// Pair the best unpaired player with the next best player it hasn't met.
+		// If it met all of them, it plays the next best player again.
+		vector<bool> isPaired(players, false);
+		for (size_t rank = 0; rank < ranking.size(); rank++)
+		{
+			size_t player1 = ranking[rank];
+			if (isPaired[player1])
+				continue;
+
+			size_t opponentRank = ranking.size();
+			for (size_t nextRank = rank + 1; nextRank < ranking.size(); nextRank++)
+			{
+				size_t player2 = ranking[nextRank];
+				if (isPaired[player2])
+					continue;
+
+				if (opponentRank == ranking.size())
+					opponentRank = nextRank;
+
+				if (!_havePlayed[player1 * players + player2])
+				{
+					opponentRank = nextRank;
+					break;
+				}
+			}
+
+			if (opponentRank == ranking.size())
+				break;
+
+			size_t player2 = ranking[opponentRank];
+			isPaired[player1] = true;
+			isPaired[player2] = true;
+			_havePlayed[player1 * players + player2] = true;
+			_havePlayed[player2 * players + player1] = true;
+			pairings.push_back(std::make_pair(player1, player2));
+		}
+
+		_pairedRoundsCount++;
+		Logger::getInstance().log(Severity::INFO_LEVEL, "Swiss round " + std::to_string(_pairedRoundsCount) + "/" +
+								  std::to_string(_roundsCount) + " paired by current standings.");
+
+		return pairings;
+	}
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+#include "StagedTournamentScheduler.h"
+
+using std::vector;
+
+namespace battleship
+{
+	/** Swiss-system tournament: in every round each player plays a match against a player with a similar standing,
+	 *  without meeting the same opponent twice when possible.
+	 *  Players are paired by their live scoreboard standing (so by the scoreboard's rating system): the best
+	 *  unpaired player plays the next best player it hasn't played yet. With an odd number of players, the lowest
+	 *  ranked player that didn't sit out a round yet sits out (a bye is neither a win nor a game played).
+	 *  The tournament is played for ceil(log2(players)) rounds, which is O(players * log(players)) games in total
+	 *  instead of the round robin's O(players^2).
+	 */
+	class SwissScheduler : public StagedTournamentScheduler
+	{
+	public:
+		SwissScheduler(const vector<string>& players, const vector<string>& boards, vector<size_t> boardsOrder,
+					   Scoreboard& scoreboard);
+		virtual ~SwissScheduler() = default;
+
+		/** Number of rounds in a Swiss tournament between the given number of players */
+		static size_t roundsCount(size_t playersCount);
+
+	protected:
+		vector<pair<size_t, size_t>> pairNextRound(const vector<Match>& finishedMatches) override;
+		size_t unpairedMatchesCount(size_t currentRoundMatchesCount) const override;
+
+	private:
+		/** Number of rounds in the tournament, and number of rounds paired so far */
+		size_t _roundsCount;
+		size_t _pairedRoundsCount;
+
+		/** Pairs of players that already played a match, indexed by player1 * players + player2 */
+		vector<bool> _havePlayed;
+
+		/** Players that already sat out a round */
+		vector<bool> _hadBye;
+	};
+}
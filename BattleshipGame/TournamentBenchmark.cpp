@@ -0,0 +1,494 @@
+#include "TournamentBenchmark.h"
+#include "BenchmarkAlgos.h"
+#include "CompetitionManager.h"
+#include "RandomBoardGenerator.h"
+#include "LockstepGameEngine.h"
+#include "BoardDataImpl.h"
+#include "HuntTargetAlgo.h"
+#include "IOUtil.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <cmath>
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::setw;
+using std::setprecision;
+using std::fixed;
+using std::left;
+using std::to_string;
+using std::ofstream;
+using std::stringstream;
+using std::mutex;
+using std::lock_guard;
+using std::chrono::steady_clock;
+using std::chrono::duration;
+
+namespace battleship
+{
+	TournamentBenchmarkConfig::TournamentBenchmarkConfig() :
+		playersCount(4),
+		boardsCount(8),
+		boardSize("10x10x1"),
+		seed(0),
+		repetitions(3),
+		threadCounts({ 1, 2, 4, 8 }),
+		outputFile("benchmark.json"),
+		logSeverity(Severity::WARNING_LEVEL),
+		lockstepGames(0),
+		scanHelperThreads(0),
+		scanBoardEdge(15)
+	{
+	}
+
+	bool TournamentBenchmarkConfig::parseArgs(int argc, char* argv[], string& error)
+	{
+		const string usage = " Try: BattleshipBenchmark [-threads <#count,#count,..>] [-players <#count>] "
+							 "[-boards <#count>] [-size <cols>x<rows>x<depth>] [-seed <#seed>] "
+							 "[-repeat <#count>] [-lockstep <#games per board>] [-scan <#helper threads>] "
+							 "[-scanEdge <#edge>] [-output <file>]";
+
+		for (int i = 1; i < argc; i++)
+		{
+			string arg = argv[i];
+			if (i + 1 >= argc)
+			{
+				error = "Error: Argument " + arg + " is missing its value." + usage;
+				return false;
+			}
+
+			string value = argv[++i];
+
+			if (arg == "-threads")
+			{
+				// Comma separated list of thread counts
+				threadCounts.clear();
+				stringstream ss(value);
+				string token;
+				while (std::getline(ss, token, ','))
+				{
+					if (!IOUtil::isInteger(token) || (std::stoi(token) < 1))
+					{
+						error = "Error: Illegal thread count " + token + "." + usage;
+						return false;
+					}
+					threadCounts.push_back(std::stoi(token));
+				}
+			}
+			else if (arg == "-size")
+			{
+				boardSize = value;
+			}
+			else if (arg == "-output")
+			{
+				outputFile = value;
+			}
+			else if ((arg == "-players") || (arg == "-boards") || (arg == "-seed") || (arg == "-repeat") ||
+					 (arg == "-lockstep") || (arg == "-scan") || (arg == "-scanEdge"))
+			{
+				int minVal = (arg == "-players") ? 2 :
+							 (((arg == "-seed") || (arg == "-lockstep") || (arg == "-scan")) ? 0 : 1);
+				if (!IOUtil::isInteger(value) || (std::stoi(value) < minVal))
+				{
+					error = "Error: Illegal " + arg + " value " + value + "." + usage;
+					return false;
+				}
+
+				int intValue = std::stoi(value);
+				if (arg == "-players")
+					playersCount = intValue;
+				else if (arg == "-boards")
+					boardsCount = intValue;
+				else if (arg == "-seed")
+					seed = static_cast<unsigned int>(intValue);
+				else if (arg == "-lockstep")
+					lockstepGames = intValue;
+				else if (arg == "-scan")
+					scanHelperThreads = intValue;
+				else if (arg == "-scanEdge")
+					scanBoardEdge = intValue;
+				else
+					repetitions = intValue;
+			}
+			else
+			{
+				error = "Error: Unknown argument " + arg + "." + usage;
+				return false;
+			}
+		}
+
+		if (threadCounts.empty())
+		{
+			error = "Error: No thread counts given." + usage;
+			return false;
+		}
+
+		return true;
+	}
+
+	TournamentBenchmark::TournamentBenchmark(const TournamentBenchmarkConfig& config) : _config(config)
+	{
+	}
+
+	bool TournamentBenchmark::prepareResources()
+	{
+		const string absolutePath = IOUtil::convertPathToAbsolute(".");
+		_boardFactory = std::make_shared<BattleshipGameBoardFactory>(absolutePath);
+		_algoLoader = std::make_shared<AlgoLoader>(absolutePath);
+
+		// Alternate between the synthetic algorithms, so games aren't all mirror matches
+		for (int playerIndex = 1; playerIndex <= _config.playersCount; playerIndex++)
+		{
+			bool isSequential = (playerIndex % 2 == 1);
+			string name = (isSequential ? "SequentialScan_" : "RandomShot_") + to_string(playerIndex);
+			auto algoFunc = isSequential ? &SequentialScanAlgo::create : &RandomShotAlgo::create;
+			_algoLoader->registerStaticAlgorithm(name, algoFunc);
+		}
+
+		int rows = 0;
+		int cols = 0;
+		int depth = 0;
+		if (!BattleshipGameBoardFactory::parseDimensions(_config.boardSize, rows, cols, depth) ||
+			(rows < 1) || (cols < 1) || (depth < 1))
+		{
+			cerr << "Error: Invalid board size " << _config.boardSize << " (expected [cols]x[rows]x[depth])" << endl;
+			return false;
+		}
+
+		RandomBoardSpec spec(cols, rows, depth, RandomBoardSpec::defaultShipMix());
+		auto boards = _boardFactory->generateRandomBattleBoards(spec, _config.boardsCount, _config.seed);
+		if (boards.size() != static_cast<size_t>(_config.boardsCount))
+		{
+			cerr << "Error: Failed to generate " << _config.boardsCount << " boards of size " << _config.boardSize << endl;
+			return false;
+		}
+
+		return true;
+	}
+
+	long long TournamentBenchmark::percentile(const vector<long long>& sortedValues, double p)
+	{
+		if (sortedValues.empty())
+			return 0;
+
+		// Nearest rank percentile
+		size_t rank = static_cast<size_t>(std::ceil(p * sortedValues.size()));
+		return sortedValues[(rank > 0) ? (rank - 1) : 0];
+	}
+
+	TournamentBenchmarkResult TournamentBenchmark::measure(int threads) const
+	{
+		vector<long long> gameDurations;
+		long long moves = 0;
+		mutex resultsLock;
+		double wallSeconds = 0;
+
+		for (int repetition = 0; repetition < _config.repetitions; repetition++)
+		{
+			CompetitionManager competitionMgr(_boardFactory, _algoLoader, threads);
+			competitionMgr.scoreboard().setConsoleOutput(false);
+			competitionMgr.scoreboard().addGameResultsListener(
+				[&gameDurations, &moves, &resultsLock](const GameResults& results, const string&,
+													   const string&, const string&)
+			{
+				lock_guard<mutex> lock(resultsLock);
+				gameDurations.push_back(results.durationMicros);
+				moves += results.moves;
+			});
+
+			auto startTime = steady_clock::now();
+			competitionMgr.run();
+			wallSeconds += duration<double>(steady_clock::now() - startTime).count();
+		}
+
+		std::sort(gameDurations.begin(), gameDurations.end());
+
+		TournamentBenchmarkResult result;
+		result.threads = threads;
+		result.games = gameDurations.size();
+		result.moves = moves;
+		result.wallSeconds = wallSeconds;
+		result.gamesPerSec = (wallSeconds > 0) ? (result.games / wallSeconds) : 0;
+		result.movesPerSec = (wallSeconds > 0) ? (result.moves / wallSeconds) : 0;
+		result.p50GameMillis = percentile(gameDurations, 0.5) / 1000.0;
+		result.p99GameMillis = percentile(gameDurations, 0.99) / 1000.0;
+		result.scalingEfficiency = 1.0; // Set relatively to the baseline once all thread counts are measured
+		return result;
+	}
+
+	bool TournamentBenchmark::isSameResults(const GameResults& results1, const GameResults& results2)
+	{
+		return (results1.winner == results2.winner) && (results1.playerAPoints == results2.playerAPoints) &&
+			   (results1.playerBPoints == results2.playerBPoints) && (results1.moves == results2.moves);
+	}
+
+	LockstepBenchmarkResult TournamentBenchmark::measureLockstep() const
+	{
+		const int gamesPerBoard = _config.lockstepGames;
+
+		// A player instance per game, as the lockstep games are all played at once
+		vector<unique_ptr<IBattleshipGameAlgo>> algos;
+		vector<SequentialScanAlgo*> playersA;
+		vector<RandomShotAlgo*> playersB;
+		for (int game = 0; game < gamesPerBoard; game++)
+		{
+			playersA.push_back(static_cast<SequentialScanAlgo*>(SequentialScanAlgo::create()));
+			algos.emplace_back(playersA.back());
+			playersB.push_back(static_cast<RandomShotAlgo*>(RandomShotAlgo::create()));
+			algos.emplace_back(playersB.back());
+		}
+
+		const auto& boardNames = _boardFactory->loadedBoardsList();
+		vector<GameResults> sequentialResults;
+		vector<GameResults> lockstepResults;
+		double sequentialSeconds = 0;
+		double lockstepSeconds = 0;
+
+		for (int repetition = 0; repetition < _config.repetitions; repetition++)
+		{
+			sequentialResults.clear();
+			lockstepResults.clear();
+
+			auto startTime = steady_clock::now();
+			for (const auto& boardName : boardNames)
+			{
+				auto playerAView = _boardFactory->requestPlayerView(boardName, PlayerEnum::A);
+				auto playerBView = _boardFactory->requestPlayerView(boardName, PlayerEnum::B);
+				for (int game = 0; game < gamesPerBoard; game++)
+				{
+					auto results = GameManager::runTypedGame(_boardFactory->requestBattleboard(boardName),
+															 *playersA[game], *playersB[game],
+															 *playerAView, *playerBView);
+					sequentialResults.push_back(results);
+				}
+			}
+			sequentialSeconds += duration<double>(steady_clock::now() - startTime).count();
+
+			startTime = steady_clock::now();
+			for (const auto& boardName : boardNames)
+			{
+				auto playerAView = _boardFactory->requestPlayerView(boardName, PlayerEnum::A);
+				auto playerBView = _boardFactory->requestPlayerView(boardName, PlayerEnum::B);
+				LockstepGameEngine engine(*_boardFactory->requestBattleboard(boardName));
+				auto results = engine.runGames(playersA, playersB, *playerAView, *playerBView);
+				lockstepResults.insert(lockstepResults.end(), results.begin(), results.end());
+			}
+			lockstepSeconds += duration<double>(steady_clock::now() - startTime).count();
+		}
+
+		LockstepBenchmarkResult result;
+		result.gamesPerBoard = gamesPerBoard;
+		result.games = sequentialResults.size() * _config.repetitions;
+		result.sequentialGamesPerSec = (sequentialSeconds > 0) ? (result.games / sequentialSeconds) : 0;
+		result.lockstepGamesPerSec = (lockstepSeconds > 0) ? (result.games / lockstepSeconds) : 0;
+		result.speedup = (result.sequentialGamesPerSec > 0) ?
+						 (result.lockstepGamesPerSec / result.sequentialGamesPerSec) : 0;
+		result.isMatching = std::equal(sequentialResults.begin(), sequentialResults.end(),
+									   lockstepResults.begin(), lockstepResults.end(), &isSameResults);
+		return result;
+	}
+
+	bool TournamentBenchmark::measureParallelScan(ParallelScanBenchmarkResult& result) const
+	{
+		const int edge = _config.scanBoardEdge;
+		RandomBoardGenerator generator(RandomBoardSpec(edge, edge, edge, RandomBoardSpec::defaultShipMix()), _config.seed);
+		auto board = generator.generate();
+		if (board == nullptr)
+			return false;
+
+		BoardDataImpl playerView(PlayerEnum::A, *board);
+		LayerTaskPool helperThreads(_config.scanHelperThreads, 0);	// Split the board whatever its size
+
+		HuntTargetAlgo serialAlgo;
+		HuntTargetAlgo parallelAlgo;
+		parallelAlgo.setLayerTaskRunner(&helperThreads);
+		serialAlgo.setPlayer(0);
+		parallelAlgo.setPlayer(0);
+
+		// Warm up, which also starts the helper threads
+		serialAlgo.setBoard(playerView);
+		parallelAlgo.setBoard(playerView);
+
+		const int scansCount = SCAN_BOARDS_PER_REPETITION * _config.repetitions;
+		auto measureScans = [&playerView, scansCount](HuntTargetAlgo& algo)
+		{
+			auto startTime = steady_clock::now();
+			for (int scan = 0; scan < scansCount; scan++)
+				algo.setBoard(playerView);
+
+			return duration<double, std::milli>(steady_clock::now() - startTime).count() / scansCount;
+		};
+
+		result.helperThreads = _config.scanHelperThreads;
+		result.boardEdge = edge;
+		result.serialMillis = measureScans(serialAlgo);
+		result.parallelMillis = measureScans(parallelAlgo);
+		result.speedup = (result.parallelMillis > 0) ? (result.serialMillis / result.parallelMillis) : 0;
+		return true;
+	}
+
+	void TournamentBenchmark::printResults(const vector<TournamentBenchmarkResult>& results) const
+	{
+		cout << left << setw(10) << "Threads"
+			 << setw(10) << "Games"
+			 << setw(14) << "Games/sec"
+			 << setw(16) << "Moves/sec"
+			 << setw(12) << "p50 (ms)"
+			 << setw(12) << "p99 (ms)"
+			 << setw(12) << "Efficiency" << endl;
+
+		for (const auto& result : results)
+		{
+			cout << left << setw(10) << result.threads
+				 << setw(10) << result.games
+				 << setw(14) << setprecision(1) << fixed << result.gamesPerSec
+				 << setw(16) << setprecision(0) << fixed << result.movesPerSec
+				 << setw(12) << setprecision(3) << fixed << result.p50GameMillis
+				 << setw(12) << setprecision(3) << fixed << result.p99GameMillis
+				 << setw(12) << setprecision(2) << fixed << result.scalingEfficiency << endl;
+		}
+	}
+
+	void TournamentBenchmark::printLockstepResult(const LockstepBenchmarkResult& result) const
+	{
+		cout << endl << "Self-play, " << result.gamesPerBoard << " games per board (" << result.games << " games):" << endl
+			 << left << setw(24) << "  GameManager" << setprecision(1) << fixed << result.sequentialGamesPerSec
+			 << " games/sec" << endl
+			 << left << setw(24) << "  LockstepGameEngine" << setprecision(1) << fixed << result.lockstepGamesPerSec
+			 << " games/sec (x" << setprecision(2) << result.speedup << ")" << endl;
+
+		if (!result.isMatching)
+			cerr << "Error: Lockstep games results differ from the GameManager games results" << endl;
+	}
+
+	void TournamentBenchmark::printParallelScanResult(const ParallelScanBenchmarkResult& result) const
+	{
+		cout << endl << "HuntTargetAlgo board scan, " << result.boardEdge << "x" << result.boardEdge << "x"
+			 << result.boardEdge << " board:" << endl
+			 << left << setw(24) << "  Serial" << setprecision(3) << fixed << result.serialMillis << " ms" << endl
+			 << left << setw(24) << ("  " + to_string(result.helperThreads) + " helper threads") << setprecision(3)
+			 << fixed << result.parallelMillis << " ms (x" << setprecision(2) << result.speedup << ")" << endl;
+	}
+
+	bool TournamentBenchmark::writeJson(const vector<TournamentBenchmarkResult>& results,
+										const LockstepBenchmarkResult& lockstepResult,
+										const ParallelScanBenchmarkResult& scanResult) const
+	{
+		ofstream fs(_config.outputFile, std::ofstream::out | std::ofstream::trunc);
+		if (!fs.is_open())
+			return false;
+
+		fs << "{" << endl
+		   << "  \"benchmark\": \"tournament\"," << endl
+		   << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << "," << endl
+		   << "  \"players\": " << _config.playersCount << "," << endl
+		   << "  \"boards\": " << _config.boardsCount << "," << endl
+		   << "  \"board_size\": \"" << _config.boardSize << "\"," << endl
+		   << "  \"seed\": " << _config.seed << "," << endl
+		   << "  \"repetitions\": " << _config.repetitions << "," << endl
+		   << "  \"runs\": [" << endl;
+
+		for (size_t i = 0; i < results.size(); i++)
+		{
+			const auto& result = results[i];
+			fs << "    { \"threads\": " << result.threads
+			   << ", \"games\": " << result.games
+			   << ", \"moves\": " << result.moves
+			   << ", \"wall_seconds\": " << setprecision(6) << fixed << result.wallSeconds
+			   << ", \"games_per_sec\": " << setprecision(3) << result.gamesPerSec
+			   << ", \"moves_per_sec\": " << result.movesPerSec
+			   << ", \"p50_game_ms\": " << result.p50GameMillis
+			   << ", \"p99_game_ms\": " << result.p99GameMillis
+			   << ", \"scaling_efficiency\": " << result.scalingEfficiency
+			   << " }" << ((i + 1 < results.size()) ? "," : "") << endl;
+		}
+
+		fs << "  ]";
+		if (_config.lockstepGames > 0)
+		{
+			fs << "," << endl
+			   << "  \"lockstep\": { \"games_per_board\": " << lockstepResult.gamesPerBoard
+			   << ", \"games\": " << lockstepResult.games
+			   << ", \"sequential_games_per_sec\": " << setprecision(3) << fixed << lockstepResult.sequentialGamesPerSec
+			   << ", \"lockstep_games_per_sec\": " << lockstepResult.lockstepGamesPerSec
+			   << ", \"speedup\": " << lockstepResult.speedup
+			   << ", \"matching\": " << (lockstepResult.isMatching ? "true" : "false") << " }";
+		}
+
+		if (_config.scanHelperThreads > 0)
+		{
+			fs << "," << endl
+			   << "  \"parallel_scan\": { \"helper_threads\": " << scanResult.helperThreads
+			   << ", \"board_edge\": " << scanResult.boardEdge
+			   << ", \"serial_ms\": " << setprecision(3) << fixed << scanResult.serialMillis
+			   << ", \"parallel_ms\": " << scanResult.parallelMillis
+			   << ", \"speedup\": " << scanResult.speedup << " }";
+		}
+
+		fs << endl << "}" << endl;
+		return fs.good();
+	}
+
+	int TournamentBenchmark::run()
+	{
+		Logger::getInstance().setPath(IOUtil::convertPathToAbsolute("."))->setLevel(_config.logSeverity);
+
+		if (!prepareResources())
+			return ERROR_CODE;
+
+		cout << "Tournament benchmark: " << _config.playersCount << " players, " << _config.boardsCount
+			 << " boards of size " << _config.boardSize << ", " << _config.repetitions
+			 << " competitions per thread count" << endl << endl;
+
+		vector<TournamentBenchmarkResult> results;
+		for (int threads : _config.threadCounts)
+		{
+			results.push_back(measure(threads));
+		}
+
+		// Efficiency is the speedup over the baseline (first thread count) per added thread
+		const auto& baseline = results.front();
+		for (auto& result : results)
+		{
+			double speedup = (baseline.gamesPerSec > 0) ? (result.gamesPerSec / baseline.gamesPerSec) : 0;
+			result.scalingEfficiency = speedup * baseline.threads / result.threads;
+		}
+
+		printResults(results);
+
+		LockstepBenchmarkResult lockstepResult = LockstepBenchmarkResult();
+		if (_config.lockstepGames > 0)
+		{
+			lockstepResult = measureLockstep();
+			printLockstepResult(lockstepResult);
+		}
+
+		ParallelScanBenchmarkResult scanResult = ParallelScanBenchmarkResult();
+		if (_config.scanHelperThreads > 0)
+		{
+			if (!measureParallelScan(scanResult))
+			{
+				cerr << "Error: Failed to generate a board for the parallel scan comparison" << endl;
+				return ERROR_CODE;
+			}
+
+			printParallelScanResult(scanResult);
+		}
+
+		if (!writeJson(results, lockstepResult, scanResult))
+		{
+			cerr << "Error: Failed to write benchmark results to " << _config.outputFile << endl;
+			return ERROR_CODE;
+		}
+
+		cout << endl << "Results written to " << _config.outputFile << endl;
+		return SUCCESS_CODE;
+	}
+}
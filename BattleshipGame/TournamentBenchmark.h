@@ -0,0 +1,146 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "BattleshipGameBoardFactory.h"
+#include "AlgoLoader.h"
+#include "Logger.h"
+#include "GameManager.h"
+
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+namespace battleship
+{
+	/** Parameters of a tournament benchmark run */
+	struct TournamentBenchmarkConfig
+	{
+		int playersCount;			// Number of synthetic players in the competition
+		int boardsCount;			// Number of generated boards in the competition
+		string boardSize;			// Dimensions of the generated boards: [cols]x[rows]x[depth]
+		unsigned int seed;			// Seed of the generated boards
+		int repetitions;			// Number of competitions measured for each thread count
+		vector<int> threadCounts;	// Worker thread counts to measure, the first one is the scaling baseline
+		string outputFile;			// JSON results file
+		Severity logSeverity;		// Severity filter of the game log written during the benchmark
+		int lockstepGames;			// Games per board of the lockstep self-play comparison (0 to skip it)
+		int scanHelperThreads;		// Helper threads of the parallel board scan comparison (0 to skip it)
+		int scanBoardEdge;			// Edge of the cube board of the parallel board scan comparison
+
+		/** Creates the default benchmark configuration */
+		TournamentBenchmarkConfig();
+
+		/** Overrides the configuration with the command line arguments.
+		 *  Returns false and sets error if the command line is illegal.
+		 */
+		bool parseArgs(int argc, char* argv[], string& error);
+	};
+
+	/** Measurements of the competitions run with a single thread count */
+	struct TournamentBenchmarkResult
+	{
+		int threads;
+		size_t games;
+		long long moves;
+		double wallSeconds;
+		double gamesPerSec;
+		double movesPerSec;
+		double p50GameMillis;
+		double p99GameMillis;
+		double scalingEfficiency;	// Speedup over the baseline thread count, divided by the added threads ratio
+	};
+
+	/** Measurements of a self-play sweep played game by game (GameManager) and in lockstep (LockstepGameEngine) */
+	struct LockstepBenchmarkResult
+	{
+		int gamesPerBoard;
+		size_t games;
+		double sequentialGamesPerSec;
+		double lockstepGamesPerSec;
+		double speedup;
+		bool isMatching;			// Whether both engines produced the same results for every game
+	};
+
+	/** Measurements of HuntTargetAlgo's board scan on a huge board, serially and split between helper threads */
+	struct ParallelScanBenchmarkResult
+	{
+		int helperThreads;
+		int boardEdge;				// The board is a cube of this edge
+		double serialMillis;		// Average setBoard time without helper threads
+		double parallelMillis;		// Average setBoard time with the helper threads
+		double speedup;
+	};
+
+	/** Runs full competitions (CompetitionManager) between synthetic algorithms on generated boards,
+	 *  at several worker thread counts, and reports throughput, game latency and scaling efficiency.
+	 *  The results are printed and written as JSON so they can be compared between releases.
+	 */
+	class TournamentBenchmark
+	{
+	public:
+		TournamentBenchmark(const TournamentBenchmarkConfig& config);
+		virtual ~TournamentBenchmark() = default;
+
+		TournamentBenchmark(TournamentBenchmark const&) = delete;	// Disable copying
+		TournamentBenchmark& operator=(TournamentBenchmark const&) = delete;	// Disable copying (assignment)
+
+		/** Runs the benchmark. Returns SUCCESS_CODE or ERROR_CODE. */
+		int run();
+
+		/** Success return code for app */
+		static constexpr int SUCCESS_CODE = 0;
+
+		/** Error return code for app */
+		static constexpr int ERROR_CODE = -1;
+
+	private:
+		TournamentBenchmarkConfig _config;
+
+		/** Loaders shared by all competitions of the benchmark */
+		shared_ptr<BattleshipGameBoardFactory> _boardFactory;
+		shared_ptr<AlgoLoader> _algoLoader;
+
+		/** Registers the synthetic players and generates the boards */
+		bool prepareResources();
+
+		/** Runs the configured number of competitions with the given thread count and measures them */
+		TournamentBenchmarkResult measure(int threads) const;
+
+		/** Plays the configured number of self-play games on every board, once game by game and once in lockstep,
+		 *  and measures both
+		 */
+		LockstepBenchmarkResult measureLockstep() const;
+
+		/** Measures HuntTargetAlgo's setBoard on a generated cube board of the configured edge, once without helper
+		 *  threads and once split between the configured number of helper threads (whatever the board's size).
+		 *  Returns false if the board couldn't be generated.
+		 */
+		bool measureParallelScan(ParallelScanBenchmarkResult& result) const;
+
+		/** Prints the results table to the console */
+		void printResults(const vector<TournamentBenchmarkResult>& results) const;
+
+		/** Prints the lockstep comparison to the console */
+		void printLockstepResult(const LockstepBenchmarkResult& result) const;
+
+		/** Prints the parallel scan comparison to the console */
+		void printParallelScanResult(const ParallelScanBenchmarkResult& result) const;
+
+		/** Writes the results to the JSON output file (the lockstep and parallel scan results only if they were
+		 *  measured). Returns false on IO errors.
+		 */
+		bool writeJson(const vector<TournamentBenchmarkResult>& results, const LockstepBenchmarkResult& lockstepResult,
+					   const ParallelScanBenchmarkResult& scanResult) const;
+
+		/** Returns true if both games have the same winner, points and moves */
+		static bool isSameResults(const GameResults& results1, const GameResults& results2);
+
+		/** Number of times each algorithm's setBoard is measured per repetition of the parallel scan comparison */
+		static constexpr int SCAN_BOARDS_PER_REPETITION = 20;
+
+		/** Returns the p-th percentile (0..1) of the sorted values */
+		static long long percentile(const vector<long long>& sortedValues, double p);
+	};
+}
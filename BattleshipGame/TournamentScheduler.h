@@ -0,0 +1,47 @@
+#pragma once
+
+#include <memory>
+#include "SingleGameTask.h"
+
+using std::unique_ptr;
+
+namespace battleship
+{
+	/** Formats of a competition: which games are played, and in which order */
+	enum class TournamentFormat : int
+	{
+		ROUND_ROBIN = 0,		// Every player plays twice against each other player on each board (see GameTaskCursor)
+		SWISS = 1,				// Players are paired by their current standing for log2(players) rounds (see SwissScheduler)
+		SINGLE_ELIMINATION = 2,	// Knockout bracket, a player is out after losing a match (see EliminationScheduler)
+		DOUBLE_ELIMINATION = 3	// Knockout bracket, a player is out after losing two matches (see EliminationScheduler)
+	};
+
+	/** Deals the games of a competition in a given tournament format to the worker threads.
+	 *  Formats whose pairings depend on earlier results (e.g. Swiss) generate their games round by round, and are
+	 *  told about each game's results by the worker that played it.
+	 */
+	class TournamentScheduler
+	{
+	public:
+		virtual ~TournamentScheduler() = default;
+
+		/** Number of games left to play (games already dealt included).
+		 *  For formats whose games depend on the results this is an upper bound.
+		 */
+		virtual size_t pendingGamesCount() const = 0;
+
+		/** Returns true if no more games will be dealt (games may still be running) */
+		virtual bool isExhausted() const = 0;
+
+		/** Deals the next game, or NULL if there are no more games.
+		 *  May block until games that were already dealt are finished, if the next games depend on their results.
+		 *  This method is thread safe.
+		 */
+		virtual unique_ptr<SingleGameTask> next() = 0;
+
+		/** Called by the worker thread that played a dealt game, after the scoreboard was updated with the results.
+		 *  This method is thread safe.
+		 */
+		virtual void onGameFinished(const SingleGameTask& task, const GameResults& results) = 0;
+	};
+}
@@ -0,0 +1,178 @@
+#include "WorkerStats.h"
+#include "IOUtil.h"
+#include "Logger.h"
+#include <fstream>
+
+using std::ofstream;
+using std::endl;
+using std::lock_guard;
+using std::unique_lock;
+using std::memory_order_relaxed;
+using std::chrono::duration_cast;
+using std::chrono::milliseconds;
+
+namespace battleship
+{
+	WorkerStats::WorkerStats(int threadId) :
+		_threadId(threadId),
+		_gamesRun(0),
+		_movesProcessed(0),
+		_algoMicros(0),
+		_engineMicros(0),
+		_queueWaitMicros(0),
+		_allocations(0)
+	{
+	}
+
+	void WorkerStats::add(atomic<long long>& counter, long long value)
+	{
+		counter.fetch_add(value, memory_order_relaxed);
+	}
+
+	void WorkerStats::startGame(const string& playerAName, const string& playerBName, const string& boardName)
+	{
+		lock_guard<mutex> lock(_currentGameLock);
+		_currentGame = playerAName + " vs " + playerBName + " on " + boardName;
+		_currentGameStartTime = steady_clock::now();
+	}
+
+	void WorkerStats::finishGame(const GameResults& results, long long allocations)
+	{
+		add(_gamesRun, 1);
+		add(_movesProcessed, results.moves);
+		add(_algoMicros, results.algoMicros);
+		add(_engineMicros, results.durationMicros - results.algoMicros);
+		add(_allocations, allocations);
+
+		lock_guard<mutex> lock(_currentGameLock);
+		_currentGame.clear();
+	}
+
+	void WorkerStats::addQueueWait(long long queueWaitMicros)
+	{
+		add(_queueWaitMicros, queueWaitMicros);
+	}
+
+	int WorkerStats::threadId() const
+	{
+		return _threadId;
+	}
+
+	long long WorkerStats::gamesRun() const
+	{
+		return _gamesRun.load(memory_order_relaxed);
+	}
+
+	long long WorkerStats::movesProcessed() const
+	{
+		return _movesProcessed.load(memory_order_relaxed);
+	}
+
+	long long WorkerStats::algoMicros() const
+	{
+		return _algoMicros.load(memory_order_relaxed);
+	}
+
+	long long WorkerStats::engineMicros() const
+	{
+		return _engineMicros.load(memory_order_relaxed);
+	}
+
+	long long WorkerStats::queueWaitMicros() const
+	{
+		return _queueWaitMicros.load(memory_order_relaxed);
+	}
+
+	long long WorkerStats::allocations() const
+	{
+		return _allocations.load(memory_order_relaxed);
+	}
+
+	string WorkerStats::currentGame(long long& currentGameMillis) const
+	{
+		lock_guard<mutex> lock(_currentGameLock);
+		currentGameMillis = _currentGame.empty() ?
+							0 : duration_cast<milliseconds>(steady_clock::now() - _currentGameStartTime).count();
+		return _currentGame;
+	}
+
+	WorkerStatsReporter::WorkerStatsReporter(const string& filename, int intervalMillis,
+											 const vector<unique_ptr<WorkerStats>>& workersStats) :
+		_filename(filename),
+		_intervalMillis(intervalMillis),
+		_workersStats(workersStats),
+		_startTime(steady_clock::now()),
+		_isStopped(false)
+	{
+	}
+
+	WorkerStatsReporter::~WorkerStatsReporter()
+	{
+		stop();
+	}
+
+	void WorkerStatsReporter::start()
+	{
+		_startTime = steady_clock::now();
+		_reporterThread = thread(&WorkerStatsReporter::run, this);
+	}
+
+	void WorkerStatsReporter::stop()
+	{
+		if (!_reporterThread.joinable())
+			return;
+
+		{
+			lock_guard<mutex> lock(_stopLock);
+			_isStopped = true;
+		}
+		_stopCV.notify_one();
+		_reporterThread.join();
+
+		writeStats();
+	}
+
+	void WorkerStatsReporter::run()
+	{
+		unique_lock<mutex> lock(_stopLock);
+		while (!_stopCV.wait_for(lock, milliseconds(_intervalMillis), [this] { return _isStopped; }))
+		{
+			writeStats();
+		}
+	}
+
+	void WorkerStatsReporter::writeStats() const
+	{
+		ofstream fs(_filename, std::ofstream::out | std::ofstream::trunc);
+		if (!fs.is_open())
+		{
+			Logger::getInstance().log(Severity::WARNING_LEVEL, "Failed to open worker stats file " + _filename);
+			return;
+		}
+
+		long long elapsedMillis = duration_cast<milliseconds>(steady_clock::now() - _startTime).count();
+		fs << "{" << endl
+		   << "  \"elapsed_ms\": " << elapsedMillis << "," << endl
+		   << "  \"workers\": [" << endl;
+
+		for (size_t i = 0; i < _workersStats.size(); i++)
+		{
+			const WorkerStats& stats = *_workersStats[i];
+			long long currentGameMillis = 0;
+			string currentGame = stats.currentGame(currentGameMillis);
+
+			fs << "    { \"thread\": " << stats.threadId()
+			   << ", \"games\": " << stats.gamesRun()
+			   << ", \"moves\": " << stats.movesProcessed()
+			   << ", \"algo_us\": " << stats.algoMicros()
+			   << ", \"engine_us\": " << stats.engineMicros()
+			   << ", \"queue_wait_us\": " << stats.queueWaitMicros()
+			   << ", \"allocations\": " << stats.allocations()
+			   << ", \"current_game\": \"" << IOUtil::escapeJson(currentGame) << "\""
+			   << ", \"current_game_ms\": " << currentGameMillis
+			   << " }" << ((i + 1 < _workersStats.size()) ? "," : "") << endl;
+		}
+
+		fs << "  ]" << endl << "}" << endl;
+	}
+}
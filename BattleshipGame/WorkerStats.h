@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include "GameManager.h"
+
+using std::atomic;
+using std::unique_ptr;
+using std::vector;
+using std::string;
+using std::thread;
+using std::mutex;
+using std::condition_variable;
+using std::chrono::steady_clock;
+
+namespace battleship
+{
+	/** Live counters of a single worker thread.
+	 *  Counters are only updated by the worker thread, and may be read by other threads at any time while the
+	 *  competition runs - so they are relaxed atomics, and updating them never takes a lock.
+	 */
+	class WorkerStats
+	{
+	public:
+		explicit WorkerStats(int threadId);
+		virtual ~WorkerStats() = default;
+
+		WorkerStats(WorkerStats const&) = delete;	// Disable copying
+		WorkerStats& operator=(WorkerStats const&) = delete;	// Disable copying (assignment)
+
+		/** Marks the beginning of a game: the game is reported as the worker's current game until it's finished */
+		void startGame(const string& playerAName, const string& playerBName, const string& boardName);
+
+		/** Adds a finished game to the counters, with the number of heap allocations the worker made for it */
+		void finishGame(const GameResults& results, long long allocations);
+
+		/** Adds time the worker waited for its next game in the games queue */
+		void addQueueWait(long long queueWaitMicros);
+
+		int threadId() const;
+		long long gamesRun() const;
+		long long movesProcessed() const;
+		long long algoMicros() const;	// Time spent inside the algorithms
+		long long engineMicros() const;	// Time spent running games, outside the algorithms
+		long long queueWaitMicros() const;
+		long long allocations() const;
+
+		/** Description of the game the worker currently plays (empty if it's between games),
+		 *  and how long it has been playing it
+		 */
+		string currentGame(long long& currentGameMillis) const;
+
+	private:
+		int _threadId;
+		atomic<long long> _gamesRun;
+		atomic<long long> _movesProcessed;
+		atomic<long long> _algoMicros;
+		atomic<long long> _engineMicros;
+		atomic<long long> _queueWaitMicros;
+		atomic<long long> _allocations;
+
+		/** Locks the current game details, which are only updated when a game starts or ends */
+		mutable mutex _currentGameLock;
+		string _currentGame;
+		steady_clock::time_point _currentGameStartTime;
+
+		/** Adds value to a counter, without ordering it with other memory operations */
+		static void add(atomic<long long>& counter, long long value);
+	};
+
+	/** Periodically writes the counters of all worker threads into a stats file, while the competition runs.
+	 *  The file is rewritten as a whole on each period, so it always holds a complete, up to date snapshot.
+	 */
+	class WorkerStatsReporter
+	{
+	public:
+		/** Reports the given workers every intervalMillis. The workers' stats must outlive the reporter. */
+		WorkerStatsReporter(const string& filename, int intervalMillis,
+							const vector<unique_ptr<WorkerStats>>& workersStats);
+
+		/** Stops the reporter if it's still running */
+		virtual ~WorkerStatsReporter();
+
+		WorkerStatsReporter(WorkerStatsReporter const&) = delete;	// Disable copying
+		WorkerStatsReporter& operator=(WorkerStatsReporter const&) = delete;	// Disable copying (assignment)
+
+		/** Starts the reporter thread */
+		void start();
+
+		/** Stops the reporter thread, and writes the final snapshot of the counters */
+		void stop();
+
+	private:
+		string _filename;
+		int _intervalMillis;
+		const vector<unique_ptr<WorkerStats>>& _workersStats;
+		steady_clock::time_point _startTime;
+
+		thread _reporterThread;
+		mutex _stopLock;
+		condition_variable _stopCV;
+		bool _isStopped;
+
+		/** Logic of the reporter thread: write a snapshot every interval until stopped */
+		void run();
+
+		/** Writes the current counters of all workers to the stats file */
+		void writeStats() const;
+	};
+}
@@ -1,11 +1,38 @@
 #include "WorkerThreadResourcePool.h"
+#include "Logger.h"
+#include <chrono>
+
+using std::chrono::steady_clock;
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
 
 namespace battleship
 {
+	AlgoPoolStats::AlgoPoolStats() :
+		instancesCreated(0),
+		instancesReused(0),
+		instancesEvicted(0),
+		creationMicros(0)
+	{
+	}
+
+	void AlgoPoolStats::merge(const AlgoPoolStats& other)
+	{
+		instancesCreated += other.instancesCreated;
+		instancesReused += other.instancesReused;
+		instancesEvicted += other.instancesEvicted;
+		creationMicros += other.creationMicros;
+	}
+
 	WorkerThreadResourcePool::WorkerThreadResourcePool(shared_ptr<BattleshipGameBoardFactory> boardLoader,
-													   shared_ptr<AlgoLoader> algoLoader):
+													   shared_ptr<AlgoLoader> algoLoader,
+													   size_t algoPoolCapacity,
+													   int helperThreadsCount,
+													   int minParallelSquares):
 		_boardLoader(boardLoader),
-		_algoLoader(algoLoader)
+		_algoLoader(algoLoader),
+		_algoPoolCapacity(algoPoolCapacity),
+		_layerTaskPool(helperThreadsCount, minParallelSquares)
 	{
 	}
 
@@ -13,35 +40,105 @@ namespace battleship
 	{
 	}
 
-	IBattleshipGameAlgo* WorkerThreadResourcePool::requestAlgo(const string& algoPath)
+	unique_ptr<IBattleshipGameAlgo> WorkerThreadResourcePool::acquireAlgo(const string& algoPath)
 	{
-		auto algoIt = _algoPool.find(algoPath);
-		if (algoIt != _algoPool.end())
-		{	// Exists in cache
-			return algoIt->second.get();
+		AlgoPoolStats& stats = _algoStats[algoPath];
+
+		auto& idleInstances = _idleAlgosByPath[algoPath];
+		if (!idleInstances.empty())
+		{	// Exists in pool, hand it out exclusively until it's released
+			auto idleIt = idleInstances.front();
+			idleInstances.pop_front();
+
+			auto algo = std::move(idleIt->second);
+			_idleAlgos.erase(idleIt);
+			stats.instancesReused++;
+			return algo;
 		}
 		else
-		{	// Not loaded before, cache and return
+		{	// No idle instance, create a new one
+			auto creationStartTime = steady_clock::now();
 			auto algo = _algoLoader->requestAlgo(algoPath);
+			stats.creationMicros += duration_cast<microseconds>(steady_clock::now() - creationStartTime).count();
 
 			if (nullptr == algo)
-				return nullptr;
+				return algo;
+
+			stats.instancesCreated++;
+
+			ParallelAlgo* parallelAlgo = parallelAlgoOf(*algo);
+			if (nullptr != parallelAlgo)
+				parallelAlgo->setLayerTaskRunner(&_layerTaskPool);
+
+			return algo;
+		}
+	}
+
+	void WorkerThreadResourcePool::releaseAlgo(const string& algoPath, unique_ptr<IBattleshipGameAlgo> algo)
+	{
+		if (nullptr == algo)
+			return;
+
+		_idleAlgos.emplace_front(algoPath, std::move(algo));
+		_idleAlgosByPath[algoPath].push_front(_idleAlgos.begin());
 
-			auto insertionPair = _algoPool.emplace(std::make_pair(algoPath, std::move(algo)));
-			auto algoInstIt = insertionPair.first;
-			return algoInstIt->second.get();
+		// Evict least recently used instances, which are also the least recently used of their algorithm
+		while ((_algoPoolCapacity != UNLIMITED_ALGO_POOL) && (_idleAlgos.size() > _algoPoolCapacity))
+		{
+			const string& evictedPath = _idleAlgos.back().first;
+			_algoStats[evictedPath].instancesEvicted++;
+			_idleAlgosByPath[evictedPath].pop_back();
+			_idleAlgos.pop_back();
 		}
 	}
 
-	shared_ptr<BattleBoard> WorkerThreadResourcePool::requestBoard(const string& boardPath) const
+	const unordered_map<string, AlgoPoolStats>& WorkerThreadResourcePool::algoStats() const
+	{
+		return _algoStats;
+	}
+
+	AlgoCallLatencies& WorkerThreadResourcePool::algoLatencies(const string& algoPath)
+	{
+		return _algoLatencies[algoPath];
+	}
+
+	const unordered_map<string, AlgoCallLatencies>& WorkerThreadResourcePool::allAlgoLatencies() const
+	{
+		return _algoLatencies;
+	}
+
+	shared_ptr<BattleBoard> WorkerThreadResourcePool::requestBoard(const string& boardPath)
 	{
 		// Always request from board factory to create a new instance out of board prototype
-		return _boardLoader->requestBattleboard(boardPath);
+		return _boardLoader->requestBattleboard(boardPath, &_gameArena);
 	}
 
-	void WorkerThreadResourcePool::cacheResourcesForPlayer(const string& player,
-														   unique_ptr<BoardData> boardData)
+	void WorkerThreadResourcePool::releaseGameMemory()
 	{
-		_playerHeldResources[player] = std::move(boardData);
+		// Memory that's still in use is kept (and reclaimed with the next games' memory once it's freed)
+		if (!_gameArena.release())
+		{
+			Logger::getInstance().log(Severity::WARNING_LEVEL, "Warning: " +
+									  std::to_string(_gameArena.liveAllocationsCount()) +
+									  " game objects are still in use after the game, its memory wasn't released.");
+		}
+	}
+
+	shared_ptr<const BoardData> WorkerThreadResourcePool::requestBoardView(const string& boardPath,
+																			PlayerEnum player) const
+	{
+		// Views are shared, no new instance is created
+		return _boardLoader->requestPlayerView(boardPath, player);
+	}
+
+	GameManager::GameRunnerFuncType WorkerThreadResourcePool::requestGameRunner(const string& playerAPath,
+																				const string& playerBPath) const
+	{
+		auto gameRunner = StaticAlgoRegistry::gameRunnerFor(*_algoLoader, playerAPath, playerBPath);
+		if (gameRunner != &GameManager::runGame)
+			return gameRunner; // Compiled-in algorithms are called directly, extended opponents are still batched
+
+		return BatchedAlgoAdapter::gameRunnerFor(_algoLoader->isExtendedAlgorithm(playerAPath),
+												 _algoLoader->isExtendedAlgorithm(playerBPath));
 	}
 }
\ No newline at end of file
@@ -1,49 +1,113 @@
 #pragma once
 
 #include <memory>
+#include <list>
 #include <unordered_map>
 #include "BattleshipGameBoardFactory.h"
 #include "AlgoLoader.h"
 #include "IBattleshipGameAlgo.h"
 #include "BattleBoard.h"
+#include "StaticAlgoRegistry.h"
+#include "BatchedAlgoAdapter.h"
+#include "LatencyHistogram.h"
+#include "MonotonicArena.h"
+#include "AlgoParallel.h"
 
 using std::unique_ptr;
 using std::shared_ptr;
 using std::string;
 using std::unordered_map;
+using std::list;
+using std::pair;
 
 namespace battleship
 {
+	/** Instantiation metrics of a single algorithm in a resource pool */
+	struct AlgoPoolStats
+	{
+		size_t instancesCreated;	// Instances created by the algorithm loader
+		size_t instancesReused;		// Requests served by an idle instance from the pool
+		size_t instancesEvicted;	// Idle instances released to keep the pool within its capacity
+		long long creationMicros;	// Total time spent creating instances
+
+		AlgoPoolStats();
+
+		/** Adds the metrics of another pool to this one */
+		void merge(const AlgoPoolStats& other);
+	};
+
 	/** Thread safe resource pool that caches loaded resources for each worker thread.
 	 *  Cached resources are not shared among worker threads.
 	 */
 	class WorkerThreadResourcePool
 	{
 	public:
+		/** Creates a resource pool that keeps up to algoPoolCapacity idle algorithm instances
+		 *  (UNLIMITED_ALGO_POOL keeps all instances), and lends up to helperThreadsCount helper threads to the
+		 *  algorithms that can split their work (see ParallelAlgo) on boards of at least minParallelSquares squares.
+		 */
 		WorkerThreadResourcePool(shared_ptr<BattleshipGameBoardFactory> boardLoader,
-								 shared_ptr<AlgoLoader> algoLoader);
+								 shared_ptr<AlgoLoader> algoLoader,
+								 size_t algoPoolCapacity = UNLIMITED_ALGO_POOL,
+								 int helperThreadsCount = 0,
+								 int minParallelSquares = LayerTaskPool::DEFAULT_MIN_PARALLEL_SQUARES);
 		virtual ~WorkerThreadResourcePool();
 
-		/** Return algorithm in given path. Expected to be an algorithm that was loaded before.
-		 *  If the algorithm exists in cache, it will be returned from the cache.
+		/** Value of algoPoolCapacity for pools that never evict idle algorithm instances */
+		static constexpr size_t UNLIMITED_ALGO_POOL = 0;
+
+		/** Returns an instance of the algorithm in given path, for the exclusive use of a single game side.
+		 *  Expected to be an algorithm that was loaded before.
+		 *  The most recently released idle instance of the algorithm is reused if there is one, otherwise a new
+		 *  instance is created. An instance is never handed out twice before it is released, so a player that
+		 *  faces itself gets two distinct instances.
+		 *  New instances that implement ParallelAlgo are given this worker thread's helper threads.
 		 *  On error, nullptr is returned.
 		 */
-		IBattleshipGameAlgo* requestAlgo(const string& algoPath);
+		unique_ptr<IBattleshipGameAlgo> acquireAlgo(const string& algoPath);
+
+		/** Returns an instance received from acquireAlgo to the pool, once its game is over.
+		 *  If the pool exceeds its capacity, the least recently used idle instance is released.
+		 */
+		void releaseAlgo(const string& algoPath, unique_ptr<IBattleshipGameAlgo> algo);
+
+		/** Instantiation metrics of each algorithm requested from this pool */
+		const unordered_map<string, AlgoPoolStats>& algoStats() const;
+
+		/** Latency profile the games of this worker thread record the algorithm's calls into */
+		AlgoCallLatencies& algoLatencies(const string& algoPath);
+
+		/** Call latencies of each algorithm that played in this worker thread's games */
+		const unordered_map<string, AlgoCallLatencies>& allAlgoLatencies() const;
 
 		/** Returns a new instance of the board in given path.
 		 *  The board returned will be "clean" and ready for play.
 		 *  Requested board are assumed to be loaded and valid.
+		 *  The board is allocated from this worker thread's game arena, so it must be destroyed before
+		 *  releaseGameMemory is called.
 		 *  On error, nullptr is returned.
 		 */
-		shared_ptr<BattleBoard> requestBoard(const string& boardPath) const;
+		shared_ptr<BattleBoard> requestBoard(const string& boardPath);
 
-		/** Resources cached by the player's algorithms are held here until
-		 *  the users relinquish ownership over them. Since we can't trust the algorithm
-		 *  not to access them after the game is over, we hold them here and manage their
-		 *  lifetime until the algorithm have shifted to another game or have been destroyed.
+		/** Frees the memory of the game that was just played (its board and game pieces) at once.
+		 *  Called once the game's board was destroyed.
 		 */
-		void cacheResourcesForPlayer(const string& player,
-									 unique_ptr<BoardData> boardData);
+		void releaseGameMemory();
+
+		/** Returns the player's view of the board in given path.
+		 *  Views are immutable and shared by all worker threads, and they outlive the games played on them -
+		 *  so algorithms that access the view after the game is over are safe.
+		 *  On error, nullptr is returned.
+		 */
+		shared_ptr<const BoardData> requestBoardView(const string& boardPath, PlayerEnum player) const;
+
+		/** Returns the game loop to run a game between the given players.
+		 *  Games of algorithms compiled into the executable get a devirtualized game loop,
+		 *  games of algorithms that implement IBattleshipGameAlgoEx get a batched game loop,
+		 *  all other games run the generic GameManager::runGame.
+		 */
+		GameManager::GameRunnerFuncType requestGameRunner(const string& playerAPath,
+																 const string& playerBPath) const;
 
 	private:
 
@@ -51,16 +115,31 @@ namespace battleship
 		shared_ptr<BattleshipGameBoardFactory> _boardLoader;
 		shared_ptr<AlgoLoader> _algoLoader;
 
-		/** Cache of loaded algos */
-		unordered_map<string, unique_ptr<IBattleshipGameAlgo>> _algoPool;
+		/** Maximal number of idle algorithm instances (UNLIMITED_ALGO_POOL for no limit) */
+		size_t _algoPoolCapacity;
 
-		/** A map to keep an eye on player held resources resources.
-		 *  Resources cached by the player's algorithms are held here until
-		 *  the users relinquish ownership over them. Since we can't trust the algorithm
-		 *  not to access them after the game is over, we hold them here and manage their
-		 *  lifetime until the algorithm have shifted to another game or have been destroyed.
+		/** Helper threads shared by all the algorithm instances of this worker thread, as only one of them plays
+		 *  at a time. Declared before the instances, so it outlives them.
 		 */
-		unordered_map<string, unique_ptr<BoardData>> _playerHeldResources;
+		LayerTaskPool _layerTaskPool;
+
+		/** Idle algorithm instances <algorithm path, instance>, most recently used first */
+		using IdleAlgosList = list<pair<string, unique_ptr<IBattleshipGameAlgo>>>;
+		IdleAlgosList _idleAlgos;
+
+		/** Idle instances of each algorithm (as positions in _idleAlgos), most recently used first.
+		 *  Lets acquireAlgo find an idle instance without walking over the instances of other algorithms.
+		 */
+		unordered_map<string, list<IdleAlgosList::iterator>> _idleAlgosByPath;
+
+		/** Instantiation metrics of each algorithm */
+		unordered_map<string, AlgoPoolStats> _algoStats;
+
+		/** Call latencies of each algorithm */
+		unordered_map<string, AlgoCallLatencies> _algoLatencies;
+
+		/** Memory of the current game's engine objects, reused by all the games of this worker thread */
+		MonotonicArena _gameArena;
 	};
 }
 